@@ -28,6 +28,7 @@
 #include "initializerRules.h"
 #include "iterator.h"
 #include "passes.h"
+#include "resolution.h"
 #include "scopeResolve.h"
 #include "stlUtil.h"
 #include "stmt.h"
@@ -550,6 +551,8 @@ AggregateType* AggregateType::getInstantiation(Symbol* sym, int index) {
   instantiations.push_back(newInstance);
   newInstance->instantiatedFrom = this;
 
+  gNumInstantiatedTypes = gNumInstantiatedTypes + 1;
+
   // Handle dispatch parents (because it totally makes sense for this to have
   // been done outside of the AggregateType by
   // instantiateTypeForTypeConstructor.  Totally)
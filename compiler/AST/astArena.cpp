@@ -0,0 +1,241 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "baseAST.h"
+
+#include "driver.h"
+#include "misc.h"
+
+#include <cstdlib>
+#include <stdint.h>
+
+/************************************* | **************************************
+*                                                                             *
+* AST nodes are allocated from slabs instead of one at a time from malloc.    *
+*                                                                             *
+* Every node size is rounded up to a multiple of kGranule and each rounded    *
+* size has its own slabs, so nodes of one type sit next to each other in the  *
+* order they were created.  Deleting a node, which cleanAst() does for every  *
+* dead node after each pass, pushes its memory on a free list for its size;   *
+* the next pass reuses it without a trip through malloc and free.             *
+*                                                                             *
+* Slabs are aligned to their size so that a node can find its slab, and      *
+* each slab counts its live nodes.  At the end of cleanAst(), which runs      *
+* between passes, astArenaReclaim() returns every slab whose nodes are all    *
+* dead to malloc in one go, after dropping those nodes from the free list.    *
+* A pass that discards much of the AST thus gives its memory back instead of  *
+* leaving it scattered across the free lists, and later passes allocate from  *
+* the slabs that still hold live nodes.                                       *
+*                                                                             *
+* With --no-ast-arena-reuse deleted nodes are neither reused nor reclaimed,   *
+* so that a stale pointer keeps seeing the node that was deleted.             *
+*                                                                             *
+************************************** | *************************************/
+
+static const size_t kGranule    = 16;
+static const size_t kMaxSize    = 1024;
+static const size_t kNumClasses = kMaxSize / kGranule;
+static const size_t kSlabSize   = 64 * 1024;
+
+class FreeNode {
+public:
+  FreeNode* next;
+};
+
+// At the start of every slab, before its nodes
+class Slab {
+public:
+  size_t numLive;
+  Slab*  next;
+};
+
+static const size_t  kSlabHeader = (sizeof(Slab) + kGranule - 1) /
+                                   kGranule * kGranule;
+
+static FreeNode*     sFreeLists[kNumClasses];
+static Slab*         sSlabs[kNumClasses];
+static char*         sSlabPos[kNumClasses];
+static char*         sSlabEnd[kNumClasses];
+
+static AstArenaStats sStats;
+
+static Slab* slabOf(void* node) {
+  return (Slab*) ((uintptr_t) node & ~(uintptr_t) (kSlabSize - 1));
+}
+
+static void* newSlabNode(size_t index, size_t size) {
+  if ((size_t) (sSlabEnd[index] - sSlabPos[index]) < size) {
+    void* mem  = NULL;
+
+    if (posix_memalign(&mem, kSlabSize, kSlabSize) != 0) {
+      INT_FATAL("out of memory for AST nodes");
+    }
+
+    Slab* slab = (Slab*) mem;
+
+    slab->numLive    = 0;
+    slab->next       = sSlabs[index];
+    sSlabs[index]    = slab;
+
+    // The tail of the previous slab is too small to be of use
+    sSlabPos[index]  = (char*) mem + kSlabHeader;
+    sSlabEnd[index]  = (char*) mem + kSlabSize;
+
+    sStats.slabBytes = sStats.slabBytes + kSlabSize;
+  }
+
+  void* retval = sSlabPos[index];
+
+  sSlabPos[index] = sSlabPos[index] + size;
+
+  return retval;
+}
+
+void* BaseAST::operator new(size_t size) {
+  void* retval = NULL;
+
+  sStats.numAllocs = sStats.numAllocs + 1;
+
+  if (size > kMaxSize) {
+    retval = malloc(size);
+
+    if (retval == NULL) {
+      INT_FATAL("out of memory for AST nodes");
+    }
+
+    sStats.largeBytes = sStats.largeBytes + size;
+    sStats.liveBytes  = sStats.liveBytes  + size;
+    sStats.allocBytes = sStats.allocBytes + size;
+
+  } else {
+    size_t index   = (size - 1) / kGranule;
+    size_t rounded = (index + 1) * kGranule;
+
+    if (FreeNode* node = sFreeLists[index]) {
+      sFreeLists[index] = node->next;
+
+      sStats.freeBytes  = sStats.freeBytes - rounded;
+      sStats.numReused  = sStats.numReused + 1;
+
+      retval = node;
+
+    } else {
+      retval = newSlabNode(index, rounded);
+    }
+
+    slabOf(retval)->numLive = slabOf(retval)->numLive + 1;
+
+    sStats.liveBytes  = sStats.liveBytes  + rounded;
+    sStats.allocBytes = sStats.allocBytes + rounded;
+  }
+
+  if (sStats.liveBytes > sStats.peakLiveBytes) {
+    sStats.peakLiveBytes = sStats.liveBytes;
+  }
+
+  return retval;
+}
+
+// 'size' is that of the dynamic type because ~BaseAST() is virtual
+void BaseAST::operator delete(void* ptr, size_t size) {
+  if (ptr == NULL) {
+    return;
+  }
+
+  if (size > kMaxSize) {
+    free(ptr);
+
+    sStats.largeBytes = sStats.largeBytes - size;
+    sStats.liveBytes  = sStats.liveBytes  - size;
+
+  } else {
+    size_t index   = (size - 1) / kGranule;
+    size_t rounded = (index + 1) * kGranule;
+
+    sStats.liveBytes = sStats.liveBytes - rounded;
+
+    if (fAstArenaReuse == true) {
+      FreeNode* node = (FreeNode*) ptr;
+
+      node->next        = sFreeLists[index];
+      sFreeLists[index] = node;
+
+      sStats.freeBytes  = sStats.freeBytes + rounded;
+
+      slabOf(ptr)->numLive = slabOf(ptr)->numLive - 1;
+    }
+  }
+}
+
+// The slab that nodes of this size are being carved from is kept even
+// when it is empty; it has not been handed out in full yet.
+static bool isReclaimable(size_t index, Slab* slab) {
+  return slab->numLive == 0 &&
+         (sSlabEnd[index] == NULL || slabOf(sSlabEnd[index] - 1) != slab);
+}
+
+static void reclaimClass(size_t index) {
+  size_t    rounded = (index + 1) * kGranule;
+  FreeNode** link   = &sFreeLists[index];
+  Slab**     slink  = &sSlabs[index];
+
+  // Drop the free nodes in empty slabs, keeping the others in order
+  while (*link != NULL) {
+    if (isReclaimable(index, slabOf(*link)) == true) {
+      *link            = (*link)->next;
+      sStats.freeBytes = sStats.freeBytes - rounded;
+    } else {
+      link = &(*link)->next;
+    }
+  }
+
+  while (*slink != NULL) {
+    Slab* slab = *slink;
+
+    if (isReclaimable(index, slab) == true) {
+      *slink = slab->next;
+
+      free(slab);
+
+      sStats.slabBytes      = sStats.slabBytes      - kSlabSize;
+      sStats.reclaimedBytes = sStats.reclaimedBytes + kSlabSize;
+    } else {
+      slink = &slab->next;
+    }
+  }
+}
+
+void astArenaReclaim() {
+  if (fAstArenaReuse == false) {
+    return;
+  }
+
+  for (size_t index = 0; index < kNumClasses; index++) {
+    for (Slab* slab = sSlabs[index]; slab != NULL; slab = slab->next) {
+      if (isReclaimable(index, slab) == true) {
+        reclaimClass(index);
+        break;
+      }
+    }
+  }
+}
+
+void astArenaStats(AstArenaStats& stats) {
+  stats = sStats;
+}
@@ -82,10 +82,20 @@ void printStatistics(const char* pass) {
   static int last_nasts = -1;
   static int maxK = -1, maxN = -1;
 
+  AstArenaStats arena;
+
+  astArenaStats(arena);
+
   if (!strcmp(pass, "makeBinary")) {
     if (strstr(fPrintStatistics, "m")) {
       fprintf(stderr, "Maximum # of ASTS: %d\n", maxN);
       fprintf(stderr, "Maximum Size (KB): %d\n", maxK);
+      fprintf(stderr, "Maximum Live Arena (KB): %d\n",
+              (int) (arena.peakLiveBytes / 1024));
+      fprintf(stderr, "Arena Slabs (KB): %d\n",
+              (int) (arena.slabBytes / 1024));
+      fprintf(stderr, "Arena Reclaimed (KB): %d\n",
+              (int) (arena.reclaimedBytes / 1024));
     }
   }
 
@@ -156,6 +166,13 @@ void printStatistics(const char* pass) {
   if (strstr(fPrintStatistics, "k") && !strstr(fPrintStatistics, "n"))
     fprintf(stderr, "    Type %6dK Prim  %6dK Enum %6dK Class %6dK\n",
             kType, kPrimitiveType, kEnumType, kAggregateType);
+
+  if (strstr(fPrintStatistics, "k"))
+    fprintf(stderr, "    Arena %6dK Live %6dK Free %6dK Large %6dK Reclaimed %6dK  Reused %9ld of %9ld\n",
+            (int) (arena.slabBytes / 1024), (int) (arena.liveBytes / 1024),
+            (int) (arena.freeBytes / 1024), (int) (arena.largeBytes / 1024),
+            (int) (arena.reclaimedBytes / 1024),
+            (long) arena.numReused, (long) arena.numAllocs);
   last_nasts = nasts;
 }
 
@@ -251,6 +268,8 @@ void cleanAst() {
   // clean global vectors and delete dead ast instances
   //
   foreach_ast(clean_gvec);
+
+  astArenaReclaim();
 }
 
 
@@ -259,7 +278,8 @@ void destroyAst() {
     forv_Vec(type, ast, g##type##s) {           \
       trace_remove(ast, 'z');                   \
       delete ast;                               \
-    }
+    }                                           \
+    g##type##s.clear()
   foreach_ast(destroy_gvec);
 }
 
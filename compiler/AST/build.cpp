@@ -2191,11 +2191,17 @@ CallExpr* buildScanExpr(Expr* opExpr, Expr* dataExpr, bool zippered) {
   buildReduceScanPreface1(fn, data, eltType, opExpr, dataExpr, zippered);
   buildReduceScanPreface2(fn, eltType, globalOp, opExpr);
 
-  fn->insertAtTail("compilerWarning('scan has been serialized (see issue #5760)')");
-
+  // Only scans of arrays that support it run in parallel
   if( !zippered ) {
+    CallExpr*  isPar = new CallExpr("chpl__scanIsParallel", globalOp, data);
+    VarSymbol* msg   = new_StringSymbol("scan has been serialized "
+                                        "(see issue #5760)");
+
+    fn->insertAtTail(new CondStmt(new CallExpr("!", isPar),
+                                  new CallExpr("compilerWarning", msg)));
     fn->insertAtTail("'return'(chpl__scanIterator(%S, %S))", globalOp, data);
   } else {
+    fn->insertAtTail("compilerWarning('scan has been serialized (see issue #5760)')");
     fn->insertAtTail("'return'(chpl__scanIteratorZip(%S, %S))", globalOp, data);
   }
 
@@ -49,6 +49,7 @@
 #endif
 
 #include <inttypes.h>
+#include <unistd.h>
 
 #include <algorithm>
 #include <cctype>
@@ -2156,26 +2157,27 @@ void codegen(void) {
     fprintf(mainfile.fptr, "#include \"%s.c\"\n", sCfgFname);
     fprintf(mainfile.fptr, "#include \"chpl__defn.c\"\n");
 
-    std::vector<const char*> userFileName;
+    // With --incremental, every module is its own translation unit so
+    // that the generated Makefile can compile them in parallel and
+    // reuse unchanged objects.
+    std::vector<const char*> moduleFileNames;
     if(fIncrementalCompilation) {
       ChainHashMap<char*, StringHashFns, int> fileNameHashMap;
       forv_Vec(ModuleSymbol, currentModule, allModules) {
         const char* filename = NULL;
         filename = generateFileName(fileNameHashMap, filename, currentModule->name);
-        if(currentModule->modTag == MOD_USER) {
-          fileinfo modulefile;
-          openCFile(&modulefile, filename, "c");
-          int modulePathLen = strlen(astr(modulefile.pathname));
-          char path[FILENAME_MAX];
-          strncpy(path, astr(modulefile.pathname), modulePathLen-2);
-          path[modulePathLen-2]='\0';
-          userFileName.push_back(astr(path));
-          closeCFile(&modulefile);
-        }
+        fileinfo modulefile;
+        openCFile(&modulefile, filename, "c");
+        int modulePathLen = strlen(astr(modulefile.pathname));
+        char path[FILENAME_MAX];
+        strncpy(path, astr(modulefile.pathname), modulePathLen-2);
+        path[modulePathLen-2]='\0';
+        moduleFileNames.push_back(astr(path, ".o"));
+        closeCFile(&modulefile);
       }
     }
 
-    codegen_makefile(&mainfile, NULL, false, userFileName);
+    codegen_makefile(&mainfile, NULL, false, moduleFileNames);
   }
 
   // Vectors to store different symbol names to be used while generating header
@@ -2230,12 +2232,12 @@ void codegen(void) {
       fileinfo modulefile;
       openCFile(&modulefile, filename, "c");
       info->cfile = modulefile.fptr;
-      if(fIncrementalCompilation && (currentModule->modTag == MOD_USER))
+      if(fIncrementalCompilation)
         fprintf(modulefile.fptr, "#include \"chpl__header.h\"\n");
       currentModule->codegenDef();
       closeCFile(&modulefile);
 
-      if(!(fIncrementalCompilation && (currentModule->modTag == MOD_USER)))
+      if(!fIncrementalCompilation)
         fprintf(mainfile.fptr, "#include \"%s%s\"\n", filename, ".c");
     }
 
@@ -2270,7 +2272,20 @@ void makeBinary(void) {
 #endif
   } else {
     const char* makeflags = printSystemCommands ? "-f " : "-s -f ";
+    const char* jobflags = "";
+
+    // Separate translation units can be compiled concurrently.
+    if (fIncrementalCompilation) {
+      int jobs = fCCompileJobs;
+      if (jobs <= 0) {
+        long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+        jobs = (ncpus > 0) ? (int) ncpus : 1;
+      }
+      jobflags = astr("-j ", istr(jobs), " ");
+    }
+
     const char* command = astr(astr(CHPL_MAKE, " "),
+                               jobflags,
                                makeflags,
                                getIntermediateDirName(), "/Makefile");
     mysystem(command, "compiling generated source");
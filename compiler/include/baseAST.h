@@ -272,6 +272,10 @@ public:
 
   static  const       std::string tabText;
 
+  // Nodes are carved from per-size slabs; see astArena.cpp
+  static void*      operator new(size_t size);
+  static void       operator delete(void* ptr, size_t size);
+
 protected:
                     BaseAST(AstTag type);
   virtual          ~BaseAST();
@@ -693,6 +697,29 @@ void destroyAst(void);
 //
 void printStatistics(const char* pass);
 
+//
+// memory held by the slabs that AST nodes are allocated from
+//
+class AstArenaStats {
+public:
+  size_t slabBytes;       // obtained from malloc for slabs, less reclaimed
+  size_t reclaimedBytes;  // slabs returned to malloc when all nodes died
+  size_t liveBytes;       // held by nodes that have not been deleted
+  size_t freeBytes;       // held by deleted nodes, ready for reuse
+  size_t peakLiveBytes;
+  size_t largeBytes;      // nodes too large for a slab, in liveBytes too
+  size_t allocBytes;      // allocated since the compiler started
+  size_t numAllocs;
+  size_t numReused;       // allocations satisfied from a free list
+};
+
+void astArenaStats(AstArenaStats& stats);
+
+//
+// return the slabs that hold no live nodes to malloc; see astArena.cpp
+//
+void astArenaReclaim();
+
 void registerModule(ModuleSymbol* mod);
 
 //
@@ -65,6 +65,8 @@ extern bool fNoRemoveEmptyRecords;
 extern bool fNoInferLocalFields;
 extern bool fRemoveUnreachableBlocks;
 extern bool fReplaceArrayAccessesWithRefTemps;
+extern bool fResolutionMemo;
+extern bool fAstArenaReuse;
 extern int  optimize_on_clause_limit;
 extern int  scalar_replace_limit;
 extern int  inline_iter_yield_limit;
@@ -114,6 +116,7 @@ extern const char* CHPL_LAUNCHER_SUBDIR;
 
 extern bool  printPasses;
 extern FILE* printPassesFile;
+extern FILE* printPassesProfileFile;
 
 extern char fExplainCall[256];
 extern int  explainCallID;
@@ -209,6 +212,12 @@ extern bool fMinimalModules;
 // Set to true if we want to enable incremental compilation.
 extern bool fIncrementalCompilation;
 
+// With --incremental, the number of module translation units to
+// compile at once (0 means one per core), and the directory in which
+// to cache their objects by content (empty means no cache).
+extern int fCCompileJobs;
+extern char fCObjectCacheDir[FILENAME_MAX+1];
+
 // Set to true if we want to use the experimental
 // Interactive Programming Environment (IPE) mode.
 extern bool fUseIPE;
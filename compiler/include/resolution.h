@@ -41,6 +41,10 @@ extern bool                             beforeLoweringForallStmts;
 
 extern int                              explainCallLine;
 
+// Counts of the functions and types instantiated so far
+extern int                              gNumInstantiatedFns;
+extern int                              gNumInstantiatedTypes;
+
 extern SymbolMap                        paramMap;
 
 extern Vec<CallExpr*>                   callStack;
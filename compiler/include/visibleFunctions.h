@@ -37,6 +37,8 @@ void       getVisibleFunctions(const char*      name,
 
 BlockStmt* getVisibilityBlock(Expr* expr);
 
+BlockStmt* getEquivalentVisibilityBlock(Expr* expr);
+
 void       visibleFunctionsClear();
 
 #endif
@@ -19,12 +19,22 @@
 
 #include "PhaseTracker.h"
 
+#include "AstCount.h"
 #include "baseAST.h"
 #include "driver.h"
+#include "ModuleSymbol.h"
+#include "resolution.h"
 
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <string>
+
+#include <sys/resource.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 
 // Used to collect the times as the program runs
 class Phase
@@ -101,6 +111,38 @@ static void PassesReport(FILE*                    fp,
                          const std::vector<Pass>& passes,
                          unsigned long            totalTime);
 
+// The compiler's memory use, and optionally the AST, at one point in time
+class PhaseProfile
+{
+public:
+                           PhaseProfile();
+
+  void                     Collect(bool countAst);
+
+  static void              Header(FILE* fp);
+
+  void                     Print(FILE*               fp,
+                                 int                 passId,
+                                 const char*         name,
+                                 const char*         subPhase,
+                                 unsigned long       elapsed,
+                                 const PhaseProfile& start)           const;
+
+  long                     mMaxRssKB;       // high-water mark
+  long                     mHeapKB;         // in use by malloc
+  size_t                   mAstAllocBytes;  // since the compiler started
+  size_t                   mAstLiveBytes;
+  int                      mInstantiatedFns;
+  int                      mInstantiatedTypes;
+
+  // Counts of the nodes in the tree, in the order of AstNames()
+  std::vector<int>         mAstCounts;
+
+private:
+  static
+  const std::vector<std::string>& AstNames();
+};
+
 /************************************* | **************************************
 *                                                                             *
 * Implementation of PhaseTracker                                              *
@@ -110,6 +152,7 @@ static void PassesReport(FILE*                    fp,
 PhaseTracker::PhaseTracker()
 {
   mPhaseId = 0;
+  mProfile = true;
 
   mTimer.start();
   StartPhase("startup");
@@ -119,6 +162,9 @@ PhaseTracker::~PhaseTracker()
 {
   for (size_t i = 0; i < mPhases.size(); i++)
     delete mPhases[i];
+
+  for (size_t i = 0; i < mProfiles.size(); i++)
+    delete mProfiles[i];
 }
 
 void PhaseTracker::StartPhase(const char* name)
@@ -140,6 +186,17 @@ void PhaseTracker::StartPhase(const char* name,
                               int         passId,
                               SubPhase    subPhase)
 {
+  // Don't charge the time spent counting the AST to the phase that is ending
+  bool   pause = printPassesProfileFile != NULL;
+
+  if (pause == true)
+    mTimer.stop();
+
+  TakeProfile();
+
+  if (pause == true)
+    mTimer.start();
+
   Phase* phase = new Phase(name, passId, subPhase, mTimer.elapsedUsecs());
 
   mPhases.push_back(phase);
@@ -148,6 +205,30 @@ void PhaseTracker::StartPhase(const char* name,
 void PhaseTracker::Stop()
 {
   mTimer.stop();
+
+  TakeProfile();
+}
+
+void PhaseTracker::DisableProfile()
+{
+  for (size_t i = 0; i < mProfiles.size(); i++)
+    delete mProfiles[i];
+
+  mProfiles.clear();
+
+  mProfile = false;
+}
+
+void PhaseTracker::TakeProfile()
+{
+  if (mProfile == false)
+    return;
+
+  PhaseProfile* profile = new PhaseProfile();
+
+  profile->Collect(printPassesProfileFile != NULL);
+
+  mProfiles.push_back(profile);
 }
 
 void PhaseTracker::ReportPass() const
@@ -227,6 +308,50 @@ void PhaseTracker::PassesCollect(std::vector<Pass>& passes) const
   }
 }
 
+void PhaseTracker::ReportProfile(FILE* fp) const
+{
+  const char* passName = "";
+
+  INT_ASSERT(mProfiles.size() == mPhases.size() + 1);
+
+  PhaseProfile::Header(fp);
+
+  for (size_t i = 0; i < mPhases.size(); i++)
+  {
+    const char*   subPhase = "main";
+    int           passId   = mPhases[i]->mPassId;
+    unsigned long elapsed  = 0;
+
+    switch (mPhases[i]->mSubPhase)
+    {
+      case PhaseTracker::kPrimary:
+        passName = mPhases[i]->mName;
+        subPhase = "main";
+        break;
+
+      case PhaseTracker::kVerify:
+        subPhase = "check";
+        break;
+
+      case PhaseTracker::kCleanAst:
+        subPhase = "clean";
+        break;
+    }
+
+    if (i < mPhases.size() - 1)
+      elapsed = mPhases[i + 1]->mStartTime - mPhases[i]->mStartTime;
+    else
+      elapsed = mTimer.elapsedUsecs()     - mPhases[i]->mStartTime;
+
+    mProfiles[i + 1]->Print(fp,
+                            passId,
+                            passName,
+                            subPhase,
+                            elapsed,
+                            *mProfiles[i]);
+  }
+}
+
 static void PassesSortByTime(std::vector<Pass>& passes)
 {
   std::sort(passes.begin(), passes.end(), SortByTime());
@@ -456,5 +581,149 @@ void Pass::Footer(FILE*         fp,
           totalTime / 1e6);
 }
 
+/************************************* | **************************************
+*                                                                             *
+* Implementation of PhaseProfile                                              *
+*                                                                             *
+************************************** | *************************************/
+
+PhaseProfile::PhaseProfile()
+{
+  mMaxRssKB          = 0;
+  mHeapKB            = 0;
+  mAstAllocBytes     = 0;
+  mAstLiveBytes      = 0;
+  mInstantiatedFns   = 0;
+  mInstantiatedTypes = 0;
+}
+
+void PhaseProfile::Collect(bool countAst)
+{
+  struct rusage usage;
+  AstArenaStats arena;
+
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+#ifdef __APPLE__
+    mMaxRssKB = usage.ru_maxrss / 1024;
+#else
+    mMaxRssKB = usage.ru_maxrss;
+#endif
+  }
+
+#if defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  struct mallinfo2 info = mallinfo2();
+
+  mHeapKB = (info.uordblks + info.hblkhd) / 1024;
+#elif defined(__GLIBC__)
+  struct mallinfo  info = mallinfo();
+
+  mHeapKB = ((unsigned int) info.uordblks + (unsigned int) info.hblkhd) / 1024;
+#endif
+
+  astArenaStats(arena);
+
+  mAstAllocBytes     = arena.allocBytes;
+  mAstLiveBytes      = arena.liveBytes;
+  mInstantiatedFns   = gNumInstantiatedFns;
+  mInstantiatedTypes = gNumInstantiatedTypes;
+
+  // destroyAst() empties the vectors when it deletes the tree
+  if (countAst == true && rootModule != NULL && gModuleSymbols.n > 0)
+  {
+    AstCount count;
+
+    rootModule->accept(&count);
+
+#define push_count(type) mAstCounts.push_back(count.num##type)
+    foreach_ast(push_count);
+#undef push_count
+
+    mAstCounts.push_back(count.numWhileDoStmt);
+    mAstCounts.push_back(count.numDoWhileStmt);
+    mAstCounts.push_back(count.numCForLoop);
+    mAstCounts.push_back(count.numForLoop);
+    mAstCounts.push_back(count.numParamForLoop);
+  }
+}
+
+const std::vector<std::string>& PhaseProfile::AstNames()
+{
+  static std::vector<std::string> names;
 
+  if (names.size() == 0)
+  {
+#define push_name(type) names.push_back(#type)
+    foreach_ast(push_name);
+#undef push_name
+
+    names.push_back("WhileDoStmt");
+    names.push_back("DoWhileStmt");
+    names.push_back("CForLoop");
+    names.push_back("ForLoop");
+    names.push_back("ParamForLoop");
+  }
 
+  return names;
+}
+
+void PhaseProfile::Header(FILE* fp)
+{
+  const std::vector<std::string>& names = AstNames();
+
+  fprintf(fp, "pass,name,phase,seconds");
+  fprintf(fp, ",max_rss_kb,heap_kb,ast_alloc_kb,ast_live_kb");
+  fprintf(fp, ",fns_instantiated,types_instantiated");
+  fprintf(fp, ",ast_nodes");
+
+  for (size_t i = 0; i < names.size(); i++)
+    fprintf(fp, ",%s", names[i].c_str());
+
+  fprintf(fp, "\n");
+}
+
+//
+// The memory and AST columns are as of the end of the phase.  The
+// allocation and instantiation columns count what the phase did.
+//
+void PhaseProfile::Print(FILE*               fp,
+                         int                 passId,
+                         const char*         name,
+                         const char*         subPhase,
+                         unsigned long       elapsed,
+                         const PhaseProfile& start) const
+{
+  size_t numNames = AstNames().size();
+  int    numNodes = 0;
+
+  for (size_t i = 0; i < mAstCounts.size(); i++)
+    numNodes = numNodes + mAstCounts[i];
+
+  fprintf(fp, "%d,%s,%s,%.6f", passId, name, subPhase, elapsed / 1e6);
+
+  fprintf(fp,
+          ",%ld,%ld,%lu,%lu",
+          mMaxRssKB,
+          mHeapKB,
+          (unsigned long) ((mAstAllocBytes - start.mAstAllocBytes) / 1024),
+          (unsigned long) (mAstLiveBytes / 1024));
+
+  fprintf(fp,
+          ",%d,%d",
+          mInstantiatedFns   - start.mInstantiatedFns,
+          mInstantiatedTypes - start.mInstantiatedTypes);
+
+  fprintf(fp, ",%d", numNodes);
+
+  // Empty when the tree was not counted
+  for (size_t i = 0; i < numNames; i++)
+  {
+    if (i < mAstCounts.size())
+      fprintf(fp, ",%d", mAstCounts[i]);
+    else
+      fprintf(fp, ",");
+  }
+
+  fprintf(fp, "\n");
+}
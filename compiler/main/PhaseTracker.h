@@ -56,10 +56,18 @@
 * of these passes.  Phases that occur before and after the Passes ignore      *
 * the check and clean phases.                                                 *
 *                                                                             *
+* With --print-passes-profile the tracker also takes a profile of the         *
+* compiler's memory use and of the AST nodes in the tree at the start of      *
+* every phase, and ReportProfile() writes one CSV row for every phase.  The   *
+* time taken to count the nodes is not charged to any phase.  The options are *
+* parsed after the first phases have started, so the tracker takes profiles   *
+* until DisableProfile() tells it that they will not be reported.             *
+*                                                                             *
 ************************************** | *************************************/
 
 class Phase;
 class Pass;
+class PhaseProfile;
 
 class PhaseTracker
 {
@@ -84,6 +92,9 @@ public:
 
   void                 ReportRollup()                                const;
 
+  void                 DisableProfile();
+  void                 ReportProfile(FILE* fp)                       const;
+
 private:
   void                 PassesCollect(std::vector<Pass>& passes) const;
   
@@ -91,9 +102,15 @@ private:
                                   int         passId,
                                   SubPhase    subPhase);
 
-  Timer                mTimer;
-  int                  mPhaseId;
-  std::vector<Phase*>  mPhases;
+  void                 TakeProfile();
+
+  Timer                       mTimer;
+  int                         mPhaseId;
+  std::vector<Phase*>         mPhases;
+
+  // One for the start of each phase and one taken by Stop()
+  bool                        mProfile;
+  std::vector<PhaseProfile*>  mProfiles;
 };
 
 #endif
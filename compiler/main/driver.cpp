@@ -135,6 +135,7 @@ bool fEnableTaskTracking = false;
 
 bool  printPasses     = false;
 FILE* printPassesFile = NULL;
+FILE* printPassesProfileFile = NULL;
 
 // flag for llvmWideOpt
 bool fLLVMWideOpt = false;
@@ -152,8 +153,12 @@ bool fNoPrivatization = false;
 bool fNoOptimizeOnClauses = false;
 bool fNoRemoveEmptyRecords = true;
 bool fRemoveUnreachableBlocks = true;
+bool fResolutionMemo = true;
+bool fAstArenaReuse = true;
 bool fMinimalModules = false;
 bool fIncrementalCompilation = false;
+int fCCompileJobs = 0;
+char fCObjectCacheDir[FILENAME_MAX+1] = "";
 bool fUseIPE         = false;
 
 int optimize_on_clause_limit = 20;
@@ -751,6 +756,14 @@ static void setPrintPassesFile(const ArgumentDescription* desc, const char* file
   }
 }
 
+static void setPrintPassesProfile(const ArgumentDescription* desc, const char* fileName) {
+  printPassesProfileFile = fopen(fileName, "w");
+
+  if (printPassesProfileFile == NULL) {
+    USR_WARN("Error opening printPassesProfileFile: %s.", fileName);
+  }
+}
+
 static void setLocal (const ArgumentDescription* desc, const char* unused) {
   // Used in postLocal() to set fLocal if user threw flag
   fUserSetLocal = true;
@@ -864,6 +877,7 @@ static ArgumentDescription arg_desc[] = {
  {"print-commands", ' ', NULL, "[Don't] print system commands", "N", &printSystemCommands, "CHPL_PRINT_COMMANDS", NULL},
  {"print-passes", ' ', NULL, "[Don't] print compiler passes", "N", &printPasses, "CHPL_PRINT_PASSES", NULL},
  {"print-passes-file", ' ', "<filename>", "Print compiler passes to <filename>", "S", NULL, "CHPL_PRINT_PASSES_FILE", setPrintPassesFile},
+ {"print-passes-profile", ' ', "<filename>", "Print time, memory and AST counts for each pass to <filename> as CSV", "S", NULL, "CHPL_PRINT_PASSES_PROFILE", setPrintPassesProfile},
 
  {"", ' ', NULL, "Miscellaneous Options", NULL, NULL, NULL, NULL},
 // Support for extern { c-code-here } blocks could be toggled with this
@@ -969,6 +983,7 @@ static ArgumentDescription arg_desc[] = {
  {"library", ' ', NULL, "Generate a Chapel library file", "F", &fLibraryCompile, NULL, NULL},
  {"localize-global-consts", ' ', NULL, "Enable [disable] optimization of global constants", "n", &fNoGlobalConstOpt, "CHPL_DISABLE_GLOBAL_CONST_OPT", NULL},
  {"local-temp-names", ' ', NULL, "[Don't] Generate locally-unique temp names", "N", &localTempNames, "CHPL_LOCAL_TEMP_NAMES", NULL},
+ {"ast-arena-reuse", ' ', NULL, "Enable [disable] reusing the memory of deleted AST nodes", "N", &fAstArenaReuse, "CHPL_AST_ARENA_REUSE", NULL},
  {"log-deleted-ids-to", ' ', "<filename>", "Log AST id and memory address of each deleted node to the specified file", "P", deletedIdFilename, "CHPL_DELETED_ID_FILENAME", NULL},
  {"memory-frees", ' ', NULL, "Enable [disable] memory frees in the generated code", "n", &fNoMemoryFrees, "CHPL_DISABLE_MEMORY_FREES", NULL},
  {"preserve-inlined-line-numbers", ' ', NULL, "[Don't] Preserve file names/line numbers in inlined code", "N", &preserveInlinedLineNumbers, "CHPL_PRESERVE_INLINED_LINE_NUMBERS", NULL},
@@ -976,8 +991,11 @@ static ArgumentDescription arg_desc[] = {
  {"print-unused-internal-functions", ' ', NULL, "[Don't] print names and locations of unused internal functions", "N", &fPrintUnusedInternalFns, NULL, NULL},
  {"remove-empty-records", ' ', NULL, "Enable [disable] empty record removal", "n", &fNoRemoveEmptyRecords, "CHPL_DISABLE_REMOVE_EMPTY_RECORDS", NULL},
  {"remove-unreachable-blocks", ' ', NULL, "[Don't] remove unreachable blocks after resolution", "N", &fRemoveUnreachableBlocks, "CHPL_REMOVE_UNREACHABLE_BLOCKS", NULL},
+ {"resolution-memo", ' ', NULL, "Enable [disable] reusing the resolution of identical calls", "N", &fResolutionMemo, "CHPL_RESOLUTION_MEMO", NULL},
  {"replace-array-accesses-with-ref-temps", ' ', NULL, "Enable [disable] replacing array accesses with reference temps (experimental)", "N", &fReplaceArrayAccessesWithRefTemps, NULL, NULL },
  {"incremental", ' ', NULL, "Enable [disable] using incremental compilation", "N", &fIncrementalCompilation, "CHPL_INCREMENTAL_COMP", NULL},
+ {"c-compile-jobs", ' ', "<n>", "Number of parallel C compiles with --incremental (0 = one per core)", "I", &fCCompileJobs, "CHPL_C_COMPILE_JOBS", NULL},
+ {"c-object-cache", ' ', "<directory>", "Reuse unchanged --incremental objects from this directory", "P", fCObjectCacheDir, "CHPL_C_OBJECT_CACHE", NULL},
  {"minimal-modules", ' ', NULL, "Enable [disable] using minimal modules",               "N", &fMinimalModules, "CHPL_MINIMAL_MODULES", NULL},
  {"print-chpl-settings", ' ', NULL, "Print current chapel settings and exit", "F", &fPrintChplSettings, NULL,NULL},
  {"user-constructor-error", ' ', NULL, "Enable [disable] errors for user code constructors", "N", &fNoUserConstructors, NULL, NULL},
@@ -1323,6 +1341,9 @@ int main(int argc, char* argv[]) {
 
     postprocess_args();
 
+    if (printPassesProfileFile == NULL)
+      tracker.DisableProfile();
+
     initCompilerGlobals(); // must follow argument parsing
 
     setupModulePaths();
@@ -1363,6 +1384,12 @@ int main(int argc, char* argv[]) {
     fclose(printPassesFile);
   }
 
+  if (printPassesProfileFile != NULL) {
+    tracker.ReportProfile(printPassesProfileFile);
+
+    fclose(printPassesProfileFile);
+  }
+
   clean_exit(0);
 
   return 0;
@@ -112,7 +112,9 @@ void parse() {
 *                            ./localeModels/knl/LocaleModel.chpl              *
 *                            ./localeModels/numa/LocaleModel.chpl             *
 *                                                                             *
-*   NetworkAtomicTypes       ./comm/ugni/NetworkAtomicTypes.chpl              *
+*   NetworkAtomicTypes       ./comm/gasnet/NetworkAtomicTypes.chpl            *
+*                            ./comm/ofi/NetworkAtomicTypes.chpl               *
+*                            ./comm/ugni/NetworkAtomicTypes.chpl              *
 *                            ./NetworkAtomicTypes.chpl                        *
 *                                                                             *
 * The search paths include the value of configuration variables.              *
@@ -30,13 +30,22 @@
 *                                                                             *
 ************************************** | *************************************/
 
-SymbolMapCache genericsCache;
-SymbolMapCache promotionsCache;
+SymbolMapCache genericsCache("generics");
+SymbolMapCache promotionsCache("promotions");
 
-static bool isCacheEntryMatch(SymbolMap* s1, SymbolMap* s2);
+static size_t hashSymbolMap(SymbolMap* map);
+static bool   isCacheEntryMatch(SymbolMap* s1, SymbolMap* s2);
+static SymbolMapCacheEntry* findCacheEntry(SymbolMapCache& cache,
+                                           FnSymbol*       oldFn,
+                                           SymbolMap*      map);
 
-SymbolMapCacheEntry::SymbolMapCacheEntry(FnSymbol* ifn, SymbolMap* imap) :
-  fn(ifn), map(*imap) { }
+SymbolMapCacheEntry::SymbolMapCacheEntry(FnSymbol*  ifn,
+                                         SymbolMap* imap,
+                                         size_t     ihash) :
+  fn(ifn), map(*imap), hash(ihash) { }
+
+SymbolMapCache::SymbolMapCache(const char* iname) :
+  name(iname), numLookups(0), numHits(0), numCollisions(0) { }
 
 
 void
@@ -44,28 +53,29 @@ addCache(SymbolMapCache& cache,
          FnSymbol*       oldFn,
          FnSymbol*       fn,
          SymbolMap*      map) {
-  Vec<SymbolMapCacheEntry*>* entries = cache.get(oldFn);
-  SymbolMapCacheEntry*       entry   = new SymbolMapCacheEntry(fn, map);
-
-  if (entries) {
-    entries->add(entry);
+  SymbolMapCacheBuckets* buckets = cache.fns.get(oldFn);
+  size_t                 hash    = hashSymbolMap(map);
 
-  } else {
-    entries = new Vec<SymbolMapCacheEntry*>();
-    entries->add(entry);
-    cache.put(oldFn, entries);
+  if (buckets == NULL) {
+    buckets = new SymbolMapCacheBuckets();
+    cache.fns.put(oldFn, buckets);
   }
+
+  (*buckets)[hash].push_back(new SymbolMapCacheEntry(fn, map, hash));
 }
 
 
 FnSymbol*
 checkCache(SymbolMapCache& cache, FnSymbol* oldFn, SymbolMap* map) {
-  if (Vec<SymbolMapCacheEntry*>* entries = cache.get(oldFn)) {
-    forv_Vec(SymbolMapCacheEntry, entry, *entries) {
-      if (isCacheEntryMatch(map, &entry->map))
-        return entry->fn;
-    }
+  SymbolMapCacheEntry* entry = findCacheEntry(cache, oldFn, map);
+
+  cache.numLookups++;
+
+  if (entry != NULL) {
+    cache.numHits++;
+    return entry->fn;
   }
+
   return NULL;
 }
 
@@ -75,13 +85,9 @@ replaceCache(SymbolMapCache& cache,
              FnSymbol*       oldFn,
              FnSymbol*       fn,
              SymbolMap*      map) {
-  if (Vec<SymbolMapCacheEntry*>* entries = cache.get(oldFn)) {
-    forv_Vec(SymbolMapCacheEntry, entry, *entries) {
-      if (isCacheEntryMatch(map, &entry->map)) {
-        entry->fn = fn;
-        return;
-      }
-    }
+  if (SymbolMapCacheEntry* entry = findCacheEntry(cache, oldFn, map)) {
+    entry->fn = fn;
+    return;
   }
 
   INT_FATAL(oldFn, "unable to replace cache entry; entry does not exist");
@@ -90,13 +96,99 @@ replaceCache(SymbolMapCache& cache,
 
 void
 freeCache(SymbolMapCache& cache) {
-  form_Map(SymbolMapCacheElem, elem, cache) {
-    forv_Vec(SymbolMapCacheEntry, entry, *elem->value) {
-      delete entry;
+  form_Map(SymbolMapCacheElem, elem, cache.fns) {
+    SymbolMapCacheBuckets* buckets = elem->value;
+
+    for (SymbolMapCacheBuckets::iterator it  = buckets->begin();
+                                         it != buckets->end();
+                                         ++it) {
+      for_vector(SymbolMapCacheEntry, entry, it->second) {
+        delete entry;
+      }
     }
-    delete elem->value;
+
+    delete buckets;
   }
-  cache.clear();
+
+  cache.fns.clear();
+}
+
+
+void
+printCacheStatistics(SymbolMapCache& cache) {
+  long   numEntries = 0;
+  double hitRate    = 0.0;
+
+  form_Map(SymbolMapCacheElem, elem, cache.fns) {
+    SymbolMapCacheBuckets* buckets = elem->value;
+
+    for (SymbolMapCacheBuckets::iterator it  = buckets->begin();
+                                         it != buckets->end();
+                                         ++it) {
+      numEntries += it->second.size();
+    }
+  }
+
+  if (cache.numLookups > 0)
+    hitRate = 100.0 * cache.numHits / cache.numLookups;
+
+  fprintf(stderr,
+          "%s cache: %ld entries, %ld lookups, %ld hits (%.1f%%), "
+          "%ld misses, %ld hash collisions\n",
+          cache.name,
+          numEntries,
+          cache.numLookups,
+          cache.numHits,
+          hitRate,
+          cache.numLookups - cache.numHits,
+          cache.numCollisions);
+}
+
+static SymbolMapCacheEntry* findCacheEntry(SymbolMapCache& cache,
+                                           FnSymbol*       oldFn,
+                                           SymbolMap*      map) {
+  if (SymbolMapCacheBuckets* buckets = cache.fns.get(oldFn)) {
+    SymbolMapCacheBuckets::iterator it = buckets->find(hashSymbolMap(map));
+
+    if (it != buckets->end()) {
+      for_vector(SymbolMapCacheEntry, entry, it->second) {
+        if (isCacheEntryMatch(map, &entry->map))
+          return entry;
+
+        cache.numCollisions++;
+      }
+    }
+  }
+
+  return NULL;
+}
+
+//
+// Combine the (key, value) pairs with addition so that the hash does
+// not depend on the order of the underlying hash table.  Pairs with a
+// NULL value are skipped because SymbolMap::get() cannot tell them
+// apart from missing keys, and isCacheEntryMatch() treats them alike.
+//
+static size_t hashSymbolMap(SymbolMap* map) {
+  size_t retval = 0;
+
+  form_Map(SymbolMapElem, e, *map) {
+    if (e->value != NULL) {
+      uint64_t h = (uint64_t) (uintptr_t) e->key * 0x9e3779b97f4a7c15ULL;
+
+      h ^= (uint64_t) (uintptr_t) e->value + 0x632be59bd9b4e019ULL +
+           (h << 6) + (h >> 2);
+
+      // final avalanche (from MurmurHash3's fmix64)
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+
+      retval += (size_t) h;
+    }
+  }
+
+  return retval;
 }
 
 static bool isCacheEntryMatch(SymbolMap* s1, SymbolMap* s2) {
@@ -196,3 +288,137 @@ static bool isCacheEntryMatch(Vec<Symbol*>* vec1, Vec<Symbol*>* vec2) {
 }
 
 
+/************************************* | **************************************
+*                                                                             *
+*                                                                             *
+*                                                                             *
+************************************** | *************************************/
+
+CallResolutionMemo callResolutionMemo;
+
+static size_t hashCallResolutionMemoKey(const CallResolutionMemoKey& key);
+
+CallResolutionMemoEntry::CallResolutionMemoEntry(
+                          const CallResolutionMemoKey&   ikey,
+                          FnSymbol*                      ifn,
+                          const std::vector<ArgSymbol*>& iactualIdxToFormal) :
+  key(ikey), fn(ifn), actualIdxToFormal(iactualIdxToFormal) { }
+
+CallResolutionMemo::CallResolutionMemo() :
+  numLookups(0), numHits(0), numInvalidations(0),
+  numEntries(0), maxEntries(0) { }
+
+
+CallResolutionMemoEntry*
+CallResolutionMemo::get(const char*                  name,
+                        const CallResolutionMemoKey& key) {
+  std::map<const char*, Buckets>::iterator byName = names.find(name);
+
+  numLookups++;
+
+  if (byName != names.end()) {
+    Buckets&          buckets = byName->second;
+    Buckets::iterator it      = buckets.find(hashCallResolutionMemoKey(key));
+
+    if (it != buckets.end()) {
+      for_vector(CallResolutionMemoEntry, entry, it->second) {
+        if (entry->key == key) {
+          numHits++;
+          return entry;
+        }
+      }
+    }
+  }
+
+  return NULL;
+}
+
+
+void
+CallResolutionMemo::put(const char*                    name,
+                        const CallResolutionMemoKey&   key,
+                        FnSymbol*                      fn,
+                        const std::vector<ArgSymbol*>& actualIdxToFormal) {
+  size_t hash = hashCallResolutionMemoKey(key);
+
+  names[name][hash].push_back(new CallResolutionMemoEntry(key,
+                                                          fn,
+                                                          actualIdxToFormal));
+
+  numEntries++;
+
+  if (numEntries > maxEntries)
+    maxEntries = numEntries;
+}
+
+
+void
+CallResolutionMemo::invalidate(const char* name) {
+  std::map<const char*, Buckets>::iterator byName = names.find(name);
+
+  if (byName != names.end()) {
+    numInvalidations++;
+    clear(byName->second);
+    names.erase(byName);
+  }
+}
+
+
+void
+CallResolutionMemo::invalidate() {
+  if (names.empty() == false) {
+    numInvalidations++;
+
+    for (std::map<const char*, Buckets>::iterator it  = names.begin();
+                                                  it != names.end();
+                                                  ++it) {
+      clear(it->second);
+    }
+
+    names.clear();
+  }
+}
+
+
+void
+CallResolutionMemo::clear(Buckets& buckets) {
+  for (Buckets::iterator it = buckets.begin(); it != buckets.end(); ++it) {
+    for_vector(CallResolutionMemoEntry, entry, it->second) {
+      delete entry;
+      numEntries--;
+    }
+  }
+
+  buckets.clear();
+}
+
+
+void
+CallResolutionMemo::printStatistics() {
+  double hitRate = 0.0;
+
+  if (numLookups > 0)
+    hitRate = 100.0 * numHits / numLookups;
+
+  fprintf(stderr,
+          "call resolution memo: %ld lookups, %ld hits (%.1f%%), "
+          "%ld misses, %ld invalidations, %ld max entries\n",
+          numLookups,
+          numHits,
+          hitRate,
+          numLookups - numHits,
+          numInvalidations,
+          maxEntries);
+}
+
+static size_t hashCallResolutionMemoKey(const CallResolutionMemoKey& key) {
+  uint64_t retval = 0xcbf29ce484222325ULL;
+
+  for (size_t i = 0; i < key.size(); i++) {
+    retval ^= (uint64_t) key[i];
+    retval *= 0x100000001b3ULL;
+    retval ^= retval >> 29;
+  }
+
+  return (size_t) retval;
+}
@@ -22,6 +22,9 @@
 
 #include "baseAST.h"
 
+#include <map>
+#include <vector>
+
 //
 // SymbolMapCache: FnSymbol -> FnSymbol cache based on a SymbolMap
 //
@@ -35,16 +38,36 @@
 //
 //   freeCache(cache): frees memory associated with cache
 //
+//   Entries for each old_fn are bucketed by an order-independent hash
+//   of their map, so a lookup only compares maps in full when the
+//   hashes agree.
+//
 class SymbolMapCacheEntry {
 public:
-  SymbolMapCacheEntry(FnSymbol* ifn, SymbolMap* imap);
+  SymbolMapCacheEntry(FnSymbol* ifn, SymbolMap* imap, size_t ihash);
 
   FnSymbol* fn;
   SymbolMap map;
+  size_t    hash;
 };
 
-typedef Map<FnSymbol*,     Vec<SymbolMapCacheEntry*>*> SymbolMapCache;
-typedef MapElem<FnSymbol*, Vec<SymbolMapCacheEntry*>*> SymbolMapCacheElem;
+typedef std::map<size_t, std::vector<SymbolMapCacheEntry*> >
+                                                    SymbolMapCacheBuckets;
+
+class SymbolMapCache {
+public:
+  SymbolMapCache(const char* iname);
+
+  const char*                           name;
+  Map<FnSymbol*, SymbolMapCacheBuckets*> fns;
+
+  // for --print-statistics
+  long numLookups;
+  long numHits;
+  long numCollisions;  // hashes matched but the maps did not
+};
+
+typedef MapElem<FnSymbol*, SymbolMapCacheBuckets*> SymbolMapCacheElem;
 
 
 void      addCache(SymbolMapCache& cache,
@@ -63,6 +86,8 @@ void      replaceCache(SymbolMapCache& cache,
 
 void      freeCache(SymbolMapCache& cache);
 
+void      printCacheStatistics(SymbolMapCache& cache);
+
 //
 // Caches to avoid creating multiple identical wrappers and
 // instantiating the same functions in the same ways
@@ -124,4 +149,72 @@ void      freeCache(SymbolVecCache& cache);
 //
 extern SymbolVecCache defaultsCache;
 
+
+
+//
+// CallResolutionMemo: remembers the function chosen for a call
+//
+//   Entries are looked up by the called name plus a key built by the
+//   caller.  The key must capture everything else that candidate
+//   selection depends on: the visibility block, the call's tags and,
+//   for each actual, its name and its type or (for params and types)
+//   the symbol itself.
+//
+//   get(name, key): returns the entry for a call with the same name
+//                   and key, or NULL
+//   put(name, key, fn, actualIdxToFormal): remembers the chosen
+//                   function and the alignment of the actuals to its
+//                   formals
+//   invalidate(name): forgets the entries for calls to 'name'; used
+//                   when a new function by that name becomes visible
+//   invalidate(): forgets all entries
+//
+typedef std::vector<intptr_t> CallResolutionMemoKey;
+
+class CallResolutionMemoEntry {
+public:
+  CallResolutionMemoEntry(const CallResolutionMemoKey&   ikey,
+                          FnSymbol*                      ifn,
+                          const std::vector<ArgSymbol*>& iactualIdxToFormal);
+
+  CallResolutionMemoKey   key;
+  FnSymbol*               fn;
+  std::vector<ArgSymbol*> actualIdxToFormal;
+};
+
+class CallResolutionMemo {
+public:
+  CallResolutionMemo();
+
+  CallResolutionMemoEntry* get(const char*                    name,
+                               const CallResolutionMemoKey&   key);
+
+  void                     put(const char*                    name,
+                               const CallResolutionMemoKey&   key,
+                               FnSymbol*                      fn,
+                               const std::vector<ArgSymbol*>& actualIdxToFormal);
+
+  void                     invalidate(const char* name);
+
+  void                     invalidate();
+
+  void                     printStatistics();
+
+  // for --print-statistics
+  long                     numLookups;
+  long                     numHits;
+  long                     numInvalidations;
+
+private:
+  typedef std::map<size_t, std::vector<CallResolutionMemoEntry*> > Buckets;
+
+  void                     clear(Buckets& buckets);
+
+  std::map<const char*, Buckets> names;
+  long                     numEntries;
+  long                     maxEntries;
+};
+
+extern CallResolutionMemo callResolutionMemo;
+
 #endif
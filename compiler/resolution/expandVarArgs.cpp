@@ -225,6 +225,8 @@ static FnSymbol* expandVarArgsQuery(FnSymbol* fn, CallInfo& info) {
         retval->addFlag(FLAG_INVISIBLE_FN);
         retval->instantiatedFrom = fn;
 
+        gNumInstantiatedFns = gNumInstantiatedFns + 1;
+
         fn->defPoint->insertBefore(new DefExpr(retval));
 
         // newSym queries the number of varargs. Replace it with int literal.
@@ -104,6 +104,9 @@ bool                               beforeLoweringForallStmts = true;
 
 int                                explainCallLine           = 0;
 
+int                                gNumInstantiatedFns       = 0;
+int                                gNumInstantiatedTypes     = 0;
+
 SymbolMap                          paramMap;
 
 Vec<CallExpr*>                     callStack;
@@ -2039,6 +2042,13 @@ static bool      isGenericRecordInit(CallExpr* call);
 
 static FnSymbol* resolveNormalCall(CallInfo& info, bool checkOnly);
 
+static bool      buildResolutionMemoKey(CallInfo&              info,
+                                        CallResolutionMemoKey& key);
+
+static void      checkResolutionMemo(CallInfo&                info,
+                                     CallResolutionMemoEntry* memo,
+                                     ResolutionCandidate*     best);
+
 static void      findVisibleFunctionsAndCandidates(
                                      CallInfo&                  info,
                                      Vec<FnSymbol*>&            visibleFns,
@@ -2130,6 +2140,24 @@ static FnSymbol* resolveNormalCall(CallInfo& info, bool checkOnly) {
 
   FnSymbol*                 retval     = NULL;
 
+  CallResolutionMemoKey     memoKey;
+  CallResolutionMemoEntry*  memo       = NULL;
+  bool                      useMemo    = buildResolutionMemoKey(info,
+                                                                memoKey);
+
+  if (useMemo == true) {
+    memo = callResolutionMemo.get(info.name, memoKey);
+
+    // With --verify, resolve in full anyway and check the memo agrees
+    if (memo != NULL && fVerify == false) {
+      ResolutionCandidate best(memo->fn);
+
+      best.actualIdxToFormal = memo->actualIdxToFormal;
+
+      return resolveNormalCall(info, checkOnly, &best);
+    }
+  }
+
   findVisibleFunctionsAndCandidates(info, visibleFns, candidates);
 
   numMatches = disambiguateByMatch(info,
@@ -2167,9 +2195,21 @@ static FnSymbol* resolveNormalCall(CallInfo& info, bool checkOnly) {
       best = bestCref;
     }
 
+    if (memo != NULL) {
+      checkResolutionMemo(info, memo, best);
+
+    } else if (useMemo == true && tryFailure == false) {
+      callResolutionMemo.put(info.name,
+                             memoKey,
+                             best->fn,
+                             best->actualIdxToFormal);
+    }
+
     retval = resolveNormalCall(info, checkOnly, best);
 
   } else {
+    checkResolutionMemo(info, memo, NULL);
+
     retval = resolveNormalCall(info, checkOnly, bestRef, bestCref, bestVal);
   }
 
@@ -2180,6 +2220,90 @@ static FnSymbol* resolveNormalCall(CallInfo& info, bool checkOnly) {
   return retval;
 }
 
+//
+// The call resolution memo lets a call reuse the candidate chosen for
+// an earlier call with the same key, skipping the search for visible
+// functions, candidate filtering and disambiguation.  Only calls that
+// resolved to a single best candidate, outside of a failed tryToken
+// resolution, are remembered, along with the alignment of actuals to
+// formals that wrapAndCleanUpActuals() needs.  The candidate may be an
+// instantiation of a generic function, and the call may need promotion
+// or other wrappers; those are made again for each call from the same
+// candidate and alignment, as they would be without the memo.
+//
+// The memo is indexed by the called name.  The key has any explicit
+// module scope, the outermost equivalent visibility block, the module
+// containing the call (for private functions) and the call's tags,
+// plus the name, the type (or the symbol, for params and types) and
+// relevant flags of each actual.  Calls with anything else
+// that could affect the choice are not memoized.
+//
+static bool buildResolutionMemoKey(CallInfo&              info,
+                                   CallResolutionMemoKey& key) {
+  CallExpr* call = info.call;
+
+  if (fResolutionMemo                     == false ||
+      isUnresolvedSymExpr(call->baseExpr) == false ||
+      call->id                            == explainCallID) {
+    return false;
+  }
+
+  if (explainCallLine != 0 && explainCallMatch(call) == true) {
+    return false;
+  }
+
+  key.push_back((intptr_t) info.scope);
+  key.push_back((intptr_t) getEquivalentVisibilityBlock(call));
+  key.push_back((intptr_t) call->getModule());
+  key.push_back((call->methodTag  ? 1 : 0) |
+                (call->partialTag ? 2 : 0) |
+                (call->square     ? 4 : 0));
+
+  for (int i = 0; i < info.actuals.n; i++) {
+    Symbol*    sym = info.actuals.v[i];
+    Type*      t   = sym->type;
+    VarSymbol* var = toVarSymbol(sym);
+
+    key.push_back((intptr_t) info.actualNames.v[i]);
+
+    if ((var != NULL && var->immediate != NULL) ||
+        isEnumSymbol(sym)                       ||
+        isTypeSymbol(sym)) {
+      // a param value or a type stands for itself
+      key.push_back((intptr_t) sym);
+      key.push_back(1);
+
+    } else if (sym->isParameter()               == true      ||
+               t                                == dtUnknown ||
+               t->symbol->hasFlag(FLAG_GENERIC) == true) {
+      return false;
+
+    } else {
+      key.push_back((intptr_t) t);
+      key.push_back(2 |
+                    (sym->hasFlag(FLAG_TYPE_VARIABLE) ? 4 : 0) |
+                    (sym->isConstant()                ? 8 : 0));
+    }
+  }
+
+  return true;
+}
+
+// With --verify, a memoized call is also resolved in full; check that
+// both choose the same function with the same alignment.
+static void checkResolutionMemo(CallInfo&                info,
+                                CallResolutionMemoEntry* memo,
+                                ResolutionCandidate*     best) {
+  if (memo != NULL) {
+    if (best                    == NULL      ||
+        best->fn                != memo->fn  ||
+        best->actualIdxToFormal != memo->actualIdxToFormal) {
+      INT_FATAL(info.call,
+                "call resolution memo disagrees with full resolution");
+    }
+  }
+}
+
 static FnSymbol* resolveNormalCall(CallInfo&            info,
                                    bool                 checkOnly,
                                    ResolutionCandidate* best) {
@@ -7185,6 +7309,14 @@ void resolve() {
 
   freeCache(defaultsCache);
 
+  if (fPrintStatistics[0] != '\0') {
+    printCacheStatistics(genericsCache);
+    printCacheStatistics(promotionsCache);
+    callResolutionMemo.printStatistics();
+  }
+
+  callResolutionMemo.invalidate();
+
   freeCache(genericsCache);
   freeCache(promotionsCache);
 
@@ -376,6 +376,8 @@ static AggregateType* instantiateTypeForTypeConstructor(FnSymbol*      fn,
   } else if (AggregateType* at = toAggregateType(fn->retType)) {
     newCt->instantiatedFrom = at;
 
+    gNumInstantiatedTypes = gNumInstantiatedTypes + 1;
+
   } else {
     INT_ASSERT(false);
   }
@@ -603,6 +605,8 @@ FnSymbol* instantiateFunction(FnSymbol*  fn,
   newFn->instantiatedFrom = fn;
   newFn->substitutions.map_union(allSubs);
 
+  gNumInstantiatedFns = gNumInstantiatedFns + 1;
+
   if (call) {
     newFn->instantiationPoint = getVisibilityBlock(call);
   }
@@ -381,6 +381,8 @@ TupleInfo getTupleInfo(std::vector<TypeSymbol*>& args,
 
     newType->instantiatedFrom = dtTuple;
 
+    gNumInstantiatedTypes = gNumInstantiatedTypes + 1;
+
     forv_Vec(Type, t, dtTuple->dispatchParents) {
       AggregateType* at = toAggregateType(t);
 
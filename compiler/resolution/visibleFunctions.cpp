@@ -19,6 +19,7 @@
 
 #include "visibleFunctions.h"
 
+#include "caches.h"
 #include "callInfo.h"
 #include "driver.h"
 #include "expr.h"
@@ -69,6 +70,7 @@ static int                                    nVisibleFunctions       = 0;
 ************************************** | *************************************/
 
 static void  buildVisibleFunctionMap();
+static bool  isRenamedByUse(const char* name);
 
 void findVisibleFunctions(CallInfo&       info,
                           Vec<FnSymbol*>& visibleFns) {
@@ -149,11 +151,39 @@ static void buildVisibleFunctionMap() {
         vfb->visibleFunctions.put(fn->name, fns);
       }
       fns->add(fn);
+
+      // A new visible function can change what calls by its name
+      // resolve to.  With 'use ... as', it can also be called by
+      // another name, so then forget all the remembered calls.
+      if (isRenamedByUse(fn->name) == true) {
+        callResolutionMemo.invalidate();
+      } else {
+        callResolutionMemo.invalidate(fn->name);
+      }
     }
   }
   nVisibleFunctions = gFnSymbols.n;
 }
 
+// Is 'name' renamed by any 'use' statement?
+static bool isRenamedByUse(const char* name) {
+  static std::set<const char*> renamedNames;
+  static int                   nUseStmtsSeen = 0;
+
+  for (int i = nUseStmtsSeen; i < gUseStmts.n; i++) {
+    std::map<const char*, const char*>&          renamed = gUseStmts.v[i]->renamed;
+    std::map<const char*, const char*>::iterator it;
+
+    for (it = renamed.begin(); it != renamed.end(); ++it) {
+      renamedNames.insert(it->second);
+    }
+  }
+
+  nUseStmtsSeen = gUseStmts.n;
+
+  return renamedNames.find(name) != renamedNames.end();
+}
+
 /************************************* | **************************************
 *                                                                             *
 * Collects functions called 'name' visible in 'block' and up the visibility   *
@@ -291,6 +321,42 @@ static BlockStmt* getVisibleFunctions(const char*           name,
   return retval;
 }
 
+/************************************* | **************************************
+*                                                                             *
+* Returns the outermost block that has the same visible functions as          *
+* getVisibilityBlock(expr).  Blocks that neither define visible functions     *
+* nor 'use' modules are skipped, following the visibility chain (so from an   *
+* instantiated function to its point of instantiation).  The search stops at  *
+* module blocks.                                                              *
+*                                                                             *
+* This lets identical calls in different functions share an entry in the      *
+* call resolution memo.  Whether private functions are visible depends on     *
+* the module containing the call, which the memo keys on separately.          *
+*                                                                             *
+************************************** | *************************************/
+
+BlockStmt* getEquivalentVisibilityBlock(Expr* expr) {
+  BlockStmt* block = getVisibilityBlock(expr);
+
+  if (gFnSymbols.n != nVisibleFunctions) {
+    buildVisibleFunctionMap();
+  }
+
+  while (block                               != rootModule->block &&
+         isModuleSymbol(block->parentSymbol) == false             &&
+         block->useList                      == NULL              &&
+         visibleFunctionMap.get(block)       == NULL) {
+    // e.g. a block that is being resolved before it is inserted
+    if (block->parentExpr == NULL && block->parentSymbol == NULL) {
+      break;
+    }
+
+    block = getVisibilityBlock(block);
+  }
+
+  return block;
+}
+
 /************************************* | **************************************
 *                                                                             *
 * return the innermost block for searching for visible functions              *
@@ -717,10 +717,13 @@ void codegen_makefile(fileinfo* mainfile, const char** tmpbinname, bool skip_com
 
   fprintf(makefile.fptr, "CHPLSRC = \\\n");
   fprintf(makefile.fptr, "\t%s \\\n\n", mainfile->pathname);
-  fprintf(makefile.fptr, "CHPLUSEROBJ = \\\n");
+  // objects for the modules compiled as separate translation units;
+  // see Makefile.module-objs
+  fprintf(makefile.fptr, "CHPL_MODULE_OBJS = \\\n");
   for(int i=0; i<(int)splitFiles.size(); i++)
     fprintf(makefile.fptr, "\t%s \\\n", splitFiles[i]);
   fprintf(makefile.fptr, "\n");
+  fprintf(makefile.fptr, "CHPL_OBJ_CACHE_DIR = %s\n\n", fCObjectCacheDir);
   genCFiles(makefile.fptr);
   genObjFiles(makefile.fptr);
   fprintf(makefile.fptr, "\nLIBS =");
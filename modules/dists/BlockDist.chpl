@@ -1271,6 +1271,193 @@ proc BlockArr.dsiPrivatize(privatizeData) {
   return c;
 }
 
+//
+// Parallel scan of a 1D Block array.  Every locale reduces its own
+// block with DefaultRectangular's chpl__preScan(), the locales' totals
+// are combined in order here, and then every locale scans its block
+// into the result's block, starting from the locales before it.
+//
+proc BlockArr.doiScan(op, dom) where rank == 1 &&
+                                     !stridable &&
+                                     chpl__scanParSupported(op) {
+  type resType = op.generate().type;
+  var res: [dom] resType;
+  const ref targetLocDom = this.dom.dist.targetLocDom;
+  const ref targetLocs = this.dom.dist.targetLocales;
+  const resArr = res._value;
+
+  var chunks: [targetLocDom] chpl__ScanChunks(op.type);
+  var totals: [targetLocDom] op.type;
+
+  coforall locid in targetLocDom do on targetLocs[locid] {
+    const myElems = locArr[locid].myElems._value;
+    const myChunks = myElems.chpl__preScan(op, myElems.dom.dsiDim(1));
+    chunks[locid] = myChunks;
+    totals[locid] = myChunks.total(op);
+  }
+
+  // befores[locid] holds everything on the locales before locid
+  var befores: [targetLocDom] op.type;
+  for locid in targetLocDom {
+    befores[locid] = op.clone();
+    if locid > targetLocDom.low {
+      befores[locid].combine(befores[locid-1]);
+      befores[locid].combine(totals[locid-1]);
+    }
+  }
+
+  coforall locid in targetLocDom do on targetLocs[locid] {
+    const myElems = locArr[locid].myElems._value;
+    const myRes = resArr.locArr[locid].myElems._value;
+    myElems.chpl__postScan(op, myRes, myElems.dom.dsiDim(1), chunks[locid],
+                           befores[locid]);
+  }
+
+  for locid in targetLocDom {
+    delete totals[locid];
+    delete befores[locid];
+  }
+
+  return res;
+}
+
+//
+// Sample sort of a 1D Block array, called by Sort.sort():
+//
+// 1. Every locale sorts its own block and takes evenly spaced samples
+//    from it.
+// 2. The sorted samples give a splitter between each pair of neighboring
+//    locales.
+// 3. Every locale finds where the splitters fall in its block.  Then each
+//    locale pulls, with one bulk get per locale, every element that falls
+//    between its own two splitters.  It merges these sorted runs.
+// 4. Once every locale has its elements, each writes them back into the
+//    positions of the Block array that they occupy in sorted order.
+//
+proc BlockArr.doiSort(comparator) where rank == 1 &&
+                                         !stridable &&
+                                         idxType == int {
+  use Sort;
+
+  const ref targetLocs = dom.dist.targetLocales;
+  const numLocs = targetLocs.size,
+        numSamples = 4 * numLocs;
+
+  if numLocs == 1 {
+    on targetLocs[0] do chpl_sortLocal(locArr[0].myElems, comparator);
+    return;
+  }
+
+  var samples: [0..#numLocs, 0..#numSamples] eltType;
+  var numSampled: [0..#numLocs] int;
+
+  coforall locid in 0..#numLocs do on targetLocs[locid] {
+    ref mine = locArr[locid].myElems;
+    const myLo = mine.domain.low,
+          n = mine.domain.size,
+          k = min(n, numSamples);
+
+    chpl_sortLocal(mine, comparator);
+
+    for s in 0..#k do
+      samples[locid, s] = mine[myLo + (s * n + n / 2) / k];
+    numSampled[locid] = k;
+  }
+
+  var allSamples: [0..#(+ reduce numSampled)] eltType;
+  var next = 0;
+  for locid in 0..#numLocs {
+    for s in 0..#numSampled[locid] {
+      allSamples[next] = samples[locid, s];
+      next += 1;
+    }
+  }
+  if allSamples.size == 0 then return;
+  quickSort(allSamples, comparator=comparator);
+
+  var splitters: [0..#numLocs-1] eltType;
+  for d in 0..#numLocs-1 do
+    splitters[d] = allSamples[((d + 1) * allSamples.size) / numLocs];
+
+  // cuts[src, d] is where the elements of src's block that go to d begin
+  var cuts: [0..#numLocs, 0..numLocs] int;
+
+  coforall locid in 0..#numLocs do on targetLocs[locid] {
+    const mySplitters = splitters;
+    ref mine = locArr[locid].myElems;
+    const myLo = mine.domain.low,
+          n = mine.domain.size;
+    var myCuts: [0..numLocs] int;
+
+    // Elements equal to a splitter may go to either side of it, so split
+    // them where the block would be split evenly
+    for d in 1..numLocs-1 {
+      const s = mySplitters[d-1],
+            lo = chpl_sortBound(mine, myLo, n, s, false, comparator),
+            hi = chpl_sortBound(mine, myLo, n, s, true, comparator);
+      myCuts[d] = max(lo, min(hi, (d * n) / numLocs));
+    }
+    myCuts[numLocs] = n;
+
+    for d in 0..numLocs do
+      cuts[locid, d] = myCuts[d];
+  }
+
+  // recvLo[src, d] is where src's elements go in d's receive buffer, and
+  // destLo[d] is the position of the first element d receives
+  var recvLo: [0..#numLocs, 0..#numLocs] int;
+  var destLo: [0..numLocs] int;
+  var total = 0;
+  for d in 0..#numLocs {
+    destLo[d] = total;
+    for src in 0..#numLocs {
+      recvLo[src, d] = total - destLo[d];
+      total += cuts[src, d+1] - cuts[src, d];
+    }
+  }
+  destLo[numLocs] = total;
+
+  var numPulled: atomic int;
+
+  coforall d in 0..#numLocs do on targetLocs[d] {
+    const myCuts = cuts,
+          myRecvLo = recvLo,
+          myDestLo = destLo;
+    const n = myDestLo[d+1] - myDestLo[d];
+    var buf: [0..#n] eltType;
+    var runs: [0..numLocs] int;
+
+    forall i in 0..#numLocs {
+      const src = (d + i) % numLocs,
+            count = myCuts[src, d+1] - myCuts[src, d];
+      runs[src] = myRecvLo[src, d];
+      if count > 0 {
+        ref srcElems = locArr[src].myElems;
+        const srcLo = srcElems.domain.low + myCuts[src, d];
+        buf[myRecvLo[src, d]..#count] = srcElems[srcLo..#count];
+      }
+    }
+    runs[numLocs] = n;
+
+    chpl_mergeRuns(buf, runs, comparator);
+
+    // Nobody's block may be overwritten until everybody has pulled from it
+    numPulled.add(1);
+    numPulled.waitFor(numLocs);
+
+    var i = dom.whole.dim(1).low + myDestLo[d],
+        b = 0;
+    while b < n {
+      const t = dom.dist.targetLocsIdx(i);
+      ref dstElems = locArr[t].myElems;
+      const count = min(n - b, dstElems.domain.high - i + 1);
+      dstElems[i..#count] = buf[b..#count];
+      i += count;
+      b += count;
+    }
+  }
+}
+
 private proc _canDoSimpleBlockTransfer(A, aView, B, bView) {
   if debugBlockDistBulkTransfer then
     writeln("In BlockDist._canDoSimpleBlockTransfer");
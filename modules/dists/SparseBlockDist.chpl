@@ -168,8 +168,12 @@ class SparseBlockDom: BaseSparseDomImpl {
     }
     var _totalAdded: atomic int;
     coforall l in dist.targetLocDom do on dist.targetLocales[l] {
-      const _retval = locDoms[l].mySparseBlock.bulkAdd(inds[localeRanges[l]],
-          dataSorted=true, isUnique=false);
+      // Copy this locale's indices over in bulk so that the layout's bulkAdd
+      // does not access them remotely one at a time
+      const myRange = localeRanges[l];
+      var myInds: [0..#myRange.size] index(rank, idxType) = inds[myRange];
+      const _retval = locDoms[l].mySparseBlock.bulkAdd(myInds,
+          dataSorted=true, isUnique=false, preserveInds=false);
       _totalAdded.add(_retval);
     }
     const _retval = _totalAdded.read();
@@ -167,10 +167,6 @@ module ChapelArray {
   use ArrayViewRankChange;
   use ArrayViewReindex;
 
-  // Explicitly use a processor atomic, as most calls to this function are
-  // likely be on locale 0
-  pragma "no doc"
-  var numPrivateObjects: atomic_int64;
   pragma "no doc"
   param nullPid = -1;
 
@@ -214,19 +210,24 @@ module ChapelArray {
   //    relatively low overhead, adds work to Locale 0 that is not present on
   //    the other locales, and again would be surprising if a Block array were
   //    created over other locales only (say, Locales[2] and Locales[3]).
+  //    Locale 0's runtime hands out pids and recycles them once
+  //    _freePrivatizedClass() has cleared them everywhere.
 
   // Given a dsi Dist/Dom/Array, create an pid integer identifying the
   // privatized version on all locales; and populate each locale
   // with a privatized value that can be retrieved by the pid
   // without communication.
   proc _newPrivatizedClass(value) : int {
+    extern proc chpl_allocPrivatizedPid(): int;
 
-    const n = numPrivateObjects.fetchAdd(1);
+    var n: int;
 
     const hereID = here.id;
     const privatizeData = value.dsiGetPrivatizeData();
-    on Locales[0] do
+    on Locales[0] {
+      n = chpl_allocPrivatizedPid();
       _newPrivatizedClassHelp(value, value, n, hereID, privatizeData);
+    }
 
     proc _newPrivatizedClassHelp(parentValue, originalValue, n, hereID, privatizeData) {
       var newValue = originalValue;
@@ -259,7 +260,12 @@ module ChapelArray {
     if pid == nullPid then return;
 
     on Locales[0] {
+      extern proc chpl_freePrivatizedPid(pid:int);
+
       _freePrivatizedClassHelp(pid, original);
+
+      // Every locale has cleared it now, so the pid can be reused
+      chpl_freePrivatizedPid(pid);
     }
 
     proc _freePrivatizedClassHelp(pid, original) {
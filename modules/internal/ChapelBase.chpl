@@ -929,6 +929,11 @@ module ChapelBase {
   proc _downEndCount(e: _EndCount, err: Error) {
     // save the task error
     chpl_save_task_error(e, err);
+    // make this task's unordered network atomics visible before we finish
+    if CHPL_NETWORK_ATOMICS != "none" {
+      extern proc chpl_comm_atomic_unordered_task_fence();
+      chpl_comm_atomic_unordered_task_fence();
+    }
     // inform anybody waiting that we're done
     e.i.sub(1, memory_order_release);
   }
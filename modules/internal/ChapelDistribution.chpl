@@ -848,22 +848,14 @@ module ChapelDistribution {
     // oldnnz is the number of elements in the array. As the function is called
     // at the end of bulkAdd, it is almost certain that oldnnz!=data.size
     proc sparseBulkShiftArray(shiftMap, oldnnz){
-      var newIdx: int;
-      var prevNewIdx = 1;
+      // The old elements only move up, but they are read from a copy so
+      // that they can be moved in parallel
+      const oldData: [1..oldnnz] eltType = data[1..oldnnz];
 
-      // fill all new indices i s.t. i > indices[oldnnz]
-      forall i in shiftMap.domain.high+1..dom.nnzDom.high do data[i] = irv;
+      forall i in dom.nnzDom do data[i] = irv;
 
-      for (i, _newIdx) in zip(1..oldnnz by -1, shiftMap.domain.dim(1) by -1) {
-        newIdx = shiftMap[_newIdx];
-        data[newIdx] = data[i];
-
-        //fill IRV up to previously added nnz
-        for emptyIndex in newIdx+1..prevNewIdx-1 do data[emptyIndex] = irv;
-        prevNewIdx = newIdx;
-      }
-      //fill the initial added space with IRV
-      for i in 1..prevNewIdx-1 do data[i] = irv;
+      forall (i, newIdx) in zip(1..oldnnz, shiftMap) do
+        data[newIdx] = oldData[i];
     }
 
     // shift data array after single index addition. Fills the new index with irv
@@ -30,7 +30,31 @@ module ChapelReduce {
     delete op;
   }
 
-  iter chpl__scanIterator(op, data) {
+  //
+  // Scanning an array whose implementation provides doiScan() for 'op'
+  // is done in parallel and produces a new array.  Anything else is
+  // scanned serially, one element after another.
+  //
+  proc chpl__scanIsParallel(op, data) param {
+    use Reflection;
+    if isArray(data) then
+      return canResolveMethod(data._value, "doiScan", op, data.domain);
+    else
+      return false;
+  }
+
+  pragma "fn returns iterator"
+  proc chpl__scanIterator(op, data) {
+    if chpl__scanIsParallel(op, data) {
+      const res = data._value.doiScan(op, data.domain);
+      delete op;
+      return res;
+    } else {
+      return chpl__scanIteratorSerial(op, data);
+    }
+  }
+
+  iter chpl__scanIteratorSerial(op, data) {
     for e in data {
       op.accumulate(e);
       yield op.generate();
@@ -38,6 +62,18 @@ module ChapelReduce {
     delete op;
   }
 
+  //
+  // The parallel scans reduce each chunk of the data with a clone of
+  // the op and combine() those clones in order to find where each chunk
+  // starts, so the op needs clone(), and a result type that can go in
+  // an array.
+  //
+  proc chpl__scanParSupported(op) param {
+    use Reflection;
+    return canResolveMethod(op, "clone") &&
+           !isArray(op.generate());
+  }
+
   proc chpl__reduceCombine(globalOp, localOp) {
     on globalOp {
       globalOp.lock();
@@ -263,6 +299,10 @@ module ChapelReduce {
         value = x;
       uninitialized = false;
     }
+    proc accumulateOntoState(ref state, x) {
+      if (x(1) > state(1)) || ((x(1) == state(1)) && (x(2) < state(2))) then
+        state = x;
+    }
     proc combine(x) {
       if uninitialized || (x.value(1) > value(1)) ||
         ((x.value(1) == value(1)) && (x.value(2) < value(2))) {
@@ -288,6 +328,10 @@ module ChapelReduce {
         value = x;
       uninitialized = false;
     }
+    proc accumulateOntoState(ref state, x) {
+      if (x(1) < state(1)) || ((x(1) == state(1)) && (x(2) < state(2))) then
+        state = x;
+    }
     proc combine(x) {
       if uninitialized || (x.value(1) < value(1)) ||
         ((x.value(1) == value(1)) && (x.value(2) < value(2))) {
@@ -39,6 +39,24 @@ module DefaultAssociative {
     var idx: idxType;
   }
 
+  // Slot states as seen by concurrent (parSafe) operations.  These
+  // mirror chpl__hash_status, plus 'busy' for a slot that an add has
+  // claimed but not yet filled in.
+  private param chpl__slotEmpty   = 0:int(8),
+                chpl__slotFull    = 1:int(8),
+                chpl__slotDeleted = 2:int(8),
+                chpl__slotBusy    = 3:int(8);
+
+  // Number of key locks striped over a parSafe associative domain.
+  // Adds and removes of the same key are serialized by its key lock;
+  // operations on different keys proceed in parallel.
+  config param chpl__assocNumKeyLocks = 64;
+
+  // Tables with at least this many slots are rehashed in parallel
+  // when resized.  Smaller tables are rehashed serially, which keeps
+  // their iteration order deterministic.
+  config const chpl__assocParallelResizeThreshold = 1 << 16;
+
   proc chpl__primes return
   (23, 53, 89, 191, 383, 761, 1531, 3067, 6143, 12281, 24571, 49139, 98299,
    196597, 393209, 786431, 1572853, 3145721, 6291449, 12582893, 25165813,
@@ -63,18 +81,85 @@ module DefaultAssociative {
     // by design a distributed data structure
     var numEntries: atomic_int64;
     var tableLock: atomicbool; // do not access directly, use function below
+    var numActiveOps: atomic_int64; // ditto
     var tableSizeNum = 1;
     var tableSize = chpl__primes(tableSizeNum);
     var tableDom = {0..tableSize-1};
     var table: [tableDom] chpl_TableEntry(idxType);
-  
+
+    // For parSafe domains, the state of each slot (chpl__slotEmpty,
+    // etc.).  Slots are claimed by compare-exchange on this array and
+    // table[slot].status is kept in step with it for the serial paths.
+    // slotStateDom follows tableDom; it is empty for other domains.
+    var slotStateDom = {0..#(if parSafe then tableSize else 0)};
+    var slotState: [slotStateDom] atomic_int8;
+    var keyLocks: [0..#(if parSafe then chpl__assocNumKeyLocks else 0)] atomicbool;
+
+    //
+    // Adds, removes and lookups on a parSafe domain run concurrently
+    // between _enterOp() and _exitOp().  lockTable() excludes all of
+    // them; it is used to resize, clear or re-capacity the table.
+    //
     inline proc lockTable() {
       while tableLock.testAndSet() do chpl_task_yield();
+      while numActiveOps.read() != 0 do chpl_task_yield();
     }
   
     inline proc unlockTable() {
       tableLock.clear();
     }
+
+    inline proc _enterOp() {
+      while true {
+        while tableLock.read() do chpl_task_yield();
+        numActiveOps.add(1);
+        if !tableLock.read() then break;
+        numActiveOps.sub(1);
+      }
+    }
+
+    inline proc _exitOp() {
+      numActiveOps.sub(1);
+    }
+
+    inline proc _keyLockFor(idx: idxType) {
+      return chpl__defaultHashWrapper(idx) & (chpl__assocNumKeyLocks-1);
+    }
+
+    inline proc _lockKey(lockNum) {
+      while keyLocks[lockNum].testAndSet() do chpl_task_yield();
+    }
+
+    inline proc _unlockKey(lockNum) {
+      keyLocks[lockNum].clear();
+    }
+
+    // Read a slot's status; in a parSafe domain a busy slot reads as
+    // deleted, i.e. it holds no index that a lookup can match.
+    inline proc _slotStatus(slot) {
+      if parSafe {
+        select slotState[slot].read() {
+          when chpl__slotEmpty do return chpl__hash_status.empty;
+          when chpl__slotFull do return chpl__hash_status.full;
+          otherwise do return chpl__hash_status.deleted;
+        }
+      }
+      return table[slot].status;
+    }
+
+    inline proc _setSlotStatus(slot, status: chpl__hash_status) {
+      table[slot].status = status;
+      if parSafe {
+        select status {
+          when chpl__hash_status.empty do
+            slotState[slot].write(chpl__slotEmpty);
+          when chpl__hash_status.full do
+            slotState[slot].write(chpl__slotFull);
+          when chpl__hash_status.deleted do
+            slotState[slot].write(chpl__slotDeleted);
+        }
+      }
+    }
   
     // TODO: An ugly [0..-1] domain appears several times in the code --
     //       replace with a named constant/param?
@@ -89,6 +174,9 @@ module DefaultAssociative {
       if !chpl__validDefaultAssocDomIdxType(idxType) then
         compilerError("Default Associative domains with idxType=",
                       idxType:string, " are not allowed", 2);
+      if parSafe && (chpl__assocNumKeyLocks <= 0 ||
+                     (chpl__assocNumKeyLocks & (chpl__assocNumKeyLocks-1)) != 0) then
+        compilerError("chpl__assocNumKeyLocks must be a power of 2");
       this.dist = dist;
     }
   
@@ -273,8 +361,8 @@ module DefaultAssociative {
     proc dsiClear() {
       on this {
         if parSafe then lockTable();
-        for slot in tableDom {
-          table[slot].status = chpl__hash_status.empty;
+        forall slot in tableDom {
+          _setSlotStatus(slot, chpl__hash_status.empty);
         }
         numEntries.write(0);
         if parSafe then unlockTable();
@@ -310,21 +398,119 @@ module DefaultAssociative {
       var retVal = 0;
       on this {
         const shouldLock = needLock && parSafe;
-        if shouldLock then lockTable();
-        var findAgain = shouldLock;
-        if ((numEntries.read()+1)*2 > tableSize) {
-          _resize(grow=true);
-          findAgain = true;
+        if shouldLock {
+          (slotNum, retVal) = _addConcurrent(idx);
+        } else {
+          var findAgain = false;
+          if ((numEntries.read()+1)*2 > tableSize) {
+            _resize(grow=true);
+            findAgain = true;
+          }
+          if findAgain then
+            (slotNum, retVal) = _add(idx, -1);
+          else
+            (_, retVal) = _add(idx, inSlot);
         }
-        if findAgain then
-          (slotNum, retVal) = _add(idx, -1);
-        else
-          (_, retVal) = _add(idx, inSlot);
-        if shouldLock then unlockTable();
       }
       return (slotNum, retVal);
     }
 
+    // Add 'idx' to a parSafe domain without excluding other operations.
+    //
+    // The caller's key lock keeps two adds of the same index from
+    // both succeeding.  Adds of different indices can only collide on
+    // an empty slot, and whichever claims it first (by compare-exchange
+    // on slotState) keeps it; the other moves on down its probe
+    // sequence.  As in the serial _add, the index goes in the first
+    // empty or deleted slot on its probe sequence.
+    //
+    // A deleted slot still holds its old index, which a concurrent
+    // lookup may be reading, so it is only reused with the table
+    // locked.  The index in a slot therefore never changes while
+    // other operations are in flight.
+    //
+    proc _addConcurrent(idx: idxType) : (index(tableDom), int) {
+      const lockNum = _keyLockFor(idx);
+      while true {
+        _enterOp();
+        if (numEntries.read()+1)*2 > tableSize {
+          _exitOp();
+          _growIfNeeded(force=false);
+          continue;
+        }
+
+        _lockKey(lockNum);
+
+        const (found, foundSlot) = _findFilledSlot(idx, needLock=false);
+        if found {
+          _unlockKey(lockNum);
+          _exitOp();
+          return (foundSlot, 0);
+        }
+
+        var slotNum = -1,
+            reuseDeleted = false;
+        for probe in _lookForSlots(idx) {
+          const state = slotState[probe].read();
+          if state == chpl__slotDeleted {
+            reuseDeleted = true;
+            break;
+          }
+          if state == chpl__slotEmpty &&
+             slotState[probe].compareExchange(chpl__slotEmpty, chpl__slotBusy) {
+            slotNum = probe;
+            break;
+          }
+        }
+
+        if reuseDeleted {
+          _unlockKey(lockNum);
+          _exitOp();
+          lockTable();
+          if (numEntries.read()+1)*2 > tableSize then
+            _resize(grow=true);
+          var retVal: (index(tableDom), int);
+          const (found, foundSlot) = _findFilledSlot(idx, needLock=false);
+          if found then
+            retVal = (foundSlot, 0);
+          else
+            retVal = _add(idx);
+          unlockTable();
+          return retVal;
+        }
+
+        if slotNum == -1 {
+          // Other adds filled the probe sequence since we checked the
+          // load factor; grow and try again.
+          _unlockKey(lockNum);
+          _exitOp();
+          _growIfNeeded(force=true);
+          continue;
+        }
+
+        table[slotNum].idx = idx;
+        _setSlotStatus(slotNum, chpl__hash_status.full);
+        numEntries.add(1);
+
+        // default initialize newly added array elements
+        for a in _arrs do
+          a.clearEntry(idx);
+
+        _unlockKey(lockNum);
+        _exitOp();
+        return (slotNum, 1);
+      }
+      halt("unreachable");
+      return (-1, 0);
+    }
+
+    proc _growIfNeeded(force: bool) {
+      lockTable();
+      if force || (numEntries.read()+1)*2 > tableSize then
+        _resize(grow=true);
+      unlockTable();
+    }
+
     // This routine adds new indices without checking the table size and
     //  is thus appropriate for use by routines like _resize().
     //
@@ -335,8 +521,8 @@ module DefaultAssociative {
       if !foundSlot then
         (foundSlot, slotNum) = _findEmptySlot(idx);
       if foundSlot {
-        table[slotNum].status = chpl__hash_status.full;
         table[slotNum].idx = idx;
+        _setSlotStatus(slotNum, chpl__hash_status.full);
         numEntries.add(1);
 
         // default initialize newly added array elements
@@ -356,20 +542,32 @@ module DefaultAssociative {
     proc dsiRemove(idx: idxType) {
       var retval = 1;
       on this {
-        if parSafe then lockTable();
-        const (foundSlot, slotNum) = _findFilledSlot(idx, needLock=!parSafe);
+        var lockNum = 0;
+        if parSafe {
+          _enterOp();
+          lockNum = _keyLockFor(idx);
+          _lockKey(lockNum);
+        }
+        const (foundSlot, slotNum) = _findFilledSlot(idx, needLock=false);
         if (foundSlot) {
           for a in _arrs do
             a.clearEntry(idx);
-          table[slotNum].status = chpl__hash_status.deleted;
+          _setSlotStatus(slotNum, chpl__hash_status.deleted);
           numEntries.sub(1);
         } else {
           retval = 0;
         }
+        if parSafe {
+          _unlockKey(lockNum);
+          _exitOp();
+        }
         if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
-          _resize(grow=false);
+          if parSafe then lockTable();
+          if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
+            _resize(grow=false);
+          }
+          if parSafe then unlockTable();
         }
-        if parSafe then unlockTable();
       }
       return retval;
     }
@@ -404,36 +602,17 @@ module DefaultAssociative {
 
         //Changing underlying structure, time for locking
         if parSafe then lockTable();
+        // Re-check now that no adds are in flight.
+        entries = numEntries.read();
         if entries > 0 {
           // Slow path: back up required
-          _backupArrays();
-
-          // copy the table (TODO: could use swap between two versions)
-          var copyDom = tableDom;
-          var copyTable: [copyDom] chpl_TableEntry(idxType) = table;
-
-          // Do not preserve entries
-          tableDom = {0..-1};
-
-          tableSizeNum = primeLoc;
-          tableSize = prime;
-          tableDom = {0..tableSize-1};
-
-          //numEntries will be reconstructed as keys are readded
-          numEntries.write(0);
-
-          // insert old data into newly resized table
-          for slot in _fullSlots(copyTable) {
-            const (newslot, _) = _add(copyTable[slot].idx);
-            _preserveArrayElements(oldslot=slot, newslot=newslot);
-          }
-            
-          _removeArrayBackups();
+          _rehash(primeLoc);
         } else {
           //Fast path, nothing to backup
           tableSizeNum=primeLoc;
           tableSize=prime;
           tableDom = {0..tableSize-1};
+          if parSafe then slotStateDom = tableDom;
         }
 
         //Unlock the table
@@ -464,6 +643,17 @@ module DefaultAssociative {
     //
     proc _resize(grow:bool) {
       if postponeResize then return;
+      const newSizeNum = tableSizeNum + (if grow then 1 else -1);
+      if newSizeNum > chpl__primes.size then halt("associative array exceeds maximum size");
+      _rehash(newSizeNum);
+    }
+
+    // Move every index (and the corresponding array elements) into a
+    // fresh table of size chpl__primes(newSizeNum).
+    //
+    // NOTE: Calls to this routine assume that the tableLock has been acquired.
+    //
+    proc _rehash(newSizeNum: int) {
       // back up the arrays
       _backupArrays();
   
@@ -473,46 +663,81 @@ module DefaultAssociative {
   
       // grow original table
       tableDom = {0..(-1:chpl_table_index_type)}; // non-preserving resize
+      if parSafe then slotStateDom = tableDom;
       numEntries.write(0); // reset, because the adds below will re-set this
-      tableSizeNum += if grow then 1 else -1;
-      if tableSizeNum > chpl__primes.size then halt("associative array exceeds maximum size");
+      tableSizeNum = newSizeNum;
       tableSize = chpl__primes(tableSizeNum);
       tableDom = {0..tableSize-1};
+      if parSafe then slotStateDom = tableDom;
   
       // insert old data into newly resized table
-      for slot in _fullSlots(copyTable) {
-        const (newslot, _) = _add(copyTable[slot].idx);
-        _preserveArrayElements(oldslot=slot, newslot=newslot);
+      if parSafe && copyDom.size >= chpl__assocParallelResizeThreshold {
+        // Every index is distinct, so the tasks only need to agree on
+        // who gets each slot.  Which one wins a slot varies from run
+        // to run, and so does the iteration order afterwards.
+        forall slot in copyDom {
+          if copyTable[slot].status == chpl__hash_status.full {
+            const newslot = _addDistinct(copyTable[slot].idx);
+            _preserveArrayElements(oldslot=slot, newslot=newslot);
+          }
+        }
+      } else {
+        for slot in _fullSlots(copyTable) {
+          const (newslot, _) = _add(copyTable[slot].idx);
+          _preserveArrayElements(oldslot=slot, newslot=newslot);
+        }
       }
       
       _removeArrayBackups();
     }
 
+    // Add an index known not to be in the table, in parallel with
+    // other such adds.  Only used to rehash into a table that has no
+    // deleted slots.
+    proc _addDistinct(idx: idxType): index(tableDom) {
+      for slotNum in _lookForSlots(idx) {
+        if slotState[slotNum].compareExchange(chpl__slotEmpty, chpl__slotBusy) {
+          table[slotNum].idx = idx;
+          table[slotNum].status = chpl__hash_status.full;
+          slotState[slotNum].write(chpl__slotFull);
+          numEntries.add(1);
+          return slotNum;
+        }
+      }
+      halt("couldn't add ", idx, " -- ", numEntries.read(), " / ", tableSize, " taken");
+      return -1;
+    }
+
     // Searches for 'idx' in a filled slot.
     //
     // Returns true if found, along with the first open slot that may be
     // re-used for faster addition to the domain
+    //
+    // In a parSafe domain this runs alongside adds and removes.  It is
+    // safe to read the index in a full slot because no add writes
+    // into a slot that has been full since the table was last locked
+    // (see _addConcurrent).
     proc _findFilledSlot(idx: idxType, needLock = true) : (bool, index(tableDom)) {
-      if parSafe && needLock then lockTable();
+      if parSafe && needLock then _enterOp();
       var firstOpen = -1;
       for slotNum in _lookForSlots(idx, table.domain.high+1) {
-        const slotStatus = table[slotNum].status;
+        const slotStatus = _slotStatus(slotNum);
         // if we encounter a slot that's empty, our element could not
         // be found past this point.
         if (slotStatus == chpl__hash_status.empty) {
           if firstOpen == -1 then firstOpen = slotNum;
-          if parSafe && needLock then unlockTable();
+          if parSafe && needLock then _exitOp();
           return (false, firstOpen);
         } else if (slotStatus == chpl__hash_status.full) {
           if (table[slotNum].idx == idx) {
-            if parSafe && needLock then unlockTable();
+            if parSafe && needLock then _exitOp();
             return (true, slotNum);
           }
         } else { // this entry was removed, but is the first slot we could use
           if firstOpen == -1 then firstOpen = slotNum;
         }
       }
-      if parSafe && needLock then unlockTable();
+      if parSafe && needLock then _exitOp();
       return (false, -1);
     }
 
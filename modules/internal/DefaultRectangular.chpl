@@ -1959,6 +1959,106 @@ module DefaultRectangular {
 
   proc DefaultRectangularArr.isDefaultRectangular() param return true;
 
+  //
+  // Parallel scan of a 1D array.  chpl__preScan() splits the indices
+  // into chunks and reduces each one with its own clone of the op, a
+  // task per chunk.  chpl__postScan() combines those ops in order to
+  // get the state at the start of each chunk, then scans each chunk
+  // into the result from there, again a task per chunk.  Like a
+  // reduction, this only uses the op's clone(), accumulate(), combine()
+  // and generate().  Distributions call the two on their local arrays,
+  // with an op holding everything on the locales before.
+  //
+  proc DefaultRectangularArr.doiScan(op, dom) where rank == 1 &&
+                                                  !stridable &&
+                                                  chpl__scanParSupported(op) {
+    type resType = op.generate().type;
+    var res: [dom] resType;
+    const inds = dom.dim(1);
+
+    const chunks = chpl__preScan(op, inds);
+    const noBefore: op.type = nil;
+    chpl__postScan(op, res._value, inds, chunks, noBefore);
+
+    return res;
+  }
+
+  //
+  // The ops that chpl__preScan() reduced the chunks of a scan with,
+  // in order.
+  //
+  class chpl__ScanChunks {
+    type opType;
+    const numChunks: int;
+    var ops: [0..#numChunks] opType;
+
+    // Return a new op holding all of the chunks
+    proc total(op) {
+      const res = op.clone();
+      for chunkOp in ops do
+        res.combine(chunkOp);
+      return res;
+    }
+  }
+
+  //
+  // Reduce each chunk of 'inds' in this array with a clone of 'op'.
+  // The result must be passed on to chpl__postScan().
+  //
+  proc DefaultRectangularArr.chpl__preScan(op, inds: range(idxType)) {
+    const numChunks = if __primitive("task_get_serial") then
+                      min(1, inds.length) else _computeNumChunks(inds.length);
+    const chunks = new chpl__ScanChunks(op.type, numChunks);
+
+    coforall chunk in 0..#numChunks {
+      const (lo, hi) = _computeBlock(inds.length, numChunks, chunk,
+                                     inds.high, inds.low, inds.low);
+      const myOp = op.clone();
+      for i in lo..hi do
+        myOp.accumulate(dsiAccess(i));
+      chunks.ops[chunk] = myOp;
+    }
+
+    return chunks;
+  }
+
+  //
+  // Finish a scan started by chpl__preScan(), writing it into the same
+  // indices of 'res', a DefaultRectangularArr.  If 'before' is not nil,
+  // it holds everything scanned before 'inds'.  Deletes 'chunks'.
+  //
+  proc DefaultRectangularArr.chpl__postScan(op, res, inds: range(idxType),
+                                            chunks, before) {
+    const numChunks = chunks.numChunks;
+    var startOps: [0..#numChunks] op.type;
+
+    for chunk in 0..#numChunks {
+      startOps[chunk] = op.clone();
+      if chunk > 0 {
+        startOps[chunk].combine(startOps[chunk-1]);
+        startOps[chunk].combine(chunks.ops[chunk-1]);
+      } else if before != nil {
+        startOps[chunk].combine(before);
+      }
+    }
+
+    coforall chunk in 0..#numChunks {
+      const (lo, hi) = _computeBlock(inds.length, numChunks, chunk,
+                                     inds.high, inds.low, inds.low);
+      const myOp = startOps[chunk];
+      for i in lo..hi {
+        myOp.accumulate(dsiAccess(i));
+        res.dsiAccess(i) = myOp.generate();
+      }
+    }
+
+    for chunk in 0..#numChunks {
+      delete startOps[chunk];
+      delete chunks.ops[chunk];
+    }
+    delete chunks;
+  }
+
   /*
   The runtime implementation's loop over the current stride level will look
   something like this:
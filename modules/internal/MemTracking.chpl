@@ -30,7 +30,8 @@ module MemTracking
     memLeaks: bool = false,
     memMax: uint = 0,
     memThreshold: uint = 0,
-    memLog: string;
+    memLog: string,
+    memSample: uint = 0;
 
   pragma "no auto destroy"
   config const
@@ -55,7 +56,8 @@ module MemTracking
 
   // Safely cast to size_t instances of memMax and memThreshold.
   const cMemMax = memMax.safeCast(size_t),
-    cMemThreshold = memThreshold.safeCast(size_t);
+    cMemThreshold = memThreshold.safeCast(size_t),
+    cMemSample = memSample.safeCast(size_t);
 
   //
   // This communicates the settings of the various memory tracking
@@ -78,13 +80,15 @@ module MemTracking
                                          ref ret_memMax: size_t,
                                          ref ret_memThreshold: size_t,
                                          ref ret_memLog: c_string,
-                                         ref ret_memLeaksLog: c_string) {
+                                         ref ret_memLeaksLog: c_string,
+                                         ref ret_memSample: size_t) {
     ret_memTrack = memTrack;
     ret_memStats = memStats;
     ret_memLeaksByType = memLeaksByType;
     ret_memLeaks = memLeaks;
     ret_memMax = cMemMax;
     ret_memThreshold = cMemThreshold;
+    ret_memSample = cMemSample;
 
     if (here.id != 0) {
       if memLeaksByDesc.length != 0 {
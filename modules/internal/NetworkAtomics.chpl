@@ -72,6 +72,21 @@ module NetworkAtomics {
                                              ref desired:int(64),
                                              l:int(32), ref obj:int(64),
                                              ref result:bool(32));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_add_unordered_int64(ref op:int(64),
+                                                   l:int(32), ref obj:int(64));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_sub_unordered_int64(ref op:int(64),
+                                                   l:int(32), ref obj:int(64));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_and_unordered_int64(ref op:int(64),
+                                                   l:int(32), ref obj:int(64));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_or_unordered_int64(ref op:int(64),
+                                                  l:int(32), ref obj:int(64));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_xor_unordered_int64(ref op:int(64),
+                                                   l:int(32), ref obj:int(64));
 
   // int(64)
   pragma "atomic type"
@@ -165,6 +180,31 @@ module NetworkAtomics {
       chpl_comm_atomic_xor_int64(v, this.locale.id:int(32), this._v);
     }
 
+    inline proc unorderedAdd(value:int(64)) {
+      var v = value;
+      chpl_comm_atomic_add_unordered_int64(v, this.locale.id:int(32), this._v);
+    }
+
+    inline proc unorderedSub(value:int(64)) {
+      var v = value;
+      chpl_comm_atomic_sub_unordered_int64(v, this.locale.id:int(32), this._v);
+    }
+
+    inline proc unorderedAnd(value:int(64)) {
+      var v = value;
+      chpl_comm_atomic_and_unordered_int64(v, this.locale.id:int(32), this._v);
+    }
+
+    inline proc unorderedOr(value:int(64)) {
+      var v = value;
+      chpl_comm_atomic_or_unordered_int64(v, this.locale.id:int(32), this._v);
+    }
+
+    inline proc unorderedXor(value:int(64)) {
+      var v = value;
+      chpl_comm_atomic_xor_unordered_int64(v, this.locale.id:int(32), this._v);
+    }
+
     inline proc const waitFor(val:int(64), order:memory_order = memory_order_seq_cst) {
       on this {
         while (read(memory_order_relaxed) != val) do chpl_task_yield();
@@ -266,6 +306,21 @@ module NetworkAtomics {
                                              ref desired:int(32),
                                              l:int(32), ref obj:int(32),
                                              ref result:bool(32));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_add_unordered_int32(ref op:int(32),
+                                                   l:int(32), ref obj:int(32));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_sub_unordered_int32(ref op:int(32),
+                                                   l:int(32), ref obj:int(32));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_and_unordered_int32(ref op:int(32),
+                                                   l:int(32), ref obj:int(32));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_or_unordered_int32(ref op:int(32),
+                                                  l:int(32), ref obj:int(32));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_xor_unordered_int32(ref op:int(32),
+                                                   l:int(32), ref obj:int(32));
 
   // int32
   pragma "atomic type"
@@ -359,6 +414,31 @@ module NetworkAtomics {
       chpl_comm_atomic_xor_int32(v, this.locale.id:int(32), this._v);
     }
 
+    inline proc unorderedAdd(value:int(32)) {
+      var v = value;
+      chpl_comm_atomic_add_unordered_int32(v, this.locale.id:int(32), this._v);
+    }
+
+    inline proc unorderedSub(value:int(32)) {
+      var v = value;
+      chpl_comm_atomic_sub_unordered_int32(v, this.locale.id:int(32), this._v);
+    }
+
+    inline proc unorderedAnd(value:int(32)) {
+      var v = value;
+      chpl_comm_atomic_and_unordered_int32(v, this.locale.id:int(32), this._v);
+    }
+
+    inline proc unorderedOr(value:int(32)) {
+      var v = value;
+      chpl_comm_atomic_or_unordered_int32(v, this.locale.id:int(32), this._v);
+    }
+
+    inline proc unorderedXor(value:int(32)) {
+      var v = value;
+      chpl_comm_atomic_xor_unordered_int32(v, this.locale.id:int(32), this._v);
+    }
+
     inline proc const waitFor(val:int(32), order:memory_order = memory_order_seq_cst) {
       on this {
         while (read(memory_order_relaxed) != val) do chpl_task_yield();
@@ -457,6 +537,21 @@ module NetworkAtomics {
                                              ref desired:uint(64),
                                              l:int(32), ref obj:uint(64),
                                              ref result:bool(32));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_add_unordered_uint64(ref op:uint(64),
+                                                    l:int(32), ref obj:uint(64));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_sub_unordered_uint64(ref op:uint(64),
+                                                    l:int(32), ref obj:uint(64));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_and_unordered_uint64(ref op:uint(64),
+                                                    l:int(32), ref obj:uint(64));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_or_unordered_uint64(ref op:uint(64),
+                                                   l:int(32), ref obj:uint(64));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_xor_unordered_uint64(ref op:uint(64),
+                                                    l:int(32), ref obj:uint(64));
 
   // uint(64)
   pragma "atomic type"
@@ -550,6 +645,31 @@ module NetworkAtomics {
       chpl_comm_atomic_xor_uint64(v, this.locale.id:int(32), this._v);
     }
 
+    inline proc unorderedAdd(value:uint(64)) {
+      var v = value;
+      chpl_comm_atomic_add_unordered_uint64(v, this.locale.id:int(32), this._v);
+    }
+
+    inline proc unorderedSub(value:uint(64)) {
+      var v = value;
+      chpl_comm_atomic_sub_unordered_uint64(v, this.locale.id:int(32), this._v);
+    }
+
+    inline proc unorderedAnd(value:uint(64)) {
+      var v = value;
+      chpl_comm_atomic_and_unordered_uint64(v, this.locale.id:int(32), this._v);
+    }
+
+    inline proc unorderedOr(value:uint(64)) {
+      var v = value;
+      chpl_comm_atomic_or_unordered_uint64(v, this.locale.id:int(32), this._v);
+    }
+
+    inline proc unorderedXor(value:uint(64)) {
+      var v = value;
+      chpl_comm_atomic_xor_unordered_uint64(v, this.locale.id:int(32), this._v);
+    }
+
     inline proc const waitFor(val:uint(64), order:memory_order = memory_order_seq_cst) {
       on this {
         while (read(memory_order_relaxed) != val) do chpl_task_yield();
@@ -648,6 +768,21 @@ module NetworkAtomics {
                                              ref desired:uint(32),
                                              l:int(32), ref obj:uint(32),
                                              ref result:bool(32));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_add_unordered_uint32(ref op:uint(32),
+                                                    l:int(32), ref obj:uint(32));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_sub_unordered_uint32(ref op:uint(32),
+                                                    l:int(32), ref obj:uint(32));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_and_unordered_uint32(ref op:uint(32),
+                                                    l:int(32), ref obj:uint(32));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_or_unordered_uint32(ref op:uint(32),
+                                                   l:int(32), ref obj:uint(32));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_xor_unordered_uint32(ref op:uint(32),
+                                                    l:int(32), ref obj:uint(32));
 
   // uint(32)
   pragma "atomic type"
@@ -741,6 +876,31 @@ module NetworkAtomics {
       chpl_comm_atomic_xor_uint32(v, this.locale.id:int(32), this._v);
     }
 
+    inline proc unorderedAdd(value:uint(32)) {
+      var v = value;
+      chpl_comm_atomic_add_unordered_uint32(v, this.locale.id:int(32), this._v);
+    }
+
+    inline proc unorderedSub(value:uint(32)) {
+      var v = value;
+      chpl_comm_atomic_sub_unordered_uint32(v, this.locale.id:int(32), this._v);
+    }
+
+    inline proc unorderedAnd(value:uint(32)) {
+      var v = value;
+      chpl_comm_atomic_and_unordered_uint32(v, this.locale.id:int(32), this._v);
+    }
+
+    inline proc unorderedOr(value:uint(32)) {
+      var v = value;
+      chpl_comm_atomic_or_unordered_uint32(v, this.locale.id:int(32), this._v);
+    }
+
+    inline proc unorderedXor(value:uint(32)) {
+      var v = value;
+      chpl_comm_atomic_xor_unordered_uint32(v, this.locale.id:int(32), this._v);
+    }
+
     inline proc const waitFor(val:uint(32), order:memory_order = memory_order_seq_cst) {
       on this {
         while (read(memory_order_relaxed) != val) do chpl_task_yield();
@@ -909,6 +1069,12 @@ inline proc compareExchangeWeak(expected:bool, desired:bool,
                                               ref desired:real(64),
                                               l:int(32), ref obj:real(64),
                                               ref result:bool(32));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_add_unordered_real64(ref op:real(64),
+                                                    l:int(32), ref obj:real(64));
+  pragma "insert line file info"
+  extern proc chpl_comm_atomic_sub_unordered_real64(ref op:real(64),
+                                                    l:int(32), ref obj:real(64));
   
   pragma "atomic type"
   record ratomic_real64 {
@@ -990,6 +1156,16 @@ inline proc compareExchangeWeak(expected:bool, desired:bool,
     }
 
 
+    inline proc unorderedAdd(value:real(64)) {
+      var v = value;
+      chpl_comm_atomic_add_unordered_real64(v, this.locale.id:int(32), this._v);
+    }
+
+    inline proc unorderedSub(value:real(64)) {
+      var v = value;
+      chpl_comm_atomic_sub_unordered_real64(v, this.locale.id:int(32), this._v);
+    }
+
     inline proc const waitFor(val:real(64), order:memory_order = memory_order_seq_cst) {
       on this {
         while (read(memory_order_relaxed) != val) do chpl_task_yield();
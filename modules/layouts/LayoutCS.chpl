@@ -32,6 +32,33 @@ record _ColumnComparator {
 pragma "no doc"
 const _columnComparator: _ColumnComparator;
 
+pragma "no doc"
+/* Sort A[lo..hi], which is often short or sorted already */
+proc _csSortRun(A: [] ?t, lo: int, hi: int) {
+  var sorted = true;
+  for p in lo+1..hi {
+    if A[p] < A[p-1] {
+      sorted = false;
+      break;
+    }
+  }
+  if sorted then return;
+
+  if hi - lo < 16 {
+    for p in lo+1..hi {
+      const x = A[p];
+      var q = p;
+      while q > lo && x < A[q-1] {
+        A[q] = A[q-1];
+        q -= 1;
+      }
+      A[q] = x;
+    }
+  } else {
+    Sort.quickSort(A[lo..hi]);
+  }
+}
+
 
 //
 // Necessary since `t == CS` does not support classes with param fields
@@ -338,143 +365,186 @@ class CSDom: BaseSparseDomImpl {
     return 1;
   }
 
+  // bulkAdd_help does not modify 'inds', so they don't need to be copied
+  proc dsiBulkAdd(inds: [] index(rank, idxType),
+      dataSorted=false, isUnique=false, preserveInds=true){
+    return bulkAdd_help(inds, dataSorted, isUnique);
+  }
+
+  // The row (column for CSC) and the position within it of an index
+  inline proc _major(ind: rank*idxType) {
+    return if this.compressRows then ind(1) else ind(2);
+  }
+  inline proc _minor(ind: rank*idxType) {
+    return if this.compressRows then ind(2) else ind(1);
+  }
+
+  // Bulk addition works on all rows (columns for CSC) in parallel:
+  // 1) The new indices are bucketed by row into 'newMinor'.  Indices that
+  //    are sorted by row already are in their buckets.
+  // 2) Each bucket is sorted and its duplicates and the indices that are
+  //    already in the domain are dropped.
+  // 3) The new row starts are a prefix sum of the new row lengths.
+  // 4) The old and new indices of each row are merged into 'idx'.
   proc bulkAdd_help(inds: [?indsDom] rank*idxType, dataSorted=false,
                     isUnique=false) {
-
-    if this.compressRows then
-      bulkAdd_prepareInds(inds, dataSorted, isUnique, cmp=Sort.defaultComparator);
-    else {
-      bulkAdd_prepareInds(inds, dataSorted, isUnique, cmp=_columnComparator);
+    if boundsChecking {
+      if dataSorted {
+        const sorted = if this.compressRows
+                       then Sort.isSorted(inds, comparator=Sort.defaultComparator)
+                       else Sort.isSorted(inds, comparator=_columnComparator);
+        if !sorted then
+          halt("bulkAdd: Data not sorted, call the function with \
+              dataSorted=false");
+      }
+      forall i in inds do boundsCheck(i);
     }
 
-    if nnz == 0 {
-
-      const dupCount = if isUnique then 0 else _countDuplicates(inds);
-
-      nnz += inds.size-dupCount;
-      _bulkGrow();
-
-      var idxIdx = 1;
-      var prevIdx = parentDom.low - (1,1);
-      var current: idxType;
-
-      if this.compressRows then
-        current = parentDom.dim(1).low;
-      else
-        current = parentDom.dim(2).low;
-
-      // Update startIdx && idx
-      for (i,j) in inds {
-        if !isUnique && (i,j) == prevIdx then continue;
-        else prevIdx = (i,j);
+    const n = inds.size;
+    if n == 0 then return 0;
+    const indsRange = indsDom.dim(1);
+
+    const rows = startIdxDom.low..startIdxDom.high-1;
+    var rowCounts: [rows] int;
+    var newMinor: [0..#n] idxType;
+
+    // 1) Bucket the new indices
+    var byRow = dataSorted;
+    if byRow then
+      byRow = && reduce [p in 1..n-1]
+        _major(inds[indsRange.orderToIndex(p-1)]) <= _major(inds[indsRange.orderToIndex(p)]);
+
+    // Buckets are runs of positions; rowOff[r] is set to the end of r's
+    // run if it has one
+    var rowOff: [rows] int;
+
+    const majorRange = if this.compressRows then rowRange else colRange,
+          minorRange = if this.compressRows then colRange else rowRange,
+          numMajor = (majorRange.high - majorRange.low + 1):uint(64),
+          numMinor = (minorRange.high - minorRange.low + 1):uint(64);
+
+    if byRow {
+      forall p in 0..#n {
+        const ind = inds[indsRange.orderToIndex(p)],
+              r = _major(ind);
+        newMinor[p] = _minor(ind);
+        if p == n-1 || _major(inds[indsRange.orderToIndex(p+1)]) != r then
+          rowOff[r] = p + 1;
+      }
+    } else if numMajor <= max(uint(64)) / numMinor {
+      // Sort the indices as integer keys, which is much faster than
+      // scattering them into buckets at random
+      var keys: [0..#n] uint(64);
+      forall (k, ind) in zip(keys, inds) do
+        k = (_major(ind) - majorRange.low):uint(64) * numMinor +
+            (_minor(ind) - minorRange.low):uint(64);
+      Sort.sort(keys);
+
+      forall p in 0..#n {
+        const r = keys[p] / numMinor;
+        newMinor[p] = minorRange.low + (keys[p] % numMinor):idxType;
+        if p == n-1 || keys[p+1] / numMinor != r then
+          rowOff[majorRange.low + r:idxType] = p + 1;
+      }
+      byRow = true;
+    } else {
+      var cursors: [rows] atomic int;
+      forall ind in inds do
+        cursors[_major(ind)].add(1);
+      forall (c, a) in zip(rowCounts, cursors) do
+        c = a.read();
+      const bucketEnds = + scan rowCounts;
+      forall (r, c) in zip(rows, cursors) do
+        c.write(bucketEnds[r] - rowCounts[r]);
+      forall ind in inds do
+        newMinor[cursors[_major(ind)].fetchAdd(1)] = _minor(ind);
+    }
 
-        if this.compressRows {
-          while i != current {
-            current += 1;
-            startIdx[current+1] = startIdx[current];
-          }
-          startIdx[i+1] += 1;
-          idx[idxIdx] = j;
-          idxIdx += 1;
-        } else {
-          while j != current {
-            current += 1;
-            startIdx[current+1] = startIdx[current];
+    if byRow {
+      // Rows without indices end where the previous row does
+      const runEnds = max scan rowOff;
+      forall r in rows do
+        rowCounts[r] = runEnds[r] - (if r == rows.low then 0 else runEnds[r-1]);
+    }
+    const ends = + scan rowCounts;
+    forall r in rows do
+      rowOff[r] = ends[r] - rowCounts[r];
+
+    // 2) Sort each bucket and keep only the indices to add at its front
+    var added: [rows] int;
+    forall r in rows {
+      const lo = rowOff[r],
+            hi = lo + rowCounts[r] - 1;
+      if lo <= hi {
+        _csSortRun(newMinor, lo, hi);
+
+        var oldPos = startIdx[r];
+        const oldEnd = startIdx[r+1];
+        var kept = 0;
+        var prev = newMinor[lo];
+        for p in lo..hi {
+          const m = newMinor[p];
+          if p > lo && m == prev {
+            if boundsChecking && isUnique then
+              halt("bulkAdd: There are duplicates, call the function \
+                  with isUnique=false");
+            continue;
           }
-          startIdx[j+1] += 1;
-          idx[idxIdx] = i;
-          idxIdx += 1;
+          prev = m;
+          while oldPos < oldEnd && idx[oldPos] < m do oldPos += 1;
+          if oldPos < oldEnd && idx[oldPos] == m then continue;
+          newMinor[lo+kept] = m;
+          kept += 1;
         }
+        added[r] = kept;
       }
+    }
 
-
-      // make sure startIdx[i]>startIdx[j] for i>j for possibly
-      // untouched part of startIdx
-      const startIdxHigh = startIdx[current+1];
-      for r in current+2..startIdx.domain.high {
-        startIdx[r] = startIdxHigh;
-      }
-
-      return idxIdx-1;
-    } // if nnz == 0
-
-    const (actualInsertPts, actualAddCnt) =
-      __getActualInsertPts(this, inds, isUnique);
+    // 3) New row starts
+    var newRowLen: [rows] int;
+    forall r in rows do
+      newRowLen[r] = (startIdx[r+1] - startIdx[r]):int + added[r];
+    const newEnds = + scan newRowLen;
 
     const oldnnz = nnz;
-    nnz += actualAddCnt;
+    const actualAddCnt = newEnds[rows.high] - oldnnz;
+    if actualAddCnt == 0 then return 0;
 
-    // Grow nnzDom if necessary
+    nnz += actualAddCnt;
     _bulkGrow();
 
-    // Linearly fill the new idx from backwards
-    var newIndIdx = indsDom.high; //index into new indices
-    var oldIndIdx = oldnnz; //index into old indices
-    var newLoc = actualInsertPts[newIndIdx]; // its position-to-be in new dom
-    while newLoc == -1 {
-      newIndIdx -= 1;
-      if newIndIdx == indsDom.low-1 then break; // there were duplicates -- now done
-      newLoc = actualInsertPts[newIndIdx];
-    }
-
-    var arrShiftMap: [{1..oldnnz}] int; //to map where data goes
-
-    for i in 1..nnz by -1 {
-      if oldIndIdx >= 1 && i > newLoc {
-        // Shift from old values
-        idx[i] = idx[oldIndIdx];
-        arrShiftMap[oldIndIdx] = i;
-        oldIndIdx -= 1;
-      }
-      else if newIndIdx >= indsDom.low && i == newLoc {
-        // Put the new guy in
-        if this.compressRows {
-          idx[i] = inds[newIndIdx][2];
+    // 4) Merge.  Rows move up, so the old indices are read from a copy
+    var oldIdx: [1..oldnnz] idxType;
+    if oldnnz > 0 then
+      oldIdx = idx[1..oldnnz];
+
+    var arrShiftMap: [1..oldnnz] int; // to map where data goes
+    forall r in rows {
+      var dst = newEnds[r] - newRowLen[r] + 1;
+      var o = startIdx[r]:int,
+          p = rowOff[r];
+      const oEnd = startIdx[r+1]:int,
+            pEnd = p + added[r];
+      while o < oEnd || p < pEnd {
+        if p == pEnd || (o < oEnd && oldIdx[o] < newMinor[p]) {
+          idx[dst] = oldIdx[o];
+          arrShiftMap[o] = dst;
+          o += 1;
         } else {
-          idx[i] = inds[newIndIdx][1];
-        }
-        newIndIdx -= 1;
-        if newIndIdx >= indsDom.low then
-          newLoc = actualInsertPts[newIndIdx];
-        else
-          newLoc = -2; // Finished new set
-        while newLoc == -1 {
-          newIndIdx -= 1;
-          if newIndIdx == indsDom.low-1 then break; // There were duplicates -- now done
-          newLoc = actualInsertPts[newIndIdx];
+          idx[dst] = newMinor[p];
+          p += 1;
         }
+        dst += 1;
       }
-      else halt("Something went wrong");
     }
 
-    // Aggregated row || col shift
-    var prevCursor = if this.compressRows then parentDom.dim(1).low else parentDom.dim(2).low;
-    var cursor: int;
-    var cursorCnt = 0;
-    for (ind, p) in zip(inds, actualInsertPts)  {
-      if p == -1 then continue;
-      if this.compressRows {
-        cursor = ind[1];
-      } else {
-        cursor = ind[2];
-      }
-      if cursor == prevCursor then cursorCnt += 1;
-      else {
-        startIdx[prevCursor+1] += cursorCnt;
-        if cursor - prevCursor > 1 {
-          for i in prevCursor+2..cursor {
-            startIdx[i] += cursorCnt;
-          }
-        }
-        cursorCnt += 1;
-        prevCursor = cursor;
-      }
-    }
-    for i in prevCursor+1..startIdxDom.high {
-      startIdx[i] += cursorCnt;
-    }
-    for a in _arrs do
-      a.sparseBulkShiftArray(arrShiftMap, oldnnz);
+    forall r in rows do
+      startIdx[r] = (newEnds[r] - newRowLen[r] + 1):idxType;
+    startIdx[startIdxDom.high] = (nnz + 1):idxType;
+
+    if oldnnz > 0 then
+      for a in _arrs do
+        a.sparseBulkShiftArray(arrShiftMap, oldnnz);
 
     return actualAddCnt;
   }
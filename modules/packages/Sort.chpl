@@ -276,8 +276,17 @@ proc chpl_check_comparator(comparator, type eltType) {
 /*
    General purpose sorting interface.
 
-   .. note:: Currently this method calls a sequential :proc:`quickSort`, but
-             this may change the future as other algorithms are implemented.
+   Large arrays are sorted in parallel:
+
+   * A non-strided local array whose elements, or whose comparator's keys,
+     are integral or real values is sorted with a parallel radix sort.
+     Other non-strided local arrays use a parallel merge sort.
+   * A non-strided ``Block``-distributed array is sorted with a
+     distributed sample sort.  Every locale sorts its own block.  Then the
+     elements are exchanged between locales in bulk.
+
+   Other arrays, and arrays of fewer than 8192 elements, are sorted with a
+   sequential :proc:`quickSort`.
 
    :arg Data: The array to be sorted
    :type Data: [] `eltType`
@@ -286,6 +295,19 @@ proc chpl_check_comparator(comparator, type eltType) {
 
  */
 proc sort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator) {
+  use Reflection;
+
+  chpl_check_comparator(comparator, eltType);
+
+  if canResolveMethod(Data._value, "doiSort", comparator) {
+    Data._value.doiSort(comparator);
+    return;
+  } else if !Dom.stridable && Dom.idxType == int &&
+            _isDefaultRectangularArr(Data) {
+    chpl_sortLocal(Data, comparator);
+    return;
+  }
+
   quickSort(Data, comparator=comparator);
 }
 
@@ -360,7 +382,7 @@ proc isSorted(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator)
  */
 iter sorted(x, comparator:?rec=defaultComparator) {
   var y = x;
-  quickSort(y, comparator=comparator);
+  sort(y, comparator=comparator);
   for i in y do
     yield i;
 }
@@ -806,6 +828,364 @@ proc selectionSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator)
 }
 
 
+/* Parallel sorts used by sort() */
+
+// Arrays smaller than this are sorted with a sequential quickSort
+private const parallelSortMinLen = 1 << 13;
+
+// A radix sort step covering fewer elements than radixParallelLen runs on
+// one task, and one covering fewer than radixInsertionLen is an insertion sort
+private const radixParallelLen = 1 << 16,
+              radixInsertionLen = 16;
+
+private proc _isDefaultRectangularArr(A: []) param
+  where A._value: DefaultRectangularArr { return true; }
+private proc _isDefaultRectangularArr(A: []) param { return false; }
+
+private proc _sortNumTasks(n: int) {
+  const numTasks = if dataParTasksPerLocale > 0 then dataParTasksPerLocale
+                   else here.maxTaskPar;
+  return max(1, min(numTasks, n / parallelSortMinLen));
+}
+
+pragma "no doc"
+// Sort a non-strided, local 1D array with the fastest engine that applies
+proc chpl_sortLocal(Data: [?Dom] ?eltType, comparator) {
+  if Dom.size < parallelSortMinLen then
+    quickSort(Data, comparator=comparator);
+  else if _radixSortable(eltType, comparator) then
+    _RadixSort(Data, comparator);
+  else
+    _ParallelMergeSort(Data, comparator);
+}
+
+
+// A default-initialized value, for type queries on comparator methods
+private proc _sortDummy(type t) {
+  var x: t;
+  return x;
+}
+
+private proc _isReverseComparator(comparator: ReverseComparator(?)) param {
+  return true;
+}
+
+private proc _isReverseComparator(comparator) param {
+  return false;
+}
+
+private proc _isRadixKeyType(type t) param {
+  return isIntegralType(t) || isRealType(t);
+}
+
+// True if the order 'comparator' gives 'eltType' is that of _radixKey()
+private proc _radixSortable(type eltType, comparator) param {
+  use Reflection;
+
+  if comparator.type == DefaultComparator then
+    return _isRadixKeyType(eltType);
+  else if _isReverseComparator(comparator) then
+    return _radixSortable(eltType, comparator.comparator);
+  else if canResolveMethod(comparator, "key", _sortDummy(eltType)) then
+    return _isRadixKeyType(comparator.key(_sortDummy(eltType)).type);
+  else
+    return false;
+}
+
+// Map a key to a uint(64) whose unsigned order is the order of the keys
+private inline proc _radixBits(k: uint(?w)) {
+  return k: uint(64);
+}
+
+private inline proc _radixBits(k: int(?w)) {
+  return (k: int(64)): uint(64) ^ (1: uint(64) << 63);
+}
+
+private inline proc _radixBits(k: real(?w)) {
+  var r = k: real(64),
+      bits: uint(64);
+  c_memcpy(c_ptrTo(bits), c_ptrTo(r), 8);
+  // Negative values sort in the reverse order of their bits
+  return if bits >> 63 == 1 then ~bits else bits | (1: uint(64) << 63);
+}
+
+private inline proc _radixKey(x, comparator): uint(64) {
+  if comparator.type == DefaultComparator then
+    return _radixBits(x);
+  else if _isReverseComparator(comparator) then
+    return ~_radixKey(x, comparator.comparator);
+  else
+    return _radixBits(comparator.key(x));
+}
+
+// Byte 'digit' of the radix key, counting from the most significant
+private inline proc _radixDigit(x, digit: int, comparator): int {
+  return ((_radixKey(x, comparator) >> (56 - 8 * digit)) & 0xff): int;
+}
+
+
+/*
+   Most significant digit first radix sort on the bytes of _radixKey().  A
+   large range is split into buckets by all of the tasks, each counting and
+   then moving the elements of its own chunk through a scratch array.  Each
+   bucket is then sorted on the next byte: the large buckets one at a time
+   by all of the tasks, the others by one task each, in place.
+*/
+private proc _RadixSort(Data: [?Dom] ?eltType, comparator) {
+  var Tmp: [Dom] eltType;
+  _RadixSortStep(Data, Tmp, Dom.low, Dom.high, 0, comparator);
+}
+
+private proc _RadixSortStep(Data: [?Dom] ?eltType, Tmp: [Dom] eltType,
+                            lo: int, hi: int, digit: int, comparator) {
+  use RangeChunk, DynamicIters;
+
+  if hi - lo + 1 < radixParallelLen {
+    _RadixSortSerial(Data, lo, hi, digit, comparator);
+    return;
+  }
+
+  const numTasks = _sortNumTasks(hi - lo + 1);
+  var counts: [0..#numTasks, 0..255] int;
+
+  coforall tid in 0..#numTasks {
+    for i in chunk(lo..hi, numTasks, tid) do
+      counts[tid, _radixDigit(Data[i], digit, comparator)] += 1;
+  }
+
+  // Turn the counts into where each task's share of each bucket starts
+  var bucketLo: [0..256] int;
+  var next = lo;
+  for b in 0..255 {
+    bucketLo[b] = next;
+    for tid in 0..#numTasks {
+      const count = counts[tid, b];
+      counts[tid, b] = next;
+      next += count;
+    }
+  }
+  bucketLo[256] = next;
+
+  coforall tid in 0..#numTasks {
+    var pos: [0..255] int = counts[tid, ..];
+    for i in chunk(lo..hi, numTasks, tid) {
+      const b = _radixDigit(Data[i], digit, comparator);
+      Tmp[pos[b]] = Data[i];
+      pos[b] += 1;
+    }
+  }
+
+  forall i in lo..hi do
+    Data[i] = Tmp[i];
+
+  if digit == 7 then return;
+
+  for b in 0..255 {
+    if bucketLo[b+1] - bucketLo[b] >= radixParallelLen then
+      _RadixSortStep(Data, Tmp, bucketLo[b], bucketLo[b+1]-1, digit+1,
+                     comparator);
+  }
+
+  forall b in dynamic(0..255, chunkSize=1) {
+    if bucketLo[b+1] - bucketLo[b] < radixParallelLen then
+      _RadixSortSerial(Data, bucketLo[b], bucketLo[b+1]-1, digit+1,
+                       comparator);
+  }
+}
+
+// American flag sort: the radix step done in place by one task
+private proc _RadixSortSerial(Data: [?Dom] ?eltType, lo: int, hi: int,
+                              digit: int, comparator) {
+  if hi - lo < radixInsertionLen {
+    for i in lo+1..hi {
+      const x = Data[i],
+            k = _radixKey(x, comparator);
+      var j = i;
+      while j > lo && k < _radixKey(Data[j-1], comparator) {
+        Data[j] = Data[j-1];
+        j -= 1;
+      }
+      Data[j] = x;
+    }
+    return;
+  }
+
+  // Tuples are indexed from 1, so bucket b is at b+1
+  var count, start, next: 256*int;
+
+  for i in lo..hi do
+    count(_radixDigit(Data[i], digit, comparator) + 1) += 1;
+
+  var pos = lo;
+  for b in 1..256 {
+    start(b) = pos;
+    next(b) = pos;
+    pos += count(b);
+  }
+
+  // Follow each cycle of misplaced elements, dropping each into its bucket
+  for b in 1..256 {
+    const end = start(b) + count(b);
+    while next(b) < end {
+      var x = Data[next(b)];
+      var xb = _radixDigit(x, digit, comparator) + 1;
+      while xb != b {
+        x <=> Data[next(xb)];
+        next(xb) += 1;
+        xb = _radixDigit(x, digit, comparator) + 1;
+      }
+      Data[next(b)] = x;
+      next(b) += 1;
+    }
+  }
+
+  if digit == 7 then return;
+
+  for b in 1..256 {
+    if count(b) > 1 then
+      _RadixSortSerial(Data, start(b), start(b) + count(b) - 1, digit + 1,
+                       comparator);
+  }
+}
+
+
+/*
+   Merge sort for comparators the radix sort cannot use.  Every task sorts
+   a chunk with quickSort, then the chunks are merged pairwise.  A merge is
+   split among several tasks by finding where each task's part of the
+   output begins in each of the two runs.
+*/
+private proc _ParallelMergeSort(Data: [?Dom] ?eltType, comparator) {
+  use RangeChunk;
+
+  const numTasks = _sortNumTasks(Dom.size);
+  var bounds: [0..numTasks] int;
+
+  coforall tid in 0..#numTasks {
+    const r = chunk(Dom.low..Dom.high, numTasks, tid);
+    bounds[tid] = r.low;
+    quickSort(Data[r], comparator=comparator);
+  }
+  bounds[numTasks] = Dom.high + 1;
+
+  chpl_mergeRuns(Data, bounds, comparator);
+}
+
+pragma "no doc"
+// Merge the sorted runs Data[bounds[i]..bounds[i+1]-1] into one
+proc chpl_mergeRuns(Data: [?Dom] ?eltType, in bounds: [] int, comparator) {
+  var numRuns = bounds.size - 1;
+  if numRuns <= 1 then return;
+
+  var Tmp: [Dom] eltType;
+  var inTmp = false;
+  const numTasks = _sortNumTasks(Dom.size);
+
+  while numRuns > 1 {
+    const numMerges = (numRuns + 1) / 2,
+          numPieces = max(1, numTasks / numMerges);
+
+    if inTmp then
+      _MergeRound(Tmp, Data, bounds, numRuns, numPieces, comparator);
+    else
+      _MergeRound(Data, Tmp, bounds, numRuns, numPieces, comparator);
+    inTmp = !inTmp;
+
+    for i in 0..#numMerges do
+      bounds[i] = bounds[2*i];
+    bounds[numMerges] = bounds[numRuns];
+    numRuns = numMerges;
+  }
+
+  if inTmp then
+    forall i in Dom do
+      Data[i] = Tmp[i];
+}
+
+// Merge runs 2*m and 2*m+1 of Src into Dst, in numPieces pieces each
+private proc _MergeRound(Src: [?Dom] ?eltType, Dst: [Dom] eltType,
+                         bounds: [] int, numRuns: int, numPieces: int,
+                         comparator) {
+  const numMerges = (numRuns + 1) / 2;
+
+  forall (m, piece) in {0..#numMerges, 0..#numPieces} {
+    const aLo = bounds[2*m],
+          bLo = bounds[min(2*m+1, numRuns)],
+          bEnd = bounds[min(2*m+2, numRuns)],
+          numA = bLo - aLo,
+          numB = bEnd - bLo,
+          outLo = ((numA + numB) * piece) / numPieces,
+          outHi = ((numA + numB) * (piece + 1)) / numPieces,
+          i0 = _mergeSplit(Src, aLo, numA, bLo, numB, outLo, comparator),
+          i1 = _mergeSplit(Src, aLo, numA, bLo, numB, outHi, comparator);
+
+    _MergeSerial(Src, Dst, aLo+i0, aLo+i1, bLo+outLo-i0, bLo+outHi-i1,
+                 aLo+outLo, comparator);
+  }
+}
+
+// How many of the first 'n' merged elements come from the run at aLo
+private proc _mergeSplit(Src: [], aLo: int, numA: int, bLo: int, numB: int,
+                         n: int, comparator) {
+  var lo = max(0, n - numB),
+      hi = min(n, numA);
+
+  while lo < hi {
+    const mid = (lo + hi) / 2;
+    if chpl_compare(Src[bLo + n - mid - 1], Src[aLo + mid], comparator) < 0 then
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  return lo;
+}
+
+// Merge Src[a..aEnd-1] and Src[b..bEnd-1] into Dst starting at d, keeping
+// equal elements in the order of the runs
+private proc _MergeSerial(Src: [], Dst: [], in a: int, aEnd: int,
+                          in b: int, bEnd: int, in d: int, comparator) {
+  while a < aEnd && b < bEnd {
+    if chpl_compare(Src[b], Src[a], comparator) < 0 {
+      Dst[d] = Src[b];
+      b += 1;
+    } else {
+      Dst[d] = Src[a];
+      a += 1;
+    }
+    d += 1;
+  }
+  while a < aEnd {
+    Dst[d] = Src[a];
+    a += 1;
+    d += 1;
+  }
+  while b < bEnd {
+    Dst[d] = Src[b];
+    b += 1;
+    d += 1;
+  }
+}
+
+
+pragma "no doc"
+// The number of elements of the sorted Data[lo..#n] that are less than
+// 'x', or that are not greater than 'x' if 'upper' is true
+proc chpl_sortBound(Data: [], lo: int, n: int, x, upper: bool,
+                        comparator) {
+  var first = 0,
+      last = n;
+  while first < last {
+    const mid = (first + last) / 2,
+          c = chpl_compare(Data[lo + mid], x, comparator);
+    if c < 0 || (upper && c == 0) then
+      first = mid + 1;
+    else
+      last = mid;
+  }
+  return first;
+}
+
+
 /* Comparators */
 
 /* Default comparator used in sort functions.*/
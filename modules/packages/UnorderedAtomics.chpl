@@ -0,0 +1,117 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+Unordered atomic operations.
+
+An unordered atomic operation is one whose result is not needed by the
+task that issues it and that does not have to be complete when the call
+returns.  Under network atomics (see :ref:`readme-atomics`) a remote
+unordered operation is started and the calling task moves on without
+waiting for it, which lets a task that updates many remote atomics, as
+in a histogram, keep many of them in flight at once.  For processor
+atomics the operations are ordinary atomic operations with
+``memory_order_relaxed``.
+
+Unordered operations are only guaranteed to be complete after
+:proc:`unorderedAtomicTaskFence` has been called or after the task that
+issued them has finished, so that the end of a ``forall``, ``coforall``,
+``cobegin`` or ``sync`` statement completes the unordered operations
+done inside it.
+
+.. code-block:: chapel
+
+    use UnorderedAtomics;
+
+    var hist: [Dist] atomic int;
+
+    forall r in rands do
+      unorderedAtomicAdd(hist[r % n], 1);
+
+    // all of the adds are complete here
+
+ */
+module UnorderedAtomics {
+  use Reflection;
+
+  /*
+    Add `val` to the atomic `A` without waiting for the add to complete.
+   */
+  inline proc unorderedAtomicAdd(ref A, val) {
+    if canResolveMethod(A, "unorderedAdd", val) then
+      A.unorderedAdd(val);
+    else
+      A.add(val, memory_order_relaxed);
+  }
+
+  /*
+    Subtract `val` from the atomic `A` without waiting for the subtract
+    to complete.
+   */
+  inline proc unorderedAtomicSub(ref A, val) {
+    if canResolveMethod(A, "unorderedSub", val) then
+      A.unorderedSub(val);
+    else
+      A.sub(val, memory_order_relaxed);
+  }
+
+  /*
+    Bitwise-and `val` into the atomic `A` without waiting for the
+    operation to complete.
+   */
+  inline proc unorderedAtomicAnd(ref A, val) {
+    if canResolveMethod(A, "unorderedAnd", val) then
+      A.unorderedAnd(val);
+    else
+      A.and(val, memory_order_relaxed);
+  }
+
+  /*
+    Bitwise-or `val` into the atomic `A` without waiting for the
+    operation to complete.
+   */
+  inline proc unorderedAtomicOr(ref A, val) {
+    if canResolveMethod(A, "unorderedOr", val) then
+      A.unorderedOr(val);
+    else
+      A.or(val, memory_order_relaxed);
+  }
+
+  /*
+    Bitwise-xor `val` into the atomic `A` without waiting for the
+    operation to complete.
+   */
+  inline proc unorderedAtomicXor(ref A, val) {
+    if canResolveMethod(A, "unorderedXor", val) then
+      A.unorderedXor(val);
+    else
+      A.xor(val, memory_order_relaxed);
+  }
+
+  /*
+    Wait until the unordered atomic operations done by the calling task
+    are complete.
+   */
+  inline proc unorderedAtomicTaskFence() {
+    if CHPL_NETWORK_ATOMICS != "none" {
+      extern proc chpl_comm_atomic_unordered_task_fence();
+      chpl_comm_atomic_unordered_task_fence();
+    }
+  }
+}
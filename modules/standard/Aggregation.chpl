@@ -0,0 +1,363 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+Aggregation of fine-grained remote operations.
+
+A loop that writes, reads or atomically updates remote elements one at
+a time, such as a scatter into a distributed array, does one small
+network operation per element.  The aggregators in this module instead
+buffer the operations in the calling task, with one buffer per remote
+locale.  When the buffer for a locale is full it is moved to that locale
+with one bulk transfer and the operations in it are done there by one
+task.  Operations on elements that are local are done right away.
+
+An aggregator is meant to be used by a single task.  The usual way to
+get one per task is an ``in`` intent on a ``forall`` loop.  Copying an
+aggregator gives a new, empty aggregator, and an aggregator flushes its
+buffers when it is destroyed, so all the operations are done by the end
+of the loop.  Assigning one aggregator to another flushes the one
+assigned to; the operations buffered in each stay with it.
+
+.. code-block:: chapel
+
+    use Aggregation;
+
+    var A: [Dist] int;
+
+    var agg = new DstAggregator(int);
+    forall (i, x) in zip(inds, vals) with (in agg) do
+      agg.copy(A[i], x);
+
+    // A has all of the new values here
+
+Until a buffered operation has been flushed there is no guarantee about
+when it happens relative to other operations, including those of the same
+task on other locales.  Call ``flush()`` to wait for the operations done
+so far.
+
+Only element types that can be bulk transferred, e.g. numeric types and
+tuples or records of them, are aggregated.  Operations on other types
+are done right away.
+ */
+module Aggregation {
+
+  /*
+    The number of operations that an aggregator buffers for a locale
+    before it sends them to that locale.
+   */
+  config const aggregationBufferSize = 4096;
+
+  /*
+    Aggregates writes to remote elements.
+   */
+  record DstAggregator {
+    /* The type of the elements written */
+    type elemType;
+
+    pragma "no doc"
+    var bufs: _AggBuffers(c_ptr(elemType), elemType);
+
+    pragma "no doc"
+    proc deinit() {
+      flush();
+      bufs.free();
+    }
+
+    /*
+      Write `src` to `dst`.  `dst` has its new value after the
+      aggregator has been flushed.
+     */
+    inline proc ref copy(ref dst: elemType, const in src: elemType) {
+      if !chpl__supportedDataTypeForBulkTransfer(elemType) {
+        dst = src;
+      } else {
+        const loc = _aggLocale(dst);
+        if loc == here.id then
+          dst = src;
+        else if bufs.append(loc, _aggAddr(dst), src) then
+          _flush(loc);
+      }
+    }
+
+    /* Do all of the buffered writes. */
+    proc ref flush() {
+      if chpl__supportedDataTypeForBulkTransfer(elemType) then
+        for loc in bufs.pending() do
+          _flush(loc);
+    }
+
+    pragma "no doc"
+    proc ref _flush(loc: int) {
+      const n = bufs.counts[loc],
+            origin = here.id,
+            addrs = bufs.addrs[loc],
+            vals = bufs.vals[loc];
+
+      on Locales[loc] {
+        var myAddrs = c_malloc(c_ptr(elemType), n),
+            myVals = c_malloc(elemType, n);
+        _aggGet(myAddrs, origin, addrs, n);
+        _aggGet(myVals, origin, vals, n);
+        for i in 0..#n do
+          myAddrs[i].deref() = myVals[i];
+        c_free(myAddrs);
+        c_free(myVals);
+      }
+      bufs.counts[loc] = 0;
+    }
+  }
+
+  /*
+    Aggregates reads from remote elements into local ones.
+   */
+  record SrcAggregator {
+    /* The type of the elements read */
+    type elemType;
+
+    pragma "no doc"
+    var bufs: _AggBuffers(c_ptr(elemType), c_ptr(elemType));
+
+    pragma "no doc"
+    proc deinit() {
+      flush();
+      bufs.free();
+    }
+
+    /*
+      Read `src` into `dst`, which should be local.  `dst` has the value
+      after the aggregator has been flushed.
+     */
+    inline proc ref copy(ref dst: elemType, const ref src: elemType) {
+      if !chpl__supportedDataTypeForBulkTransfer(elemType) {
+        dst = src;
+      } else {
+        const loc = _aggLocale(src);
+        if loc == here.id || _aggLocale(dst) != here.id then
+          dst = src;
+        else if bufs.append(loc, _aggAddr(src), _aggAddr(dst)) then
+          _flush(loc);
+      }
+    }
+
+    /* Do all of the buffered reads. */
+    proc ref flush() {
+      if chpl__supportedDataTypeForBulkTransfer(elemType) then
+        for loc in bufs.pending() do
+          _flush(loc);
+    }
+
+    pragma "no doc"
+    proc ref _flush(loc: int) {
+      const n = bufs.counts[loc],
+            origin = here.id,
+            srcAddrs = bufs.addrs[loc];
+      var vals = c_malloc(elemType, n);
+
+      on Locales[loc] {
+        var mySrcAddrs = c_malloc(c_ptr(elemType), n),
+            myVals = c_malloc(elemType, n);
+        _aggGet(mySrcAddrs, origin, srcAddrs, n);
+        for i in 0..#n do
+          myVals[i] = mySrcAddrs[i].deref();
+        _aggPut(myVals, origin, vals, n);
+        c_free(mySrcAddrs);
+        c_free(myVals);
+      }
+
+      const dstAddrs = bufs.vals[loc];
+      for i in 0..#n do
+        dstAddrs[i].deref() = vals[i];
+      c_free(vals);
+      bufs.counts[loc] = 0;
+    }
+  }
+
+  /*
+    Aggregates adds to remote atomic elements.
+   */
+  record AtomicAddAggregator {
+    /* The base type of the atomic elements, e.g. ``int`` for ``atomic int`` */
+    type elemType;
+
+    pragma "no doc"
+    var bufs: _AggBuffers(c_ptr(chpl__atomicType(elemType)), elemType);
+
+    pragma "no doc"
+    proc deinit() {
+      flush();
+      bufs.free();
+    }
+
+    /*
+      Atomically add `x` to `dst`, an ``atomic elemType``.  The add is done
+      after the aggregator has been flushed.
+     */
+    inline proc ref add(ref dst: chpl__atomicType(elemType), x: elemType) {
+      const loc = _aggLocale(dst);
+      if loc == here.id then
+        dst.add(x);
+      else if bufs.append(loc, _aggAddr(dst), x) then
+        _flush(loc);
+    }
+
+    /* Do all of the buffered adds. */
+    proc ref flush() {
+      for loc in bufs.pending() do
+        _flush(loc);
+    }
+
+    pragma "no doc"
+    proc ref _flush(loc: int) {
+      const n = bufs.counts[loc],
+            origin = here.id,
+            addrs = bufs.addrs[loc],
+            vals = bufs.vals[loc];
+
+      on Locales[loc] {
+        var myAddrs = c_malloc(c_ptr(chpl__atomicType(elemType)), n),
+            myVals = c_malloc(elemType, n);
+        _aggGet(myAddrs, origin, addrs, n);
+        _aggGet(myVals, origin, vals, n);
+        for i in 0..#n do
+          myAddrs[i].deref().add(myVals[i]);
+        c_free(myAddrs);
+        c_free(myVals);
+      }
+      bufs.counts[loc] = 0;
+    }
+  }
+
+  // Copying an aggregator must not copy its buffered operations, or they
+  // would be done twice.  This also gives each task of a forall with an
+  // 'in' intent its own buffers.
+  pragma "no doc"
+  pragma "init copy fn"
+  proc chpl__initCopy(const ref a: DstAggregator) {
+    return new DstAggregator(a.elemType);
+  }
+
+  pragma "no doc"
+  pragma "init copy fn"
+  proc chpl__initCopy(const ref a: SrcAggregator) {
+    return new SrcAggregator(a.elemType);
+  }
+
+  pragma "no doc"
+  pragma "init copy fn"
+  proc chpl__initCopy(const ref a: AtomicAddAggregator) {
+    return new AtomicAddAggregator(a.elemType);
+  }
+
+  // Likewise, assignment must not copy the buffers, or both aggregators
+  // would do and free them.
+  pragma "no doc"
+  proc =(ref lhs: DstAggregator, const ref rhs: DstAggregator) {
+    lhs.flush();
+  }
+
+  pragma "no doc"
+  proc =(ref lhs: SrcAggregator, const ref rhs: SrcAggregator) {
+    lhs.flush();
+  }
+
+  pragma "no doc"
+  proc =(ref lhs: AtomicAddAggregator, const ref rhs: AtomicAddAggregator) {
+    lhs.flush();
+  }
+
+  //
+  // Per-locale buffers of (address, value) pairs.  They are allocated the
+  // first time an operation for a locale is buffered, on the locale of the
+  // task doing it.
+  //
+  pragma "no doc"
+  record _AggBuffers {
+    type addrType;
+    type valType;
+    var addrs: c_ptr(c_ptr(addrType));
+    var vals: c_ptr(c_ptr(valType));
+    var counts: c_ptr(int);
+
+    // Returns true when the buffer for 'loc' is full
+    inline proc ref append(loc: int, addr: addrType, const in val: valType) {
+      if counts == nil {
+        addrs = c_calloc(c_ptr(addrType), numLocales);
+        vals = c_calloc(c_ptr(valType), numLocales);
+        counts = c_calloc(int, numLocales);
+      }
+      if addrs[loc] == nil {
+        addrs[loc] = c_malloc(addrType, aggregationBufferSize);
+        vals[loc] = c_malloc(valType, aggregationBufferSize);
+      }
+
+      const i = counts[loc];
+      addrs[loc][i] = addr;
+      vals[loc][i] = val;
+      counts[loc] = i + 1;
+      return i + 1 == aggregationBufferSize;
+    }
+
+    iter pending() {
+      if counts != nil {
+        for loc in 0..#numLocales do
+          if counts[loc] > 0 then yield loc;
+      }
+    }
+
+    proc ref free() {
+      if counts != nil {
+        for loc in 0..#numLocales {
+          if addrs[loc] != nil {
+            c_free(addrs[loc]);
+            c_free(vals[loc]);
+          }
+        }
+        c_free(addrs);
+        c_free(vals);
+        c_free(counts);
+        counts = nil;
+      }
+    }
+  }
+
+  pragma "no doc"
+  inline proc _aggLocale(const ref x): int {
+    return chpl_nodeFromLocaleID(__primitive("_wide_get_locale", x));
+  }
+
+  pragma "no doc"
+  inline proc _aggAddr(const ref x) {
+    return __primitive("_wide_get_addr", x): c_ptr(x.type);
+  }
+
+  // Copy n elements from srcAddr on srcLoc to the local dst
+  pragma "no doc"
+  inline proc _aggGet(dst: c_ptr(?t), srcLoc: int, srcAddr: c_ptr(t), n: int) {
+    __primitive("chpl_comm_get", dst, srcLoc, srcAddr,
+                n:size_t * c_sizeof(t));
+  }
+
+  // Copy n elements from the local src to dstAddr on dstLoc
+  pragma "no doc"
+  inline proc _aggPut(src: c_ptr(?t), dstLoc: int, dstAddr: c_ptr(t), n: int) {
+    __primitive("chpl_comm_put", src, dstLoc, dstAddr,
+                n:size_t * c_sizeof(t));
+  }
+}
@@ -137,6 +137,49 @@
   was executed on locale 0, and a remote get and a remote put were
   executed on locale 1.
 
+  **Detailed Communication Diagnostics**
+
+  While communication is being counted, the comm layers also record
+  more detail about each kind of operation, named by the
+  :enum:`commOp` enum: how many operations went to each remote locale
+  and how many bytes they moved, and a histogram of how long blocking
+  operations took.  These are retrieved separately from the counts,
+  one kind of operation at a time, and are reset by the same calls::
+
+    resetCommDiagnostics();
+    startCommDiagnostics();
+    // ... the phase of the program to be studied ...
+    stopCommDiagnostics();
+    // GETs initiated on each locale (rows) from each locale (columns)
+    writeln(getCommTraffic(commOp.get));
+    // latencies of blocking GETs initiated on this locale
+    writeln(getCommLatencyHere(commOp.get));
+
+  Element ``i`` of a latency histogram counts the operations that took
+  from ``2**i`` up to ``2**(i+1)`` nanoseconds.  Non-blocking
+  operations are not timed, and strided operations are only timed when
+  the comm layer does them as single blocking transfers.  The ``ofi``
+  comm layer does not record latencies yet, so its histograms are
+  always empty.
+
+  **Remote Cache Statistics**
+
+  When a program is compiled with ``--cache-remote``, the remote data
+  cache on each locale keeps counts of its hits, misses, readahead,
+  write-backs and evictions.  These are always being counted, so they
+  only need to be reset and retrieved::
+
+    resetCacheDiagnostics();
+    // ... the phase of the program to be studied ...
+    writeln(getCacheDiagnostics());
+
+  As with the communication counts, :proc:`resetCacheDiagnosticsHere`
+  and :proc:`getCacheDiagnosticsHere` do the same for just the calling
+  locale.  Comparing the ``get_hits`` to the ``get_misses`` shows how
+  much a phase benefits from the cache, and ``readahead_wasted``
+  relative to ``readahead_issued`` shows how much readahead is going
+  unused.  Without ``--cache-remote`` all of the statistics are zero.
+
   **Studying Communication During Module Initialization**
 
   It is hard for a programmer to determine exactly what happens during
@@ -238,6 +281,130 @@ module CommDiagnostics
    */
   type commDiagnostics = chpl_commDiagnostics;
 
+  /*
+    Kinds of communication operations distinguished by the detailed
+    diagnostics.  These must match chpl_comm_diags_op_t in the runtime.
+   */
+  enum commOp {
+    /* blocking GETs */
+    get = 0,
+    /* blocking PUTs */
+    put = 1,
+    /* non-blocking GETs */
+    get_nb = 2,
+    /* non-blocking PUTs */
+    put_nb = 3,
+    /* strided GETs */
+    get_strd = 4,
+    /* strided PUTs */
+    put_strd = 5,
+    /* network atomic operations */
+    amo = 6,
+    /* blocking remote executions */
+    execute_on = 7,
+    /* remote executions done by the target's Active Message handler */
+    execute_on_fast = 8,
+    /* non-blocking remote executions */
+    execute_on_nb = 9
+  };
+
+  /*
+    Operation and byte counts for one kind of operation between a pair
+    of locales.  For remote executions, the bytes are those of the
+    argument bundle sent along with the task.
+   */
+  record commTraffic {
+    /* number of operations */
+    var ops: uint(64);
+    /* number of bytes moved */
+    var bytes: uint(64);
+  };
+
+  /*
+    Number of elements in a latency histogram.
+   */
+  param commLatencyBuckets = 32;
+
+  /* Aggregated remote cache statistics.  This record type is defined
+     in the same way by both the runtime remote cache and this module.
+     This definition duplicates the one in the runtime.
+   */
+  extern record chpl_cacheDiagnostics {
+    /*
+      GETs satisfied entirely from the cache
+     */
+    var get_hits: uint(64);
+    /*
+      GETs that found some but not all of their data in the cache
+     */
+    var get_partial_hits: uint(64);
+    /*
+      GETs that found none of their data in the cache
+     */
+    var get_misses: uint(64);
+    /*
+      PUTs stored into the cache
+     */
+    var puts: uint(64);
+    /*
+      dirty cache pages written back
+     */
+    var dirty_flushes: uint(64);
+    /*
+      PUTs issued to write back dirty data
+     */
+    var flush_puts: uint(64);
+    /*
+      bytes written back by those PUTs
+     */
+    var flush_put_bytes: uint(64);
+    /*
+      pages requested by readahead
+     */
+    var readahead_issued: uint(64);
+    /*
+      readahead pages later read by a GET
+     */
+    var readahead_used: uint(64);
+    /*
+      readahead pages evicted without being read
+     */
+    var readahead_wasted: uint(64);
+    /*
+      pages evicted from the Ain (first use) queue
+     */
+    var evict_ain: uint(64);
+    /*
+      entries dropped from the Aout (recently evicted) queue
+     */
+    var evict_aout: uint(64);
+    /*
+      pages evicted from the Am (reused) queue
+     */
+    var evict_am: uint(64);
+
+    proc writeThis(c) {
+      use Reflection;
+
+      var first = true;
+      c <~> "(";
+      for param i in 1..numFields(chpl_cacheDiagnostics) {
+        const val = getField(this, i);
+        if val != 0 {
+          if first then first = false; else c <~> ", ";
+          c <~> getFieldName(chpl_cacheDiagnostics, i) <~> " = " <~> val;
+        }
+      }
+      if first then c <~> "<no cache activity>";
+      c <~> ")";
+    }
+  };
+
+  /*
+    The Chapel record type inherits the runtime definition of it.
+   */
+  type cacheDiagnostics = chpl_cacheDiagnostics;
+
   private extern proc chpl_startVerboseComm();
 
   private extern proc chpl_stopVerboseComm();
@@ -258,6 +425,19 @@ module CommDiagnostics
 
   private extern proc chpl_getCommDiagnosticsHere(out cd: commDiagnostics);
 
+  private extern proc chpl_comm_diags_resetHere();
+
+  private extern proc chpl_comm_diags_getTrafficHere(op: c_int,
+                                                     ops: c_ptr(uint(64)),
+                                                     bytes: c_ptr(uint(64)));
+
+  private extern proc chpl_comm_diags_getLatencyHere(op: c_int,
+                                                     hist: c_ptr(uint(64)));
+
+  private extern proc chpl_cache_resetDiagnosticsHere();
+
+  private extern proc chpl_cache_getDiagnosticsHere(out cd: cacheDiagnostics);
+
   /*
     Start on-the-fly reporting of communication initiated on any locale.
    */
@@ -319,6 +499,7 @@ module CommDiagnostics
    */
   inline proc resetCommDiagnosticsHere() {
     chpl_resetCommDiagnosticsHere();
+    chpl_comm_diags_resetHere();
   }
 
   /*
@@ -347,6 +528,118 @@ module CommDiagnostics
     return cd;
   }
 
+  /*
+    Retrieve the traffic of one kind of operation initiated on each
+    locale, broken down by the remote locale involved.
+
+    :arg op: the kind of operation
+    :returns: element ``[i, j]`` holds the operations initiated on
+              locale ``i`` with locale ``j``
+    :rtype: `[0..#numLocales, 0..#numLocales] commTraffic`
+   */
+  proc getCommTraffic(op: commOp) {
+    var D: [0..#numLocales, 0..#numLocales] commTraffic;
+    for loc in Locales do on loc {
+      const T = getCommTrafficHere(op);
+      for j in LocaleSpace do
+        D[loc.id, j] = T[j];
+    }
+    return D;
+  }
+
+  /*
+    Retrieve the traffic of one kind of operation initiated on this
+    locale, broken down by the remote locale involved.
+
+    :arg op: the kind of operation
+    :returns: element ``j`` holds the operations initiated here with
+              locale ``j``
+    :rtype: `[LocaleSpace] commTraffic`
+   */
+  proc getCommTrafficHere(op: commOp) {
+    var ops, bytes: [LocaleSpace] uint(64);
+    chpl_comm_diags_getTrafficHere(op: c_int, c_ptrTo(ops[0]),
+                                   c_ptrTo(bytes[0]));
+    var T: [LocaleSpace] commTraffic;
+    for j in LocaleSpace do
+      T[j] = new commTraffic(ops[j], bytes[j]);
+    return T;
+  }
+
+  /*
+    Retrieve the latency histograms of one kind of blocking operation
+    initiated on each locale.
+
+    :arg op: the kind of operation
+    :returns: row ``i`` holds the histogram for locale ``i``
+    :rtype: `[0..#numLocales, 0..#commLatencyBuckets] uint(64)`
+   */
+  proc getCommLatency(op: commOp) {
+    var D: [0..#numLocales, 0..#commLatencyBuckets] uint(64);
+    for loc in Locales do on loc {
+      const H = getCommLatencyHere(op);
+      for b in 0..#commLatencyBuckets do
+        D[loc.id, b] = H[b];
+    }
+    return D;
+  }
+
+  /*
+    Retrieve the latency histogram of one kind of blocking operation
+    initiated on this locale.
+
+    :arg op: the kind of operation
+    :returns: element ``i`` counts operations that took from ``2**i``
+              up to ``2**(i+1)`` nanoseconds
+    :rtype: `[0..#commLatencyBuckets] uint(64)`
+   */
+  proc getCommLatencyHere(op: commOp) {
+    var H: [0..#commLatencyBuckets] uint(64);
+    chpl_comm_diags_getLatencyHere(op: c_int, c_ptrTo(H[0]));
+    return H;
+  }
+
+  /*
+    Reset remote cache statistics across the whole program.
+   */
+  proc resetCacheDiagnostics() {
+    for loc in Locales do on loc do
+      resetCacheDiagnosticsHere();
+  }
+
+  /*
+    Reset remote cache statistics on the calling locale.
+   */
+  inline proc resetCacheDiagnosticsHere() {
+    chpl_cache_resetDiagnosticsHere();
+  }
+
+  /*
+    Retrieve remote cache statistics for the whole program.
+
+    :returns: array of statistics for the caches on each locale
+    :rtype: `[LocaleSpace] cacheDiagnostics`
+   */
+  proc getCacheDiagnostics() {
+    var D: [LocaleSpace] cacheDiagnostics;
+    for loc in Locales do on loc {
+      D(loc.id) = getCacheDiagnosticsHere();
+    }
+    return D;
+  }
+
+  /*
+    Retrieve remote cache statistics for this locale.
+
+    :returns: statistics for the caches on this locale
+    :rtype: `cacheDiagnostics`
+   */
+  proc getCacheDiagnosticsHere() {
+    var cd: cacheDiagnostics;
+    chpl_cache_getDiagnosticsHere(cd);
+    return cd;
+  }
+
 
   /*
     If this is set, on-the-fly reporting of communication operations
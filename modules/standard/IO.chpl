@@ -418,7 +418,8 @@ module IO {
       -- seems that we'd want some way to cache that...).
     - Create leader/follower iterators for ItemReader/ItemWriter so that these
       are as efficient as possible when working with fixed-size data types
-      (ie, they can open up channels that are not shared).
+      (ie, they can open up channels that are not shared). ItemReader has
+      them for lines already.
 */
 
 use SysBasic;
@@ -653,6 +654,8 @@ extern const QIO_METHOD_FREADFWRITE:c_int;
 pragma "no doc"
 extern const QIO_METHOD_MMAP:c_int;
 pragma "no doc"
+extern const QIO_METHOD_ASYNC:c_int;
+pragma "no doc"
 extern const QIO_METHODMASK:c_int;
 pragma "no doc"
 extern const QIO_HINT_RANDOM:c_int;
@@ -700,6 +703,16 @@ const IOHINT_CACHED = QIO_HINT_CACHED;
  */
 const IOHINT_PARALLEL = QIO_HINT_PARALLEL;
 
+/*  IOHINT_ASYNC requests asynchronous reads and writes.  A task
+    waiting on the disk yields its thread to other tasks instead of
+    blocking it in a system call, so many tasks can keep many reads
+    in flight at once.  Requests are batched through io_uring on
+    Linux systems that support it and are otherwise run by a small
+    pool of helper threads.  Files that cannot seek (such as pipes)
+    ignore this hint.
+ */
+const IOHINT_ASYNC = QIO_METHOD_ASYNC;
+
 pragma "no doc"
 extern type qio_file_ptr_t;
 private extern const QIO_FILE_PTR_NULL:qio_file_ptr_t;
@@ -881,6 +894,7 @@ private extern proc qio_file_unlock(f:qio_file_ptr_t);
 private extern proc qio_file_sync(f:qio_file_ptr_t):syserr;
 
 private extern proc qio_channel_end_offset_unlocked(ch:qio_channel_ptr_t):int(64);
+private extern proc qio_channel_get_file(ch:qio_channel_ptr_t):qio_file_ptr_t;
 private extern proc qio_file_get_style(f:qio_file_ptr_t, ref style:iostyle);
 private extern proc qio_file_length(f:qio_file_ptr_t, ref len:int(64)):syserr;
 
@@ -1202,6 +1216,8 @@ The following :type:`iohints` constants are provided:
     cached in memory, possibly all at once.
   * :const:`IOHINT_PARALLEL` suggests to expect many channels
     working with this file in parallel.
+  * :const:`IOHINT_ASYNC` requests that reads and writes be performed
+    asynchronously, yielding the calling task while they complete.
 
 
 Other hints might be added in the future.
@@ -1225,6 +1241,7 @@ The default value of the :type:`iohints` type is undefined.
 //  QIO_METHOD_READWRITE,
 //  QIO_METHOD_P_READWRITE,
 //  QIO_METHOD_MMAP,
+//  QIO_METHOD_ASYNC,
 //  QIO_HINT_RANDOM,
 //  QIO_HINT_SEQUENTIAL,
 //  QIO_HINT_LATENCY,
@@ -2629,6 +2646,10 @@ proc file.reader(param kind=iokind.dynamic, param locking=true, start:int(64) =
 
 /* Iterate over all of the lines in a file.
 
+   The returned object can also be iterated over with a ``forall`` loop, in
+   which case the lines are read in parallel and not in order. See
+   :proc:`ItemReader.these`.
+
    :arg error: optional argument to capture an error code. If this argument
                is not provided and an error is encountered, this function
                will halt with an error message.
@@ -4281,6 +4302,179 @@ record ItemReader {
       yield x;
     }
   }
+
+  /* iterate through the lines read from the channel in parallel
+
+     The region of the file that is left to read is divided into chunks that
+     start just after a ``\n`` and each chunk is read by one task with a
+     channel of its own. When the file system reports which locales store a
+     chunk, that chunk is read on one of them. Lines are not yielded in order
+     and the channel itself is not advanced.
+
+     Only an :record:`ItemReader` created by :proc:`file.lines` is split into
+     chunks; any other string reader is read by a single task. An
+     :record:`ItemReader` can't be zippered with other iterators in a
+     ``forall`` loop.
+   */
+  iter these(param tag:iterKind) where tag == iterKind.standalone && ItemType == string {
+    const (f, style, start, end) = _linesRegion(ch);
+    const (chunks, owners) = _lineChunks(f, style, start, end);
+
+    var locIds:domain(int);
+    for id in owners do locIds += id;
+
+    coforall id in locIds do on Locales[id] {
+      const myChunks = chunks;
+      const myOwners = owners;
+      const lf = _lineChunkFile(f);
+      var next:atomic int;
+
+      coforall tid in 0..#here.maxTaskPar {
+        while true {
+          const i = next.fetchAdd(1);
+          if i >= myChunks.size then break;
+          if myOwners[i] != here.id then continue;
+          for line in _readLineChunk(lf, style, myChunks[i]) do
+            yield line;
+        }
+      }
+    }
+  }
+
+  // The chunks are byte regions of this file, which no other iterator
+  // could follow, so ItemReader only supports standalone iteration.
+  pragma "no doc"
+  iter these(param tag:iterKind) where tag == iterKind.leader && ItemType == string {
+    compilerError("ItemReader can't be zippered with other iterators");
+    yield (0:int(64), 0:int(64));
+  }
+
+  pragma "no doc"
+  iter these(param tag:iterKind, followThis) where tag == iterKind.follower && ItemType == string {
+    compilerError("ItemReader can't be zippered with other iterators");
+    yield "";
+  }
+}
+
+// Parallel iteration over lines splits a file into chunks of at least
+// this many bytes.
+private const lineChunkMinBytes = 64 * 1024;
+
+// Returns the file, style and remaining (start, end) region of a channel.
+private proc _linesRegion(ch) {
+  var f:file;
+  var style:iostyle;
+  var start, end:int(64);
+
+  on ch.home {
+    var lf:file;
+    lf._file_internal = qio_channel_get_file(ch._channel_internal);
+    qio_file_retain(lf._file_internal);
+    f = lf;
+
+    style = ch._style();
+    try! ch.lock();
+    start = qio_channel_offset_unlocked(ch._channel_internal);
+    end = qio_channel_end_offset_unlocked(ch._channel_internal);
+    ch.unlock();
+    end = min(end, try! lf.length());
+  }
+  return (f, style, start, end);
+}
+
+private proc _isLinesStyle(style:iostyle) {
+  return style.string_format == QIO_STRING_FORMAT_TOEND &&
+         style.string_end == 0x0a;
+}
+
+// Returns the offset just after the first '\n' at or after pos-1, or end
+// if there is none, so that a chunk starting there begins a line.
+private proc _nextLineStart(f:file, style:iostyle, pos:int(64), end:int(64)) {
+  var err:syserr = ENOERR;
+  var r = new channel(false, iokind.dynamic, false, f, err, IOHINT_NONE, pos-1, end, style);
+  if err then try! ioerror(err, "in ItemReader.these", f.tryGetPath());
+
+  r.advancePastByte(0x0a, err);
+  if err then return end;
+
+  return r.offset();
+}
+
+// Divides start..end-1 into chunks beginning at line starts.  Returns the
+// (start, end) region of each chunk along with the id of the locale that
+// should read it: one that stores the chunk if the file system says so and
+// the home of the file otherwise.
+private proc _lineChunks(f:file, style:iostyle, start:int(64), end:int(64)) {
+  var n = 1;
+  if _isLinesStyle(style) then
+    n = max(1, min((end - start) / lineChunkMinBytes,
+                   4 * here.maxTaskPar * numLocales)):int;
+
+  var chunks:[0..#n] (int(64), int(64));
+  var owners:[0..#n] int;
+
+  on f.home {
+    const (lchunks, lowners) = _lineChunksHome(f, style, start, end, n);
+    chunks = lchunks;
+    owners = lowners;
+  }
+  return (chunks, owners);
+}
+
+// The part of _lineChunks that reads the file, run on its home.
+private proc _lineChunksHome(f:file, style:iostyle, start:int(64), end:int(64), n:int) {
+  var bounds:[0..n] int(64);
+  bounds[0] = start;
+  bounds[n] = end;
+  forall i in 1..n-1 do
+    bounds[i] = _nextLineStart(f, style, start + (end - start) * i / n, end);
+
+  var chunks:[0..#n] (int(64), int(64));
+  var owners:[0..#n] int = here.id;
+  forall i in 0..#n {
+    chunks[i] = (bounds[i], bounds[i+1]);
+
+    if numLocales > 1 && bounds[i] < bounds[i+1] {
+      const locs = f.localesForRegion(bounds[i], bounds[i+1]);
+      if locs.numIndices < numLocales {
+        const k = i % locs.numIndices;
+        for (loc, j) in zip(locs, 0..) do
+          if j == k then owners[i] = loc.id;
+      }
+    }
+  }
+  return (chunks, owners);
+}
+
+// Returns a file that can be read on this locale: f itself on its home and
+// otherwise f reopened by path, falling back to f if that fails.
+private proc _lineChunkFile(f:file):file {
+  if f.home == here then return f;
+
+  var err:syserr = ENOERR;
+  const path = f.tryGetPath();
+  var lf = open(err, path, iomode.r);
+  if err then return f;
+  return lf;
+}
+
+private iter _readLineChunk(f:file, style:iostyle, chunk) {
+  const (lo, hi) = chunk;
+  if lo < hi {
+    var err:syserr = ENOERR;
+    var r = new channel(false, iokind.dynamic, false, f, err, IOHINT_NONE, lo, hi, style);
+    if err then try! ioerror(err, "in ItemReader.these", f.tryGetPath());
+
+    while true {
+      var x:string;
+      var gotany:bool;
+      try! {
+        gotany = r.read(x);
+      }
+      if ! gotany then break;
+      yield x;
+    }
+  }
 }
 
 /* Create and return an :record:`ItemReader` that can yield read values of
@@ -4506,7 +4700,7 @@ proc file.localesForRegion(start:int(64), end:int(64)) {
 
   proc findloc(loc:string, locs:c_ptr(c_string), end:int) {
     for i in 0..end-1 {
-      if (loc == locs[i]) then
+      if (loc == locs[i]:string) then
         return true;
     }
     return false;
@@ -81,6 +81,19 @@
     In multilocale executions each top-level locale produces output
     to its own file, with a dot ('.') and the locale ID appended to
     this path.
+
+  The following config variable enables allocation sampling, which is
+  separate from memory tracking and cheap enough to leave on in
+  production runs.
+
+  ``memSample``: `uint`:
+    If this is set to a value greater than 0 (zero), sample roughly
+    one allocation per this many bytes allocated, and attribute it to
+    the source line and type of the allocation.  When the program
+    terminates normally, each locale writes a profile of the estimated
+    bytes allocated, allocation rate, and bytes still allocated per
+    call site to ``memLog``, as :proc:`printMemSampleProfile` does.
+    A value such as 524288 keeps the overhead small.
  */
 module Memory {
 
@@ -195,6 +208,21 @@ proc printMemAllocStats() {
   chpl_printMemAllocStats();
 }
 
+/*
+  Print the sampled allocation profile for every locale, with one line
+  per allocating call site: the number of samples taken there, the
+  estimated total bytes allocated, the estimated bytes still allocated,
+  and the allocation rate in bytes per second since the program
+  started.  The profile is written to ``memLog``.  Allocation sampling
+  must be enabled with ``--memSample``.
+ */
+proc printMemSampleProfile() {
+  pragma "insert line file info"
+  extern proc chpl_printMemSampleProfile();
+
+  for loc in Locales do on loc do chpl_printMemSampleProfile();
+}
+
 /*
   Start on-the-fly reporting of memory allocations and deallocations
   done on any locale.  Continue reporting until :proc:`stopVerboseMem`
@@ -708,79 +708,147 @@ module Random {
           x = r;
       }
 
-      /* Randomly shuffle a 1-D array. */
+      /* Randomly shuffle a 1-D array.
+
+         The shuffle runs in parallel and sorts the elements by a random
+         key drawn from this stream for each position, so for a given
+         seed the result does not depend on the number of tasks or
+         locales used.
+       */
       proc shuffle(arr: [?D] ?eltType ) {
+        use Aggregation;
 
         if D.rank != 1 then
           compilerError("Shuffle requires 1-D array");
 
-        const low = D.low,
-              high = D.high,
-              stride = D.stride;
+        const n = D.numIndices,
+              inds = D.dim(1);
+
+        // One key per position, in index order, like fillRandom()
+        var keys: [D] uint(64);
+        forall (k, r) in zip(keys, iterate(D, uint(64))) do
+          k = r;
+
+        // The positions are put in (key, position) order by a bucket sort
+        // on the high bits of the keys.  The key range is split into one
+        // part per target locale of D, and part p is sorted on locale p.
+        // The keys are uniform, so for a Block array most of the sorted
+        // positions of a part are on its locale.  How the key range is
+        // split has no effect on the result.
+        const numParts = D.targetLocales().size,
+              numSub = PCGRandomPrivate_numShuffleBuckets(n, numParts),
+              numBuckets = numParts * numSub;
+        var targetLocs: [0..#numParts] locale = D.targetLocales();
+
+        // Each locale counts its keys in each part ...
+        var partCounts: [0..#numParts, 0..#numParts] int;
+        coforall (loc, l) in zip(targetLocs, 0..) do on loc {
+          var myCounts: [0..#numParts] int;
+          for sd in D.localSubdomains() do
+            forall i in sd with (+ reduce myCounts) do
+              myCounts[PCGRandomPrivate_shuffleBucket(keys[i], numParts)] += 1;
+          partCounts[l, ..] = myCounts;
+        }
 
-        if parSafe then
-          PCGRandomStreamPrivate_lock$ = true;
+        // ... and the prefix sums say where a locale's keys for a part go
+        var starts: [0..#numParts, 0..#numParts] int,
+            partStarts: [0..numParts] int;
+        var total = 0;
+        for p in 0..#numParts {
+          partStarts[p] = total;
+          for l in 0..#numParts {
+            starts[l, p] = total;
+            total += partCounts[l, p];
+          }
+        }
+        partStarts[numParts] = total;
+
+        var sorted: [D] (uint(64), int);
+        coforall (loc, l) in zip(targetLocs, 0..) do on loc {
+          const myStarts = starts[l, ..];
+          var next: [0..#numParts] atomic int;
+          for p in 0..#numParts do
+            next[p].write(myStarts[p]);
+
+          var dst = new DstAggregator((uint(64), int));
+          for sd in D.localSubdomains() do
+            forall i in sd with (in dst) {
+              const k = keys[i],
+                    s = next[PCGRandomPrivate_shuffleBucket(k, numParts)].fetchAdd(1);
+              dst.copy(sorted[inds.orderToIndex(s)], (k, inds.indexOrder(i)));
+            }
+        }
 
-        // Fisher-Yates shuffle
-        for i in 0..#D.size by -1 {
-          var k = randlc_bounded(D.idxType,
-                                 PCGRandomStreamPrivate_rngs,
-                                 seed, PCGRandomStreamPrivate_count,
-                                 0, i);
-
-          var j = i;
-
-          // Strided case
-          if stride > 1 {
-            k *= stride;
-            j *= stride;
-          } else if stride < 0 {
-            k *= -stride;
-            j *= -stride;
+        // Each part is sorted on its locale: a counting sort into buckets,
+        // then each bucket is put in key order, which fixes the order the
+        // positions were claimed in above.  Ties go to the lower position.
+        coforall (loc, p) in zip(targetLocs, 0..) do on loc {
+          const lo = partStarts[p],
+                m = partStarts[p+1] - lo,
+                firstBucket = p * numSub;
+
+          var part: [0..#m] (uint(64), int);
+          var src = new SrcAggregator((uint(64), int));
+          forall t in 0..#m with (in src) do
+            src.copy(part[t], sorted[inds.orderToIndex(lo + t)]);
+
+          var counts: [0..#numSub] atomic int;
+          forall (k, _) in part do
+            counts[PCGRandomPrivate_shuffleBucket(k, numBuckets) - firstBucket].add(1);
+
+          var sizes: [0..#numSub] int;
+          forall (size, c) in zip(sizes, counts) do
+            size = c.read();
+
+          const ends = + scan sizes;
+          var next: [0..#numSub] atomic int;
+          forall b in 0..#numSub do
+            next[b].write(ends[b] - sizes[b]);
+
+          var bucketed: [0..#m] (uint(64), int);
+          forall x in part {
+            const b = PCGRandomPrivate_shuffleBucket(x(1), numBuckets) - firstBucket;
+            bucketed[next[b].fetchAdd(1)] = x;
           }
 
-          // Alignment offsets
-          k += low;
-          j += low;
+          forall b in 0..#numSub {
+            const bLo = ends[b] - sizes[b];
+            for s in bLo+1..ends[b]-1 {
+              const x = bucketed[s];
+              var t = s;
+              while t > bLo && x < bucketed[t-1] {
+                bucketed[t] = bucketed[t-1];
+                t -= 1;
+              }
+              bucketed[t] = x;
+            }
+          }
 
-          arr[k] <=> arr[j];
+          var dst = new DstAggregator((uint(64), int));
+          forall t in 0..#m with (in dst) do
+            dst.copy(sorted[inds.orderToIndex(lo + t)], bucketed[t]);
         }
 
-        PCGRandomStreamPrivate_count += high - low;
-
-        if parSafe then
-          PCGRandomStreamPrivate_lock$;
+        const old = arr;
+        var src = new SrcAggregator(eltType);
+        forall (a, (_, j)) in zip(arr, sorted) with (in src) do
+          src.copy(a, old[inds.orderToIndex(j)]);
       }
 
       /* Produce a random permutation, storing it in a 1-D array.
          The resulting array will include each value from low..high
          exactly once, where low and high refer to the array's domain.
+         Like :proc:`shuffle`, this runs in parallel and for a given
+         seed does not depend on the number of tasks or locales used.
          */
       proc permutation(arr: [] eltType) {
-        var low = arr.domain.dim(1).low;
-        var high = arr.domain.dim(1).high;
-
         if arr.domain.rank != 1 then
           compilerError("Permutation requires 1-D array");
-        //if arr.domain.dim(1).stridable then
-        //  compilerError("Permutation requires non-stridable 1-D array");
 
-        if parSafe then
-          PCGRandomStreamPrivate_lock$ = true;
-
-        for i in low..high {
-          var j = randlc_bounded(arr.domain.idxType,
-                                 PCGRandomStreamPrivate_rngs,
-                                 seed, PCGRandomStreamPrivate_count,
-                                 low, i);
-          arr[i] = arr[j];
-          arr[j] = i;
-        }
+        forall (a, i) in zip(arr, arr.domain) do
+          a = i;
 
-        PCGRandomStreamPrivate_count += high-low;
-
-        if parSafe then
-          PCGRandomStreamPrivate_lock$;
+        shuffle(arr);
       }
 
 
@@ -867,6 +935,20 @@ module Random {
     //
 
 
+    // Buckets per part for the sort in PCGRandomStream.shuffle.  They
+    // average 16 elements, and there are at most 2**32 in all.
+    private inline
+    proc PCGRandomPrivate_numShuffleBuckets(n: integral, numParts: int): int {
+      return min(max(n / (16 * numParts), 1), (1 << 32) / numParts): int;
+    }
+
+    // Maps a key to a bucket using its high 32 bits, so that
+    // bucket order agrees with key order
+    private inline
+    proc PCGRandomPrivate_shuffleBucket(k: uint(64), numBuckets: int): int {
+      return (((k >> 32) * numBuckets: uint(64)) >> 32): int;
+    }
+
     // returns a random number in [0, 1]
     // where the number is a multiple of 2**-64
     private inline
@@ -23,6 +23,7 @@
 // This is the type of the task private data used by the cache
 typedef struct {
   int64_t last_acquire; // cache acquire barrier sets this
+  void* last_cache;     // cache last_acquire refers to, NULL at task start
 } chpl_cache_taskPrvData_t;
 
 #endif
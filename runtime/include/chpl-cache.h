@@ -25,6 +25,33 @@
 #include "chpl-comm.h" // to get HAS_CHPL_CACHE_FNS via chpl-comm-task-decls.h
 #include "chpl-tasks.h"
 
+//
+// Remote cache statistics.  These are counted all the time (whenever
+// the cache is enabled) by each thread's cache and summed across
+// threads on request.  This record type is also defined in the
+// CommDiagnostics module, so the two definitions must match.
+//
+typedef struct _chpl_cacheDiagnostics {
+  uint64_t get_hits;         // GETs satisfied entirely from the cache
+  uint64_t get_partial_hits; // GETs finding some but not all lines cached
+  uint64_t get_misses;       // GETs finding none of their lines cached
+  uint64_t puts;             // PUTs stored into the cache
+  uint64_t dirty_flushes;    // dirty pages written back
+  uint64_t flush_puts;       // PUTs issued to write back dirty data
+  uint64_t flush_put_bytes;  // bytes written back by those PUTs
+  uint64_t readahead_issued; // pages requested by readahead
+  uint64_t readahead_used;   // readahead pages later read by a GET
+  uint64_t readahead_wasted; // readahead pages evicted without being read
+  uint64_t evict_ain;        // pages evicted from the Ain queue
+  uint64_t evict_aout;       // entries dropped from the Aout queue
+  uint64_t evict_am;         // pages evicted from the Am queue
+} chpl_cacheDiagnostics;
+
+// Sum the statistics from all threads' caches on this locale, since
+// the last reset.
+void chpl_cache_getDiagnosticsHere(chpl_cacheDiagnostics *cd);
+void chpl_cache_resetDiagnosticsHere(void);
+
 #ifdef HAS_CHPL_CACHE_FNS
 // This is a cache for remote data.
 
@@ -60,6 +87,47 @@ void chpl_cache_release(int ln, int32_t fn)
   if (chpl_cache_enabled()) chpl_cache_fence(0, 1, ln, fn);
 }
 
+// Tasking layers that can move a task from one thread to another call
+// these around every point where that can happen.  Before the task
+// leaves a thread, any puts it left in that thread's cache are
+// completed (a release); after it resumes on another thread, it does
+// an acquire on that thread's cache.  A task must not move while
+// chpl_cache_task_pinned() returns true, since it is in the middle of
+// a cache operation whose nonblocking handles belong to this thread.
+void chpl_cache_task_migrate_out_thread(void);
+void chpl_cache_task_migrate_in_thread(void);
+int chpl_cache_thread_busy(void);
+
+static inline
+void chpl_cache_task_migrate_out(void)
+{
+  if (chpl_cache_enabled()) chpl_cache_task_migrate_out_thread();
+}
+static inline
+void chpl_cache_task_migrate_in(void)
+{
+  if (chpl_cache_enabled()) chpl_cache_task_migrate_in_thread();
+}
+static inline
+int chpl_cache_task_pinned(void)
+{
+  return chpl_cache_enabled() && chpl_cache_thread_busy();
+}
+
+// Call before a point where the task may move to another thread.  If
+// the task is pinned this does nothing and returns false, and the
+// caller should keep the task on this thread where it can, say by
+// yielding the pthread instead of the task.  Otherwise it migrates the
+// task out and returns true, and the caller should call
+// chpl_cache_task_migrate_in() once the task runs again.
+static inline
+int chpl_cache_task_try_migrate_out(void)
+{
+  if (chpl_cache_task_pinned())
+    return 0;
+  chpl_cache_task_migrate_out();
+  return 1;
+}
 
 // These are the functions that the generated code should be eventually
 // calling on a put or a get.
@@ -87,6 +155,19 @@ void  chpl_cache_comm_put_strd(
 void chpl_cache_print(void);
 void chpl_cache_assert_released(void);
 
+#else
+// ifdef HAS_CHPL_CACHE_FNS
+
+// Without a cache, tasks are free to move between threads.
+static inline
+void chpl_cache_task_migrate_out(void) { }
+static inline
+void chpl_cache_task_migrate_in(void) { }
+static inline
+int chpl_cache_task_pinned(void) { return 0; }
+static inline
+int chpl_cache_task_try_migrate_out(void) { return 1; }
+
 #endif
 // ifdef HAS_CHPL_CACHE_FNS
 
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _chpl_comm_diags_h_
+#define _chpl_comm_diags_h_
+
+#ifndef LAUNCHER
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "chpltypes.h"
+#include "chpl-comm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//
+// Comm diagnostics.
+//
+// While comm diagnostics are enabled the comm layers count operations
+// in the chpl_commDiagnostics fields and also record, for each kind of
+// operation, the number of operations and bytes moved to or from each
+// remote locale, and a log2 histogram of the latencies of blocking
+// operations.  Bucket i of a histogram counts operations that took
+// from 2**i up to 2**(i+1) nanoseconds; the last bucket also counts
+// anything longer.
+//
+// Each thread records into its own blocks of counters, so recording
+// needs no locks or atomic read-modify-writes.  The blocks are summed
+// when the counts are retrieved.  Resetting records the current sums
+// as a baseline to subtract, so it doesn't have to write to other
+// threads' counters either.
+//
+// The op numbering here must match the commOp enum in
+// CommDiagnostics.chpl.
+//
+typedef enum {
+  chpl_comm_diags_get,
+  chpl_comm_diags_put,
+  chpl_comm_diags_get_nb,
+  chpl_comm_diags_put_nb,
+  chpl_comm_diags_get_strd,
+  chpl_comm_diags_put_strd,
+  chpl_comm_diags_amo,
+  chpl_comm_diags_execute_on,
+  chpl_comm_diags_execute_on_fast,
+  chpl_comm_diags_execute_on_nb,
+  chpl_comm_diags_num_ops
+} chpl_comm_diags_op_t;
+
+#define CHPL_COMM_DIAGS_LATENCY_BUCKETS 32
+
+//
+// Start time for a blocking operation whose latency is to be
+// recorded.  Never returns 0, which chpl_comm_diags_record() takes to
+// mean "no latency".
+//
+static inline
+uint64_t chpl_comm_diags_clock(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + (uint64_t) ts.tv_nsec + 1;
+}
+
+//
+// Record one operation of the given kind with the given remote locale,
+// moving the given number of bytes.  If startTime is nonzero it is a
+// chpl_comm_diags_clock() value from when the operation started, and
+// the operation's latency is added to the histogram for its kind.
+// The caller is responsible for checking that diagnostics are on.
+//
+void chpl_comm_diags_record(chpl_comm_diags_op_t op, c_nodeid_t node,
+                            size_t bytes, uint64_t startTime);
+
+//
+// Count one operation in this thread's operation counts, as in
+// "chpl_comm_diags_incr(put)".  The caller is responsible for checking
+// that diagnostics are on.
+//
+#define chpl_comm_diags_incr(field)                                     \
+  chpl_comm_diags_incr_count(offsetof(chpl_commDiagnostics, field)      \
+                             / sizeof(uint64_t))
+
+void chpl_comm_diags_incr_count(size_t i);
+
+//
+// The comm layers implement chpl_resetCommDiagnosticsHere() and
+// chpl_getCommDiagnosticsHere() with these.
+//
+void chpl_comm_diags_resetCountsHere(void);
+void chpl_comm_diags_getCountsHere(chpl_commDiagnostics* cd);
+
+//
+// These support CommDiagnostics.chpl.  The traffic arrays have
+// chpl_numNodes elements, indexed by remote locale.
+//
+void chpl_comm_diags_resetHere(void);
+void chpl_comm_diags_getTrafficHere(int op, uint64_t* ops, uint64_t* bytes);
+void chpl_comm_diags_getLatencyHere(int op, uint64_t* hist);
+
+#ifdef __cplusplus
+} // end extern "C"
+#endif
+
+#endif // LAUNCHER
+
+#endif // _chpl_comm_diags_h_
@@ -40,15 +40,15 @@ extern "C" {
 // CHPL_MEMHOOKS_ACTIVE will be set to 1 if CHPL_DEBUG is defined;
 // or if CHPL_OPTIMIZE is not defined.
 // If CHPL_OPTIMIZE is defined and CHPL_DEBUG is not defined,
-// we set CHPL_MEMHOOKS_ACTIVE to chpl_memTrack, so that memory tracking
-// can still be activated at run-time.
+// we set CHPL_MEMHOOKS_ACTIVE to chpl_memTrack || chpl_memSample, so
+// that memory tracking or sampling can still be activated at run-time.
 #ifndef CHPL_MEMHOOKS_ACTIVE
 
 #ifdef CHPL_DEBUG
 #define CHPL_MEMHOOKS_ACTIVE 1
 #else
 #ifdef CHPL_OPTIMIZE
-#define CHPL_MEMHOOKS_ACTIVE chpl_memTrack
+#define CHPL_MEMHOOKS_ACTIVE (chpl_memTrack || chpl_memSample)
 #else
 #define CHPL_MEMHOOKS_ACTIVE 1
 #endif
@@ -22,21 +22,59 @@
 #ifndef LAUNCHER
 #include <stdint.h>
 #include "chpltypes.h"
+#include "chpl-bitops.h"
+#include "chpl-atomics.h"
 
 void chpl_privatization_init(void);
 
 void chpl_newPrivatizedClass(void*, int64_t);
 
+//
+// The table of privatized objects is split into segments that double
+// in size: segment 0 holds pids 0..SEG0_SIZE-1, segment 1 the next
+// 2*SEG0_SIZE, and so on.  Segments are allocated as needed and never
+// move or go away, so lookups need no locking and growing the table
+// doesn't leave old copies behind.
+//
+#define CHPL_PRIVATIZATION_SEG0_BITS 6
+#define CHPL_PRIVATIZATION_SEG0_SIZE (INT64_C(1) << CHPL_PRIVATIZATION_SEG0_BITS)
+#define CHPL_PRIVATIZATION_NUM_SEGS  (64 - CHPL_PRIVATIZATION_SEG0_BITS)
+
+static inline int chpl_privatization_seg(int64_t i) {
+  uint64_t idx = (uint64_t) i + CHPL_PRIVATIZATION_SEG0_SIZE;
+  return 63 - (int) chpl_bitops_clz_64(idx) - CHPL_PRIVATIZATION_SEG0_BITS;
+}
+
+static inline int64_t chpl_privatization_segOffset(int64_t i, int seg) {
+  return i + CHPL_PRIVATIZATION_SEG0_SIZE
+         - (CHPL_PRIVATIZATION_SEG0_SIZE << seg);
+}
+
 // Implementation is here for performance: getPrivatizedClass can be called
 // frequently, so putting it in a header allows the backend to fully optimize.
-extern void** chpl_privateObjects;
+// The segment pointer is loaded with acquire ordering so that a segment
+// another task just allocated is seen fully zeroed.
+extern atomic_uintptr_t chpl_privateObjects[CHPL_PRIVATIZATION_NUM_SEGS];
 static inline void* chpl_getPrivatizedClass(int64_t i) {
-  return chpl_privateObjects[i];
+  int seg = chpl_privatization_seg(i);
+  void** segObjs =
+    (void**) atomic_load_explicit_uintptr_t(&chpl_privateObjects[seg],
+                                            memory_order_acquire);
+  return segObjs[chpl_privatization_segOffset(i, seg)];
 }
 
 void chpl_clearPrivatizedClass(int64_t);
 
 int64_t chpl_numPrivatizedClasses(void);
 
+//
+// Pids are handed out by locale 0.  Once an object has been cleared
+// on every locale its pid can be freed, and later allocations will
+// reuse it.
+//
+int64_t chpl_allocPrivatizedPid(void);
+
+void chpl_freePrivatizedPid(int64_t);
+
 #endif // LAUNCHER
 #endif // _chpl_privatization_h_
@@ -36,6 +36,9 @@ extern "C" {
 // Memory tracking activated?
 extern chpl_bool chpl_memTrack;
 
+// Allocation sampling activated?
+extern chpl_bool chpl_memSample;
+
 ///// These entry points support the memory tracking functions provided by
 //    MemTracking.chpl, and may also be called directly from user code (or from
 //    a debugger).
@@ -50,6 +53,7 @@ void chpl_printMemAllocs(int64_t threshold,
                          int32_t lineno, int32_t filename);
 void chpl_printMemAllocsByDesc(c_string descString, int64_t threshold,
                                int32_t lineno, int32_t filename);
+void chpl_printMemSampleProfile(int32_t lineno, int32_t filename);
 void chpl_startVerboseMem(void);
 void chpl_stopVerboseMem(void);
 void chpl_startVerboseMemHere(void);
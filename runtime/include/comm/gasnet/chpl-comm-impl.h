@@ -20,6 +20,8 @@
 #ifndef _chpl_comm_impl_h_
 #define _chpl_comm_impl_h_
 
+#include "chpl-comm-atomics.h"
+
 //
 // This is the comm layer sub-interface for dynamic allocation and
 // registration of memory.
@@ -29,6 +29,8 @@ typedef void* chpl_comm_nb_handle_t;
 
 typedef struct {
     chpl_cache_taskPrvData_t cache_data;
+    void* amo_unordered; // count of this task's unordered AMOs in flight,
+                         // allocated when it starts the first one
 } chpl_comm_taskPrvData_t;
 
 //
@@ -30,7 +30,8 @@
 #include "chpltypes.h"
 
 typedef struct {
-  int dummy;    // structs must be nonempty
+  void* amo_unordered; // count of this task's unordered AMOs in flight,
+                       // allocated when it starts the first one
 } chpl_comm_taskPrvData_t;
 
 //
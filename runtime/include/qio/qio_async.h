@@ -0,0 +1,60 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _QIO_ASYNC_H_
+#define _QIO_ASYNC_H_
+
+#include "sys_basic.h"
+#include "sys.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Asynchronous positional I/O used by QIO_METHOD_ASYNC.
+ *
+ * These have the same contract as sys_preadv and sys_pwritev
+ * (including returning EEOF for a read at end-of-file), but rather
+ * than blocking the calling thread in the system call they hand the
+ * request to a shared submission engine and yield the calling task
+ * until it completes.  That keeps the worker thread available for
+ * other tasks while the disk is busy.
+ *
+ * Two engines are supported:
+ *   - io_uring, on Linux kernels that provide it.  Requests from all
+ *     tasks are batched into one submission ring.
+ *   - a small pool of pthreads doing preadv/pwritev, used everywhere
+ *     else (and when io_uring setup fails).
+ *
+ * The engine is chosen on first use and can be forced with
+ * CHPL_RT_QIO_ASYNC_ENGINE=uring|threads.  The size of the fallback
+ * pool is CHPL_RT_QIO_ASYNC_THREADS (default 4).
+ */
+err_t qio_async_preadv(fd_t fd, const struct iovec* iov, int iovcnt, off_t seek_to_offset, ssize_t* num_read_out);
+err_t qio_async_pwritev(fd_t fd, const struct iovec* iov, int iovcnt, off_t seek_to_offset, ssize_t* num_written_out);
+
+// Returns "uring", "threads" or (if no helper threads could be started)
+// "sync", starting the engine if necessary.
+const char* qio_async_engine_name(void);
+
+#ifdef __cplusplus
+} // end extern "C"
+#endif
+
+#endif
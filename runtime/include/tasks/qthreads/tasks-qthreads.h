@@ -114,6 +114,9 @@ extern chpl_qthread_tls_t chpl_qthread_comm_task_tls;
 #define CHPL_TASK_STD_MODULES_INITIALIZED chpl_task_stdModulesInitialized
 void chpl_task_stdModulesInitialized(void);
 
+// Move the calling task to another shepherd.
+void chpl_qthread_migrate_to(qthread_shepherd_id_t shep);
+
 // Wrap qthread_get_tasklocal() and assert that it is always available.
 static inline chpl_qthread_tls_t* chpl_qthread_get_tasklocal(void)
 {
@@ -231,7 +234,7 @@ void chpl_task_setSubloc(c_sublocid_t full_subloc)
 
         if (execution_subloc != c_sublocid_any &&
             (qthread_shepherd_id_t) execution_subloc != curr_shep) {
-            qthread_migrate_to((qthread_shepherd_id_t) execution_subloc);
+            chpl_qthread_migrate_to((qthread_shepherd_id_t) execution_subloc);
         }
     }
 }
@@ -246,7 +249,8 @@ void chpl_task_setSubloc(c_sublocid_t full_subloc)
 #endif
 static inline
 int chpl_task_supportsRemoteCache(void) {
-  return CHPL_QTHREAD_SUPPORTS_REMOTE_CACHE;
+  // Tasks can move between workers, but we tell the cache when they do.
+  return 1;
 }
 
 #ifdef __cplusplus
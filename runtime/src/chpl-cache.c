@@ -158,10 +158,10 @@ remote address. The pointer tree uses separate chaining (ie, each hash table
 element is actually a linked list of elements that go into that bucket).
 
 The cache consists of 'cache entries', one per 'cache page'. A 'cache page' is
-1024 bytes in the current implementation. The pointer tree and the 2Q queues
+1024 bytes by default. The pointer tree and the 2Q queues
 consist of cache entries which may point to a 1024-byte cache page. However, a
-GET is always rounded up to entire 'cache line'. A cache line is currently 64
-bytes. Each cache entry tracks which cache lines are valid (ie, for which cache
+GET is always rounded up to entire 'cache line'. A cache line is 64
+bytes by default. Each cache entry tracks which cache lines are valid (ie, for which cache
 lines in the cache page have we done a GET?) and for pages that have been
 written to in a PUT - aka 'dirty pages' - which bytes in the page have been
 written to.
@@ -180,6 +180,18 @@ from an 8 byte request. We chose 1024 bytes for the cache page size because it
 is the smallest request size that allows close to peak bandwidth in our
 network.
 
+Since the best choice depends on the network and on the access pattern, the
+geometry can be chosen at program startup with these environment variables:
+
+  CHPL_RT_CACHE_PAGE_SIZE    cache page size in bytes (power of 2, 64..4k)
+  CHPL_RT_CACHE_LINE_SIZE    cache line size in bytes (power of 2, 8..page)
+  CHPL_RT_CACHE_MAX_PENDING  pending operations per cache (power of 2)
+  CHPL_RT_CACHE_SIZE         bytes of cached data per cache
+                             (by default, sized by the number of locales)
+  CHPL_RT_CACHE_READAHEAD    false to disable readahead
+  CHPL_RT_CACHE_READAHEAD_MAX_PAGES
+                             largest readahead window, in cache pages
+
 When processing a GET, we first check to see if the requested cache page is
 in the pointer tree. If not, we find an unused cache page and immediately start
 a nonblocking get into the appropriate portion of that page. While the get is
@@ -195,7 +207,13 @@ then by copying the newly gotten data out of the cache and into the request
 buffer.
 
 When processing GETs on adjacent memory locations, the cache triggers
-both synchronous and asynchronous read-ahead.
+both synchronous and asynchronous read-ahead. Each cache also tracks a few
+recent streams of cache misses. Once a stream's stride repeats, the cache reads
+ahead of it - for a sequential stream, by extending GETs to the end of the page
+and triggering asynchronous read-ahead when the page is used; for a strided
+stream, by prefetching the lines at the next few strides. The read-ahead window
+for a stream grows while the pages it reads ahead are used, and shrinks when
+they are evicted unused.
 
 When processing a PUT, we similarly check for the requested cache page in the
 pointer tree and use an unused page if not. We find a unused 'dirty entry' to
@@ -244,32 +262,29 @@ the sequence number of the last acquire barrier. If a task performs a GET but
 finds a cache entry with a minimum sequence number before its last acquire
 barrier, it must invalidate that cache line and do a new GET.
 
-Lastly, since the implementation uses thread-local storage for the cache, it
-requires that tasks not move between threads. Tasks could move between threads
-if we had a way to notify the cache that they were about to do so (in which
-case the cache would issue a release barrier in the old thread and an acquire
-barrier in the new thread). Another alternative would be to mark tasks with
-ongoing operations in the cache as not movable to other threads. A third option
-would be to only move tasks between threads in situations that create full
-barriers anyway; notably a full barrier occurs on task start and sync variable
-use.
+Lastly, since the implementation uses thread-local storage for the cache, a
+task that moves between threads must notify the cache that it is about to do
+so. The tasking layer calls chpl_cache_task_migrate_out() before any point
+where the task might be resumed on another thread, which issues a release
+barrier in the old thread, and chpl_cache_task_migrate_in() afterwards, which
+issues an acquire barrier in the new thread. Each task also records which
+cache its last acquire barrier refers to, so that a task that starts using a
+different thread's cache gets an acquire barrier there even if the tasking
+layer did not say it moved. A task in the middle of a cache operation is
+pinned to its thread (see chpl_cache_task_pinned()), since the nonblocking
+handles it might be waiting on are only valid in the thread that issued them.
 
  */
 
-// ASSUMES THAT TASKS DO NOT MIGRATE BETWEEN PTHREADS
-// because:
+// Tasks can migrate between pthreads, but only at points where the
+// tasking layer calls chpl_cache_task_migrate_out/_in, because:
 // 1) GASNet handles are only valid for a specific pthread
 // 2) want to avoid synchronization on the cache data structures
 //    but don't want to have 1 per task.
 //
-// If (1) is resolved, we could also weaken (2) by detecting
-// when task-local storage != thread-local storage.
-//
-// See chapel-developers thread "migrating tasks" from 9/25/2013.
 // FIFO: never moves a task from one pthread to another
-// massivethreads: may move a task with sync/wait/yield/etc
-// Qthreads workaround: QT_NUM_WORKERS_PER_SHEPHERD=1
-//   (on 9/26/2013 Dylan mentioned perhaps adding 'pin to worker')
+// massivethreads: may move a task at create/sync/yield
+// qthreads: may move a task at yield/sync (work stealing)
 
 #include "chplrt.h"
 #include "chpl-comm.h"
@@ -279,6 +294,8 @@ use.
 #include "chpl-thread-local-storage.h" // CHPL_TLS_DECL etc
 #include "chpl-cache.h"
 #include "chpl-linefile-support.h"
+#include "chpl-env.h" // chpl_env_rt_get_size() etc
+#include "error.h" // chpl_msg()
 #include "sys.h" // sys_page_size()
 #include "chpl-comm-compiler-macros.h"
 #include "chpl-comm-no-warning-macros.h" // No warnings for chpl_comm_get etc.
@@ -294,13 +311,27 @@ use.
 
 // We try to auto-size the cache so that we
 // can have CACHE_PAGES_PER_NODE cache pages per locale, but we
-// do so within the below bounds.
+// do so within the below bounds.  CHPL_RT_CACHE_SIZE overrides this
+// with an explicit number of bytes of cached data per cache.
 #define CACHE_PAGES_PER_NODE 4
 #define MIN_CACHE_DATA_SIZE (1024*1024)
 #define MAX_CACHE_DATA_SIZE (256*1024*1024)
+// The smallest cache we will create, in pages, when CHPL_RT_CACHE_SIZE
+// is set.
+#define MIN_CACHE_PAGES 64
+static size_t cache_data_size = 0; // 0 means auto-size
+
+// The cache geometry below is chosen at startup (in chpl_cache_do_init)
+// from CHPL_RT_CACHE_* environment variables and does not change after
+// that, so the variables holding it can be read without synchronization.
+// The statically sized structures use the MAX_ values.
 
 // How many pending operations can we have at once?
-#define MAX_PENDING 32
+// Set with CHPL_RT_CACHE_MAX_PENDING; must be a power of 2.
+#define DEFAULT_MAX_PENDING_BITS 5
+#define MAX_MAX_PENDING_BITS 12
+static unsigned int max_pending = 1 << DEFAULT_MAX_PENDING_BITS;
+#define MAX_PENDING max_pending
 
 // CACHEPAGE_BITS 
 // Controls the cache page size - the cache manages items of this many bytes
@@ -308,38 +339,72 @@ use.
 //
 // Reasonable values for CACHEPAGE_BITS are between 6 and 12
 // (64 bytes and 4k bytes. CACHEPAGE_BITS should not be larger than the
-// page size) and it must currently be even.
-// Here we set it to 1k bytes (ie 2^10).
-#define CACHEPAGE_BITS 10
+// page size).
+// By default we set it to 1k bytes (ie 2^10); CHPL_RT_CACHE_PAGE_SIZE
+// can select any power of 2 in that range.
+#define MIN_CACHEPAGE_BITS 6
+#define MAX_CACHEPAGE_BITS 12
+#define DEFAULT_CACHEPAGE_BITS 10
+static int cachepage_bits = DEFAULT_CACHEPAGE_BITS;
+#define CACHEPAGE_BITS cachepage_bits
 #define CACHEPAGE_SIZE (1 << CACHEPAGE_BITS)
 #define CACHEPAGE_MASK (CACHEPAGE_SIZE-1)
+#define MAX_CACHEPAGE_SIZE (1 << MAX_CACHEPAGE_BITS)
 
 // CACHELINE_BITS 
 // Controls the cache line size - that is, the minimum number of bytes
 // that are fetched for any 'get' operation.
 //
-// Reasonable values for CACHELINE_BITS are between 6 and CACHEPAGE_BITS.
-// Here we set it to 64 bytes (ie 2^6)
-#define CACHELINE_BITS 6
+// Reasonable values for CACHELINE_BITS are between 3 and CACHEPAGE_BITS.
+// By default we set it to 64 bytes (ie 2^6); CHPL_RT_CACHE_LINE_SIZE
+// can select a different power of 2.
+#define MIN_CACHELINE_BITS 3
+#define DEFAULT_CACHELINE_BITS 6
+static int cacheline_bits = DEFAULT_CACHELINE_BITS;
+#define CACHELINE_BITS cacheline_bits
 #define CACHELINE_SIZE (1 << CACHELINE_BITS)
 #define CACHELINE_MASK (CACHELINE_SIZE-1)
+#define MIN_CACHELINE_SIZE (1 << MIN_CACHELINE_BITS)
 
-// What type can store the number of cache lines in a cache page?
-typedef int8_t line_per_page_t; 
-// What type for a number of lines to read ahead?
-typedef int16_t readahead_distance_t;
+// What type for a number of bytes to read ahead?
+typedef int32_t readahead_distance_t;
 
 // When prefetching, what is the maximum number of pages
-// we are willing to prefetch? This is also the maximum
-// readahead window size for sequential access.
-#define MAX_PAGES_PER_PREFETCH 2
-
-// Should we enable sequential readahead?
-// For sequential access If we're reading  
-#define ENABLE_READAHEAD 1
+// we are willing to prefetch? This is also the largest
+// readahead window that the adaptive readahead below will grow to.
+// Set with CHPL_RT_CACHE_READAHEAD_MAX_PAGES.
+#define DEFAULT_MAX_PAGES_PER_PREFETCH 2
+static int max_pages_per_prefetch = DEFAULT_MAX_PAGES_PER_PREFETCH;
+#define MAX_PAGES_PER_PREFETCH max_pages_per_prefetch
+
+// Should we enable readahead?  CHPL_RT_CACHE_READAHEAD=false turns it off.
+// Readahead is triggered either within a page (when a get is adjacent
+// to already valid lines) or by the stream detector (see "readahead
+// streams" below), which recognizes sequential and strided miss patterns.
+static int enable_readahead = 1;
+#define ENABLE_READAHEAD enable_readahead
 #define ENABLE_READAHEAD_TRIGGER_WITHIN_PAGE 1
-#define ENABLE_READAHEAD_TRIGGER_SEQUENTIAL 0
-#define MAX_SEQUENTIAL_READAHEAD_BYTES (MAX_PAGES_PER_PREFETCH*CACHEPAGE_SIZE)
+#define ENABLE_READAHEAD_TRIGGER_STREAM 1
+
+// Readahead streams.
+// Each cache remembers the last few streams of cache misses. When the
+// distance between successive misses in a stream repeats, the stream is
+// confirmed and we read ahead of it: for sequential streams (stride no
+// larger than a cache page) by extending the current get to the end of the
+// page and chaining readahead triggers, and for strided streams by
+// prefetching the lines the next accesses will need.  Each stream has its
+// own window (in cache pages for a sequential stream, in strides for a
+// strided one). It grows by one when a page it read ahead gets used, up to
+// MAX_PAGES_PER_PREFETCH, and halves when such a page is evicted before
+// being used.
+#define READAHEAD_STREAMS 8
+// How many times must a stride repeat before we read ahead?
+#define READAHEAD_CONFIRM 2
+// How far apart (in cache pages) can misses be and still form a stream?
+#define READAHEAD_MAX_STRIDE_PAGES 64
+// Initial and minimum window for a new stream.
+#define READAHEAD_INITIAL_WINDOW 2
+#define READAHEAD_MIN_WINDOW 1
 
 //#define TIME
 //#define TRACE
@@ -432,7 +497,9 @@ struct rdcache_s;
 
 #define TOP_BITS 10
 #define BOTTOM_BITS 10
-#define OTHER_BITS ((64-TOP_BITS-BOTTOM_BITS-CACHEPAGE_BITS)/2)
+// Round up so that the top and bottom halves cover all 64 bits
+// even when CACHEPAGE_BITS is odd (they overlap by a bit in that case).
+#define OTHER_BITS ((64-TOP_BITS-BOTTOM_BITS-CACHEPAGE_BITS+1)/2)
 #define HALF_BITS (TOP_BITS+OTHER_BITS)
 
 #define TOP_SIZE (1 << TOP_BITS)
@@ -442,6 +509,7 @@ struct rdcache_s;
 // How many uint64_t words do we need to create a bitmask for CACHEPAGE_SIZE?
 // Divide # bytes in cache by 64, rounding up.
 #define CACHEPAGE_BITMASK_WORDS ((CACHEPAGE_SIZE+63)/64)
+#define MAX_CACHEPAGE_BITMASK_WORDS ((MAX_CACHEPAGE_SIZE+63)/64)
 
 // How many cache lines per cache page?
 #define CACHE_LINES_PER_PAGE (CACHEPAGE_SIZE/CACHELINE_SIZE)
@@ -449,6 +517,7 @@ struct rdcache_s;
 // How many uint64_t words do we need to create a bitmask for CACHE_LINES_PER_PAGE
 // ie, a mask recording a bit per cache line?
 #define CACHE_LINES_PER_PAGE_BITMASK_WORDS (((CACHEPAGE_SIZE/CACHELINE_SIZE)+63)/64)
+#define MAX_CACHE_LINES_PER_PAGE_BITMASK_WORDS (((MAX_CACHEPAGE_SIZE/MIN_CACHELINE_SIZE)+63)/64)
 
 struct cache_entry_base_s {
   uint32_t index_bits;
@@ -471,7 +540,7 @@ struct dirty_entry_s {
   // which cache entry are we talking about here?
   struct cache_entry_s* entry;
   // Which of the page's bytes are dirty?
-  uint64_t dirty[CACHEPAGE_BITMASK_WORDS]; // ie we need to create a put for these bytes
+  uint64_t dirty[MAX_CACHEPAGE_BITMASK_WORDS]; // ie we need to create a put for these bytes
 };
 
 #define QUEUE_FREE 0
@@ -501,6 +570,10 @@ struct cache_entry_s {
   // Readahead information.
   readahead_distance_t readahead_skip;
   readahead_distance_t readahead_len; // == 0 if this page doesn't trigger readahead.
+  // Which readahead stream brought this page in (-1 if none), and
+  // has the page been used since then?
+  int8_t readahead_stream;
+  int8_t readahead_unused;
   // These are the queue links. Am is LRU but Ain and Aout are FIFO
   struct cache_entry_s* next; // next entry in Ain/Aout/Am
   struct cache_entry_s* prev; // previous entry in An/Aout/Am
@@ -508,7 +581,7 @@ struct cache_entry_s {
   // This refers to CACHEPAGE_SIZE bytes of memory.
   unsigned char* page;
   // Which of the cache lines have we done 'get's for?
-  uint64_t valid_lines[CACHE_LINES_PER_PAGE_BITMASK_WORDS];
+  uint64_t valid_lines[MAX_CACHE_LINES_PER_PAGE_BITMASK_WORDS];
   // dirty info if this cache page is dirty, NULL otherwise.
   struct dirty_entry_s* dirty;
   // What is the minimum sequence number stored in this cache entry?
@@ -547,7 +620,7 @@ static int set_valid_lines(uint64_t* valid, uintptr_t skip, uintptr_t len)
 // Note skip/len are in line numbers, NOT byte offsets!
 static void unset_valid_lines(uint64_t* valid, uintptr_t skip, uintptr_t len)
 {
-  uint64_t myvalid[CACHE_LINES_PER_PAGE_BITMASK_WORDS];
+  uint64_t myvalid[MAX_CACHE_LINES_PER_PAGE_BITMASK_WORDS];
   unset_valids_for_skip_len(valid, myvalid, skip, len, CACHE_LINES_PER_PAGE_BITMASK_WORDS);  
 }
 /*
@@ -567,6 +640,43 @@ struct top_entry_s {
   struct cache_entry_s* bottom_index[BOTTOM_SIZE];
 };
 
+// A stream of cache misses, for readahead.
+struct readahead_stream_s {
+  c_nodeid_t node; // -1 if this slot is not in use
+  raddr_t last_line; // line address of the most recent access
+  intptr_t stride; // distance between accesses; 0 if not yet known
+  int confirmed; // how many times have we seen this stride?
+  int window; // readahead window (pages if sequential, strides if strided)
+  raddr_t next_ra; // next address a strided readahead would fetch
+  cache_seqn_t last_use; // for replacing the least recently used stream
+};
+
+// Per-cache statistics.  They are in the same order as the fields of
+// chpl_cacheDiagnostics.  Only the thread owning a cache updates them,
+// but any thread may sum them, so they are relaxed atomics.
+#define CACHE_STATS_NUM_FIELDS \
+  (sizeof(chpl_cacheDiagnostics) / sizeof(uint64_t))
+
+typedef struct {
+  atomic_uint_least64_t v[CACHE_STATS_NUM_FIELDS];
+} cache_stats_t;
+
+// Only the owning thread writes a cache's counters, so there is no
+// need for an atomic read-modify-write.
+static inline
+void cache_stat_add(cache_stats_t* s, size_t i, uint64_t n)
+{
+  uint64_t v = atomic_load_explicit_uint_least64_t(&s->v[i],
+                                                   memory_order_relaxed);
+  atomic_store_explicit_uint_least64_t(&s->v[i], v + n,
+                                       memory_order_relaxed);
+}
+
+#define CACHE_STAT_ADD(cache, field, n) \
+  cache_stat_add(&(cache)->stats, \
+                 offsetof(chpl_cacheDiagnostics, field) / sizeof(uint64_t), \
+                 (n))
+
 struct rdcache_s {
   // A 2Q cache.
   // See "2Q: A Low Overhead High Performance Buffer Management
@@ -579,10 +689,21 @@ struct rdcache_s {
   // request number for the last completed request.
   cache_seqn_t completed_request_number;
 
-  // Keep track of the raddr of the last cache miss read page in order
-  // to enable sequential readahead.
-  c_nodeid_t last_cache_miss_read_node;
-  raddr_t last_cache_miss_read_addr;
+  // Nonzero while a task is in the middle of a cache operation on this
+  // cache.  Such a task must not move to another thread, since the
+  // nonblocking handles it might be waiting on belong to this thread.
+  int busy;
+
+  // Statistics, only updated by the thread owning this cache.
+  cache_stats_t stats;
+  // All caches on this locale are linked together so that their
+  // statistics can be summed.
+  struct rdcache_s* stats_next;
+  struct rdcache_s* stats_prev;
+
+  // Recent streams of cache misses, in order to enable sequential
+  // and strided readahead.
+  struct readahead_stream_s readahead_streams[READAHEAD_STREAMS];
 
   // The variable names Ain Aout and Am come from the 2Q paper
 
@@ -671,6 +792,114 @@ struct rdcache_s {
 
 static void validate_cache(struct rdcache_s* tree);
 
+static inline
+intptr_t stride_abs(intptr_t stride)
+{
+  return (stride < 0) ? -stride : stride;
+}
+
+// Is this stride small enough that we handle the stream as sequential?
+static inline
+int readahead_stride_is_sequential(intptr_t stride)
+{
+  return -CACHEPAGE_SIZE <= stride && stride <= CACHEPAGE_SIZE;
+}
+
+// Record a demand cache miss at ra_line on node in the readahead streams.
+// Returns the index of the stream containing the miss if that stream is
+// confirmed (ie we should read ahead of it), or -1 otherwise.
+static
+int readahead_stream_miss(struct rdcache_s* cache,
+                          c_nodeid_t node, raddr_t ra_line)
+{
+  struct readahead_stream_s* s;
+  struct readahead_stream_s* closest = NULL;
+  struct readahead_stream_s* victim = NULL;
+  intptr_t max_stride = (intptr_t) CACHEPAGE_SIZE * READAHEAD_MAX_STRIDE_PAGES;
+  intptr_t d, closest_d = 0;
+  int same_direction;
+  int i;
+
+  for( i = 0; i < READAHEAD_STREAMS; i++ ) {
+    s = &cache->readahead_streams[i];
+    if( s->node == node ) {
+      d = (intptr_t) (ra_line - s->last_line);
+      same_direction = (d < 0) == (s->stride < 0);
+      // A sequential stream continues anywhere within the next page
+      // (readahead or cache hits may have covered the lines in between).
+      if( d == 0 ||
+          (s->stride != 0 && d == s->stride) ||
+          (s->stride != 0 && same_direction &&
+           readahead_stride_is_sequential(s->stride) &&
+           readahead_stride_is_sequential(d)) ) {
+        if( d != 0 ) {
+          s->confirmed++;
+          s->last_line = ra_line;
+        }
+        s->last_use = cache->next_request_number;
+        return (s->confirmed >= READAHEAD_CONFIRM) ? i : -1;
+      }
+      // Otherwise, this miss might establish a new stride for
+      // a stream that is not yet confirmed.
+      if( s->confirmed < READAHEAD_CONFIRM &&
+          -max_stride <= d && d <= max_stride &&
+          ( ! closest || stride_abs(d) < stride_abs(closest_d) ) ) {
+        closest = s;
+        closest_d = d;
+      }
+    }
+    // Replace an unused stream or else the least recently used one.
+    if( ! victim ||
+        ( victim->node >= 0 &&
+          ( s->node < 0 || s->last_use < victim->last_use ) ) ) {
+      victim = s;
+    }
+  }
+
+  if( closest ) {
+    closest->stride = closest_d;
+    closest->confirmed = 1;
+    closest->last_line = ra_line;
+    closest->next_ra = 0;
+    closest->last_use = cache->next_request_number;
+    return -1;
+  }
+
+  // Start a new stream.
+  victim->node = node;
+  victim->last_line = ra_line;
+  victim->stride = 0;
+  victim->confirmed = 0;
+  victim->window = READAHEAD_INITIAL_WINDOW;
+  victim->next_ra = 0;
+  victim->last_use = cache->next_request_number;
+  return -1;
+}
+
+// A page read ahead for this stream was used, so grow its window.
+static
+void readahead_stream_used(struct rdcache_s* cache, int stream)
+{
+  struct readahead_stream_s* s;
+
+  if( stream < 0 ) return;
+  s = &cache->readahead_streams[stream];
+  if( s->window < MAX_PAGES_PER_PREFETCH ) s->window++;
+}
+
+// A page read ahead for this stream was evicted without being used,
+// so shrink its window.
+static
+void readahead_stream_wasted(struct rdcache_s* cache, int stream)
+{
+  struct readahead_stream_s* s;
+
+  if( stream < 0 ) return;
+  s = &cache->readahead_streams[stream];
+  s->window /= 2;
+  if( s->window < READAHEAD_MIN_WINDOW ) s->window = READAHEAD_MIN_WINDOW;
+}
+
 
 static
 struct rdcache_s* cache_create(void) {
@@ -693,11 +922,17 @@ struct rdcache_s* cache_create(void) {
   unsigned char* buffer;
   unsigned char* pages;
 
-  cache_pages = CACHE_PAGES_PER_NODE * chpl_numNodes;
-  if( cache_pages < MIN_CACHE_DATA_SIZE/CACHEPAGE_SIZE )
-    cache_pages = MIN_CACHE_DATA_SIZE/CACHEPAGE_SIZE;
-  if( cache_pages > MAX_CACHE_DATA_SIZE/CACHEPAGE_SIZE )
-    cache_pages = MAX_CACHE_DATA_SIZE/CACHEPAGE_SIZE;
+  if( cache_data_size ) {
+    cache_pages = cache_data_size / CACHEPAGE_SIZE;
+    if( cache_pages < MIN_CACHE_PAGES )
+      cache_pages = MIN_CACHE_PAGES;
+  } else {
+    cache_pages = CACHE_PAGES_PER_NODE * chpl_numNodes;
+    if( cache_pages < MIN_CACHE_DATA_SIZE/CACHEPAGE_SIZE )
+      cache_pages = MIN_CACHE_DATA_SIZE/CACHEPAGE_SIZE;
+    if( cache_pages > MAX_CACHE_DATA_SIZE/CACHEPAGE_SIZE )
+      cache_pages = MAX_CACHE_DATA_SIZE/CACHEPAGE_SIZE;
+  }
 
   ain_pages = cache_pages / 4; // 2Q: "Kin should be 25% of page slots"
   aout_pages = cache_pages / 2; // 2Q: "Kout should hold identifiers for as
@@ -762,9 +997,15 @@ struct rdcache_s* cache_create(void) {
   // Now fill in everything else.
   c->next_request_number = 1;
   c->completed_request_number = 0;
-
-  c->last_cache_miss_read_node = -1;
-  c->last_cache_miss_read_addr = 0;
+  c->busy = 0;
+  for( i = 0; i < (int) CACHE_STATS_NUM_FIELDS; i++ )
+    atomic_init_uint_least64_t(&c->stats.v[i], 0);
+  c->stats_next = NULL;
+  c->stats_prev = NULL;
+
+  for( i = 0; i < READAHEAD_STREAMS; i++ ) {
+    c->readahead_streams[i].node = -1;
+  }
 
   c->max_pages = cache_pages;
   c->max_entries = n_entries;
@@ -1129,6 +1370,7 @@ void aout_evict(struct rdcache_s* cache)
   // Remove the tail element from Aout
   DOUBLE_REMOVE_TAIL(cache, aout);
   cache->aout_current--;
+  CACHE_STAT_ADD(cache, evict_aout, 1);
 
   // Remove entry (which we are kicking off of Aout) from the tree
   tree_remove(cache, z);
@@ -1170,6 +1412,7 @@ void ain_evict(struct rdcache_s* cache, struct cache_entry_s* dont_evict_me)
 
   DOUBLE_REMOVE_TAIL(cache, ain);
   cache->ain_current--;
+  CACHE_STAT_ADD(cache, evict_ain, 1);
 
   y->queue = QUEUE_AOUT;
 
@@ -1208,6 +1451,7 @@ void am_evict(struct rdcache_s *cache, struct cache_entry_s* dont_evict_me) {
 
   DOUBLE_REMOVE_TAIL(cache, am_lru);
   cache->am_current--;
+  CACHE_STAT_ADD(cache, evict_am, 1);
 
   // Remove this entry in Am from the pointer tree.
   tree_remove(cache, y);
@@ -1742,6 +1986,9 @@ void flush_entry(struct rdcache_s* cache, struct cache_entry_s* entry, int op,
           // Save the handle in the list of pending requests.
           entry->max_put_sequence_number = pending_push(cache, handle);
 
+          CACHE_STAT_ADD(cache, flush_puts, 1);
+          CACHE_STAT_ADD(cache, flush_put_bytes, got_len);
+
           // Move past this region of 1s in dirty bits.
           start = got_skip + got_len;
         }
@@ -1753,6 +2000,7 @@ void flush_entry(struct rdcache_s* cache, struct cache_entry_s* entry, int op,
         DOUBLE_PUSH_TAIL(cache, dirty, dirty_lru);
         // ... and decrement the number of dirty pages.
         cache->num_dirty_pages--;
+        CACHE_STAT_ADD(cache, dirty_flushes, 1);
       }
     }
   }
@@ -1776,6 +2024,8 @@ void flush_entry(struct rdcache_s* cache, struct cache_entry_s* entry, int op,
     if( len == CACHEPAGE_SIZE ) {
       entry->readahead_skip = 0;
       entry->readahead_len = 0;
+      entry->readahead_stream = -1;
+      entry->readahead_unused = 0;
       entry->min_sequence_number = NO_SEQUENCE_NUMBER;
       entry->max_put_sequence_number = NO_SEQUENCE_NUMBER;
       entry->max_prefetch_sequence_number = NO_SEQUENCE_NUMBER;
@@ -1787,6 +2037,13 @@ void flush_entry(struct rdcache_s* cache, struct cache_entry_s* entry, int op,
 
   // If evicting, remove the page from the cache and put it on a free list.
   if( op & FLUSH_DO_EVICT ) {
+    // If readahead brought this page in and nobody used it,
+    // that readahead stream is reading too far ahead.
+    if( entry->readahead_unused ) {
+      readahead_stream_wasted(cache, entry->readahead_stream);
+      entry->readahead_unused = 0;
+      CACHE_STAT_ADD(cache, readahead_wasted, 1);
+    }
     // But, our entry no longer can have a page associated with it.
     page = entry->page;
     entry->page = NULL;
@@ -1878,6 +2135,8 @@ struct cache_entry_s* make_entry(struct rdcache_s* tree,
     bottom_match->queue = QUEUE_AM;
     bottom_match->readahead_skip = 0;
     bottom_match->readahead_len = 0;
+    bottom_match->readahead_stream = -1;
+    bottom_match->readahead_unused = 0;
     // Set the page to the one the caller already allocated
     bottom_match->page = page;
     // Clear the valid lines
@@ -1904,6 +2163,8 @@ struct cache_entry_s* make_entry(struct rdcache_s* tree,
     bottom_tmp->queue = QUEUE_AIN;
     bottom_tmp->readahead_skip = 0;
     bottom_tmp->readahead_len = 0;
+    bottom_tmp->readahead_stream = -1;
+    bottom_tmp->readahead_unused = 0;
 
     bottom_tmp->next = NULL;
     bottom_tmp->prev = NULL;
@@ -1956,6 +2217,8 @@ void cache_put(struct rdcache_s* cache,
   if( size == 0 ) {
     return;
   }
+
+  CACHE_STAT_ADD(cache, puts, 1);
  
   // first_page = raddr of start of first needed page
   ra_first_page = round_down_to_mask(raddr, CACHEPAGE_MASK);
@@ -2089,6 +2352,7 @@ void cache_get(struct rdcache_s* cache,
                 c_nodeid_t node, raddr_t raddr, size_t size,
                 cache_seqn_t last_acquire,
                 int sequential_readahead_length,
+                int ra_stream,
                 int32_t commID, int ln, int32_t fn);
 
 static
@@ -2099,10 +2363,12 @@ void cache_get_trigger_readahead(struct rdcache_s* cache,
                                  // skip < 0 -> reverse, >0 -> forward
                                  readahead_distance_t skip,
                                  readahead_distance_t len,
+                                 int stream,
                                  cache_seqn_t last_acquire,
                                  int32_t commID, int ln, int32_t fn)
 {
   int next_ra_length;
+  int max_ra_length;
   int ok;
   raddr_t prefetch_start, prefetch_end;
   size_t page_size = 0;
@@ -2122,8 +2388,15 @@ void cache_get_trigger_readahead(struct rdcache_s* cache,
   if( ENABLE_READAHEAD && skip && ! is_congested(cache) ) {
     next_ra_length = 2 * len;
 
-    if( next_ra_length > MAX_SEQUENTIAL_READAHEAD_BYTES )
-      next_ra_length = MAX_SEQUENTIAL_READAHEAD_BYTES;
+    // The window for a detected stream adapts to how much of its
+    // readahead is used; other readahead uses the initial window.
+    if( stream >= 0 )
+      max_ra_length = cache->readahead_streams[stream].window * CACHEPAGE_SIZE;
+    else
+      max_ra_length = READAHEAD_INITIAL_WINDOW * CACHEPAGE_SIZE;
+
+    if( next_ra_length > max_ra_length )
+      next_ra_length = max_ra_length;
 
     if( skip < 0 )
       next_ra_length = - next_ra_length;
@@ -2160,11 +2433,11 @@ void cache_get_trigger_readahead(struct rdcache_s* cache,
           prefetch_len_page <= request_len_page ) {
         ok = 1;
       } else {
-        if( prefetch_page < request_page && len < 0 ) {
+        if( prefetch_page < request_page && skip < 0 ) {
           prefetch_start = request_page;
           ok = 1;
         }
-        if( prefetch_len_page > request_len_page && len > 0 ) {
+        if( prefetch_len_page > request_len_page && skip > 0 ) {
           prefetch_end = request_len_page+page_size;
           ok = 1;
         }
@@ -2182,27 +2455,26 @@ void cache_get_trigger_readahead(struct rdcache_s* cache,
                 prefetch_start, prefetch_end - prefetch_start,
                 last_acquire,
                 next_ra_length,
+                stream,
                 commID, ln, fn);
     } else {
-      // We could not prefetch, so record a cache miss so
-      //  that sequential prefetch will continue when we access
-      //  that region. We do this if the last cache miss was
-      //  within a system page of where we would like to prefetch.
+      // We could not prefetch, so move the stream up to where
+      //  we stopped so that sequential prefetch will continue when
+      //  we access that region.
       //  A possibly better approach here would be to add an entry to
       //  the tree structure indicating that when that entry is loaded,
       //  it should be prefetched...
 
-      if( len < 0 )
+      if( skip < 0 )
         miss_addr = prefetch_start + CACHELINE_SIZE;
       else
         miss_addr = prefetch_end - CACHELINE_SIZE;
 
-      if( cache->last_cache_miss_read_node == node &&
-          cache->last_cache_miss_read_addr <= prefetch_start + page_size &&
-          cache->last_cache_miss_read_addr + page_size >= prefetch_start ) {
+      if( stream >= 0 && cache->readahead_streams[stream].node == node ) {
         INFO_PRINT(("%i readahead saving miss read: %i:%p\n",
                (int) chpl_nodeID, node, (void*) miss_addr));
-        cache->last_cache_miss_read_addr = miss_addr;
+        cache->readahead_streams[stream].last_line =
+          round_down_to_mask(miss_addr, CACHELINE_MASK);
       }
       INFO_PRINT(("%i readahead stops: %i: %p %p\n",
                   (int) chpl_nodeID, node, (void*) prefetch_start, (void*) prefetch_end));
@@ -2210,6 +2482,48 @@ void cache_get_trigger_readahead(struct rdcache_s* cache,
   }
 }
 
+// Read ahead of a confirmed strided stream: prefetch len bytes at each
+// of the next 'window' strides past the most recent access that have
+// not been prefetched already.
+static
+void cache_readahead_strided(struct rdcache_s* cache, int stream,
+                             c_nodeid_t node, size_t len,
+                             cache_seqn_t last_acquire,
+                             int32_t commID, int ln, int32_t fn)
+{
+  struct readahead_stream_s* s = &cache->readahead_streams[stream];
+  intptr_t stride = s->stride;
+  raddr_t next_ra;
+  int i;
+
+  if( ! ENABLE_READAHEAD ) return;
+
+  // Start just past the last access unless we already prefetched beyond it.
+  next_ra = s->last_line + stride;
+  for( i = 1; i <= s->window; i++ ) {
+    if( s->next_ra == s->last_line + i * stride ) {
+      next_ra = s->next_ra;
+      break;
+    }
+  }
+
+  for( ; (intptr_t) (next_ra - s->last_line) / stride <= s->window;
+       next_ra += stride ) {
+    if( is_congested(cache) ) break;
+    // Unlike sequential readahead, we cannot assume that the next
+    // stride is still in the same object, so only prefetch memory that
+    // the comm layer knows is accessible.
+    if( ! chpl_comm_addr_gettable(node, (void*) next_ra, len) ) break;
+
+    INFO_PRINT(("%i strided readahead %i:%p len %i\n",
+                (int) chpl_nodeID, (int) node, (void*) next_ra, (int) len));
+    cache_get(cache, NULL /* prefetch */, node, next_ra, len,
+              last_acquire, 0, stream, commID, ln, fn);
+  }
+
+  s->next_ra = next_ra;
+}
+
 static
 int should_readahead_extend(uint64_t* valid,
                             uintptr_t skip, uintptr_t len )
@@ -2225,12 +2539,15 @@ int should_readahead_extend(uint64_t* valid,
 
 
 // If addr == NULL, this will prefetch.
+// ra_stream is the readahead stream this get is reading ahead for,
+// or -1 if it is not a readahead.
 static
 void cache_get(struct rdcache_s* cache,
                 unsigned char * addr,
                 c_nodeid_t node, raddr_t raddr, size_t size,
                 cache_seqn_t last_acquire,
                 int sequential_readahead_length,
+                int ra_stream,
                 int32_t commID, int ln, int32_t fn)
 {
   struct cache_entry_s* entry;
@@ -2247,10 +2564,19 @@ void cache_get(struct rdcache_s* cache,
   unsigned char* page;
   cache_seqn_t sn = NO_SEQUENCE_NUMBER;
   int isprefetch = (addr == NULL);
+  int isreadahead = isprefetch &&
+                    (sequential_readahead_length != 0 || ra_stream >= 0);
   int entry_after_acquire;
+  int some_data;
+  int any_hit = 0;
+  int any_missing = 0;
   chpl_comm_nb_handle_t handle;
   uintptr_t readahead_len, readahead_skip;
+  int readahead_stream;
   int ra;
+  int stream;
+  int strided_stream = -1;
+  size_t strided_len = 0;
 #ifdef TIME
   struct timespec start_get1, start_get2, wait1, wait2;
 #endif
@@ -2310,9 +2636,15 @@ void cache_get(struct rdcache_s* cache,
       has_data = check_valid_lines(entry->valid_lines,
                                    (ra_line - ra_page) >> CACHELINE_BITS,
                                    (ra_line_end - ra_line) >> CACHELINE_BITS);
+      // Or at least some of it?
+      some_data = entry_after_acquire &&
+                  any_valid_lines(entry->valid_lines,
+                                  (ra_line - ra_page) >> CACHELINE_BITS,
+                                  (ra_line_end - ra_line) >> CACHELINE_BITS);
     } else {
       entry_after_acquire = 1;
       has_data = 0;
+      some_data = 0;
     }
 
     //printf("%i entry is %p after_acquire %i has_data %i\n", chpl_nodeID, entry, entry_after_acquire, has_data);
@@ -2321,6 +2653,7 @@ void cache_get(struct rdcache_s* cache,
     // fetch the rest of the data in this page.
     readahead_skip = 0;
     readahead_len = 0;
+    readahead_stream = ra_stream;
     if( ENABLE_READAHEAD &&
         entry_after_acquire &&
         sequential_readahead_length == 0 &&
@@ -2334,25 +2667,24 @@ void cache_get(struct rdcache_s* cache,
                                  (ra_line - ra_page) >> CACHELINE_BITS,
                                  (ra_line_end - ra_line) >> CACHELINE_BITS);
         if( ra ) {
-          INFO_PRINT(("%i readahead trigger within-page direction=%i from %p to %p last %p\n",
-               (int) chpl_nodeID, ra, (void*) ra_line, (void*) ra_line_end, (void*) cache->last_cache_miss_read_addr));
+          INFO_PRINT(("%i readahead trigger within-page direction=%i from %p to %p\n",
+               (int) chpl_nodeID, ra, (void*) ra_line, (void*) ra_line_end));
         }
       }
      
-      if( ENABLE_READAHEAD_TRIGGER_SEQUENTIAL && ra == 0 &&
-          cache->last_cache_miss_read_node == node ) {
-        if(cache->last_cache_miss_read_addr < ra_line &&
-           ra_line <= cache->last_cache_miss_read_addr + CACHEPAGE_SIZE) {
-          // forward prefetch.
-          ra = 1;
-          INFO_PRINT(("%i readahead trigger forward from %p to %p last %p\n",
-                 (int) chpl_nodeID, (void*) ra_line, (void*) ra_line_end, (void*) cache->last_cache_miss_read_addr));
-        } else if(cache->last_cache_miss_read_addr > ra_line &&
-                  ra_line >= cache->last_cache_miss_read_addr - CACHEPAGE_SIZE) {
-          // reverse prefetch
-          ra = -1;
-          INFO_PRINT(("readahead trigger reverse from %p to %p last %p\n",
-                 (void*) ra_line, (void*) ra_line_end, (void*) cache->last_cache_miss_read_addr));
+      if( ENABLE_READAHEAD_TRIGGER_STREAM && ra == 0 && ! isprefetch ) {
+        stream = readahead_stream_miss(cache, node, ra_line);
+        if( stream >= 0 ) {
+          readahead_stream = stream;
+          if( readahead_stride_is_sequential(cache->readahead_streams[stream].stride) ) {
+            ra = (cache->readahead_streams[stream].stride > 0) ? 1 : -1;
+            INFO_PRINT(("%i readahead trigger stream %i direction=%i from %p to %p\n",
+                 (int) chpl_nodeID, stream, ra, (void*) ra_line, (void*) ra_line_end));
+          } else {
+            // Start strided readahead once this get is done.
+            strided_stream = stream;
+            strided_len = ra_line_end - ra_line;
+          }
         }
       }
 
@@ -2384,6 +2716,7 @@ void cache_get(struct rdcache_s* cache,
       }
 
       if( entry_after_acquire && has_data ) {
+        any_hit = 1;
         // Data is already in cache...  but to do a 'get' for previously
         // prefetched data, we might have to wait for it.
         if( !isprefetch ) {
@@ -2404,6 +2737,21 @@ void cache_get(struct rdcache_s* cache,
         // If the cache line is in Am, move it to the front of Am.
         use_entry(cache, entry);
         if( ! isprefetch ) {
+          // If readahead brought this page in, it was worthwhile.
+          if( entry->readahead_unused ) {
+            entry->readahead_unused = 0;
+            CACHE_STAT_ADD(cache, readahead_used, 1);
+            stream = entry->readahead_stream;
+            readahead_stream_used(cache, stream);
+            // Keep a strided stream going; its hits are not misses.
+            if( stream >= 0 &&
+                cache->readahead_streams[stream].node == node &&
+                ! readahead_stride_is_sequential(cache->readahead_streams[stream].stride) ) {
+              cache->readahead_streams[stream].last_line = ra_line;
+              strided_stream = stream;
+              strided_len = ra_line_end - ra_line;
+            }
+          }
       
           //printf("cache hit on page %i:%p %p ra_len %i\n", 
           //       node, (void*) ra_page, (void*) requested_start,
@@ -2420,6 +2768,7 @@ void cache_get(struct rdcache_s* cache,
             // we're starting the readahead now.
             readahead_skip = entry->readahead_skip;
             readahead_len = entry->readahead_len;
+            readahead_stream = entry->readahead_stream;
             entry->readahead_skip = 0;
             entry->readahead_len = 0;
 
@@ -2427,6 +2776,7 @@ void cache_get(struct rdcache_s* cache,
                                         raddr, size,
                                         readahead_skip,
                                         readahead_len,
+                                        readahead_stream,
                                         last_acquire,
                                         commID, ln, fn);
             entry = NULL; // note trigger readahead could evict entry...
@@ -2455,6 +2805,11 @@ void cache_get(struct rdcache_s* cache,
 
     // Otherwise -- start a get !
 
+    if( some_data ) any_hit = 1;
+    any_missing = 1;
+
+    if( isreadahead ) CACHE_STAT_ADD(cache, readahead_issued, 1);
+
     if( ! page ) {
       // get a page from the free list.
       page = allocate_page(cache);
@@ -2509,6 +2864,11 @@ void cache_get(struct rdcache_s* cache,
     // Set the minimum sequence number
     entry->min_sequence_number = seqn_min(entry->min_sequence_number, sn);
 
+    // Remember which readahead stream (if any) this page belongs to,
+    // and whether it still needs to be used for the readahead to pay off.
+    if( readahead_stream >= 0 ) entry->readahead_stream = readahead_stream;
+    entry->readahead_unused = isreadahead;
+
     // Decide what to store in the readahead trigger for this page
     // if we are currently doing a readahead.
     if( ENABLE_READAHEAD ) {
@@ -2537,13 +2897,6 @@ void cache_get(struct rdcache_s* cache,
       entry->readahead_len = readahead_len;
     }
 
-    // Update the last read location on a miss
-    // (as long as there was not an intervening acquire)
-    if( entry_after_acquire && sequential_readahead_length == 0 ) {
-      cache->last_cache_miss_read_node = node;
-      cache->last_cache_miss_read_addr = ra_line;
-    }
-
     // Make sure that there is an available page for next time,
     // but do it without evicting entry (that we are working with).
     // This could happen if entry is the last element of Ain..
@@ -2577,6 +2930,19 @@ void cache_get(struct rdcache_s* cache,
     }
   }
 
+  if( ! isprefetch ) {
+    if( ! any_missing ) CACHE_STAT_ADD(cache, get_hits, 1);
+    else if( any_hit ) CACHE_STAT_ADD(cache, get_partial_hits, 1);
+    else CACHE_STAT_ADD(cache, get_misses, 1);
+  }
+
+  // Now that we are no longer working with any particular entry,
+  // start any strided readahead.
+  if( strided_stream >= 0 ) {
+    cache_readahead_strided(cache, strided_stream, node, strided_len,
+                            last_acquire, commID, ln, fn);
+  }
+
   if( VERIFY ) validate_cache(cache);
 
 #ifdef DUMP
@@ -2673,11 +3039,77 @@ static struct rdcache_s* cache_create(void);
 CHPL_TLS_DECL(struct rdcache_s*,cache_remote_data);
 static pthread_key_t pthread_cache_info_key; // stores struct rdcache_s*
 
+// All of the caches on this locale, for statistics.  Statistics from
+// caches that have been destroyed are added into stats_retired, and
+// stats_reset holds the totals as of the last reset.
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct rdcache_s* stats_caches = NULL;
+static chpl_cacheDiagnostics stats_retired;
+static chpl_cacheDiagnostics stats_reset;
+
+static inline
+void cache_stats_add(chpl_cacheDiagnostics* sum, cache_stats_t* x)
+{
+  uint64_t* s = (uint64_t*) sum;
+  size_t i;
+
+  for( i = 0; i < CACHE_STATS_NUM_FIELDS; i++ )
+    s[i] += atomic_load_explicit_uint_least64_t(&x->v[i],
+                                                memory_order_relaxed);
+}
+
+static inline
+void cache_stats_sub(chpl_cacheDiagnostics* diff,
+                     const chpl_cacheDiagnostics* x)
+{
+  uint64_t* d = (uint64_t*) diff;
+  const uint64_t* v = (const uint64_t*) x;
+  size_t i;
+
+  for( i = 0; i < CACHE_STATS_NUM_FIELDS; i++ ) d[i] -= v[i];
+}
+
+static
+void cache_stats_register(struct rdcache_s* cache)
+{
+  pthread_mutex_lock(&stats_lock);
+  cache->stats_prev = NULL;
+  cache->stats_next = stats_caches;
+  if( stats_caches ) stats_caches->stats_prev = cache;
+  stats_caches = cache;
+  pthread_mutex_unlock(&stats_lock);
+}
+
+static
+void cache_stats_unregister(struct rdcache_s* cache)
+{
+  pthread_mutex_lock(&stats_lock);
+  cache_stats_add(&stats_retired, &cache->stats);
+  if( cache->stats_prev ) cache->stats_prev->stats_next = cache->stats_next;
+  else stats_caches = cache->stats_next;
+  if( cache->stats_next ) cache->stats_next->stats_prev = cache->stats_prev;
+  pthread_mutex_unlock(&stats_lock);
+}
+
+// Sum the statistics of all caches.  Other threads may be updating
+// their counters meanwhile, so this is only a snapshot.
+// Call with stats_lock held.
+static
+void cache_stats_total(chpl_cacheDiagnostics* total)
+{
+  struct rdcache_s* cache;
+
+  *total = stats_retired;
+  for( cache = stats_caches; cache; cache = cache->stats_next )
+    cache_stats_add(total, &cache->stats);
+}
+
 static
 struct rdcache_s* tls_cache_remote_data(void) {
   struct rdcache_s *cache = CHPL_TLS_GET(cache_remote_data);
   if( ! cache && chpl_cache_enabled() ) {
     cache = cache_create();
+    cache_stats_register(cache);
     CHPL_TLS_SET(cache_remote_data, cache);
     pthread_setspecific(pthread_cache_info_key, cache);
   }
@@ -2691,22 +3123,105 @@ chpl_cache_taskPrvData_t* task_private_cache_data(void)
   return &task_local->comm_data.cache_data;
 }
 
+// Make the calling task's last acquire refer to this thread's cache.
+// A task that last used another thread's cache has moved since then,
+// and sequence numbers from that cache mean nothing here, so it gets
+// an acquire fence on this cache.  A task that has not used the cache
+// yet keeps the (zero) last acquire it started with.
+static inline
+void task_use_cache(struct rdcache_s* cache,
+                    chpl_cache_taskPrvData_t* task_local)
+{
+  if( task_local->last_cache != cache ) {
+    if( task_local->last_cache != NULL ) {
+      TRACE_PRINT(("%d: task %d moved from cache %p to cache %p\n",
+                   chpl_nodeID, (int) chpl_task_getId(),
+                   task_local->last_cache, cache));
+      task_local->last_acquire = cache->next_request_number;
+      cache->next_request_number++;
+    }
+    task_local->last_cache = cache;
+  }
+}
+
 static
 void destroy_pthread_local_cache(void* arg)
 {
   struct rdcache_s* s = (struct rdcache_s*) arg;
+  cache_stats_unregister(s);
   cache_destroy(s);
 }
 
+// Returns log2 of the power-of-2 size in the CHPL_RT_ environment
+// variable ev, or dflt_bits if it is not set or not a power of 2
+// between 2^min_bits and 2^max_bits.
+static
+int cache_config_log2_size(const char* ev,
+                           int dflt_bits, int min_bits, int max_bits)
+{
+  size_t val = chpl_env_rt_get_size(ev, (size_t) 1 << dflt_bits);
+  int bits;
+
+  for( bits = min_bits; bits <= max_bits; bits++ ) {
+    if( val == ((size_t) 1 << bits) ) return bits;
+  }
+
+  chpl_msg(1,
+           "warning: CHPL_RT_%s must be a power of 2 between %zd and %zd, "
+           "assuming %zd\n",
+           ev, (size_t) 1 << min_bits, (size_t) 1 << max_bits,
+           (size_t) 1 << dflt_bits);
+  return dflt_bits;
+}
+
+// Choose the cache geometry and readahead settings.
+static
+void cache_config_init(void)
+{
+  int64_t max_ra_pages;
+
+  cachepage_bits = cache_config_log2_size("CACHE_PAGE_SIZE",
+                                          DEFAULT_CACHEPAGE_BITS,
+                                          MIN_CACHEPAGE_BITS,
+                                          MAX_CACHEPAGE_BITS);
+  cacheline_bits = cache_config_log2_size("CACHE_LINE_SIZE",
+                                          (DEFAULT_CACHELINE_BITS < cachepage_bits)?
+                                            DEFAULT_CACHELINE_BITS : cachepage_bits,
+                                          MIN_CACHELINE_BITS,
+                                          cachepage_bits);
+  max_pending = 1 << cache_config_log2_size("CACHE_MAX_PENDING",
+                                            DEFAULT_MAX_PENDING_BITS,
+                                            0, MAX_MAX_PENDING_BITS);
+
+  cache_data_size = chpl_env_rt_get_size("CACHE_SIZE", 0);
+
+  enable_readahead = chpl_env_rt_get_bool("CACHE_READAHEAD", true);
+
+  max_ra_pages = chpl_env_rt_get_int("CACHE_READAHEAD_MAX_PAGES",
+                                     DEFAULT_MAX_PAGES_PER_PREFETCH);
+  if( max_ra_pages < READAHEAD_MIN_WINDOW ) max_ra_pages = READAHEAD_MIN_WINDOW;
+  // Limit readahead to an eighth of the cache.
+  if( cache_data_size &&
+      max_ra_pages > cache_data_size / CACHEPAGE_SIZE / 8 )
+    max_ra_pages = cache_data_size / CACHEPAGE_SIZE / 8;
+  if( max_ra_pages < READAHEAD_MIN_WINDOW ) max_ra_pages = READAHEAD_MIN_WINDOW;
+  max_pages_per_prefetch = (int) max_ra_pages;
+}
+
 static
 void chpl_cache_do_init(void)
 {
   static int inited = 0;
   if( ! inited ) {
-  
+
+    cache_config_init();
+
     // Quick configuration check...
-    assert(OTHER_BITS+TOP_BITS+OTHER_BITS+BOTTOM_BITS+CACHEPAGE_BITS == 64);
-    assert(HALF_BITS + HALF_BITS + CACHEPAGE_BITS == 64);
+    assert(OTHER_BITS+TOP_BITS+OTHER_BITS+BOTTOM_BITS+CACHEPAGE_BITS >= 64);
+    assert(HALF_BITS + HALF_BITS + CACHEPAGE_BITS >= 64);
+    assert(HALF_BITS <= 32);
+    assert(CACHE_LINES_PER_PAGE_BITMASK_WORDS <=
+           MAX_CACHE_LINES_PER_PAGE_BITMASK_WORDS);
 
     // Otherwise, we will need some thread-local storage.
     // We create two versions: cache_remote_data stores
@@ -2770,14 +3285,18 @@ void chpl_cache_fence(int acquire, int release, int ln, int32_t fn)
     chpl_cache_print();
 #endif
 
+    task_use_cache(cache, task_local);
+
     if( acquire ) {
       task_local->last_acquire = cache->next_request_number;
       cache->next_request_number++;
     }
 
     if( release ) {
+      cache->busy++;
       cache_clean_dirty(cache);
       wait_all(cache);
+      cache->busy--;
     }
 #ifdef DUMP
     DEBUG_PRINT(("%d: task %d after fence\n", chpl_nodeID, (int) chpl_task_getId()));
@@ -2787,6 +3306,47 @@ void chpl_cache_fence(int acquire, int release, int ln, int32_t fn)
   // Do nothing if cache is not enabled.
 }
 
+void chpl_cache_task_migrate_out_thread(void)
+{
+  struct rdcache_s* cache = CHPL_TLS_GET(cache_remote_data);
+  chpl_cache_taskPrvData_t* task_local;
+
+  // Nothing to do if this thread has no cache.
+  if( ! cache ) return;
+
+  task_local = task_private_cache_data();
+
+  // Nothing to do if the task has not used this cache; if it has,
+  // complete its puts while we are still on the thread owning the
+  // nonblocking handles for them.  Puts from other tasks sharing the
+  // cache are not tracked separately, so this is a full release.
+  if( task_local->last_cache != cache ) return;
+
+  assert( ! cache->busy );
+
+  cache->busy++;
+  cache_clean_dirty(cache);
+  wait_all(cache);
+  cache->busy--;
+}
+
+void chpl_cache_task_migrate_in_thread(void)
+{
+  struct rdcache_s* cache = CHPL_TLS_GET(cache_remote_data);
+
+  // If this thread has no cache yet, the acquire happens when the
+  // task first uses it.
+  if( ! cache ) return;
+
+  task_use_cache(cache, task_private_cache_data());
+}
+
+int chpl_cache_thread_busy(void)
+{
+  struct rdcache_s* cache = CHPL_TLS_GET(cache_remote_data);
+  return cache != NULL && cache->busy;
+}
+
 void chpl_cache_comm_put(void* addr, c_nodeid_t node, void* raddr,
                          size_t size, int32_t typeIndex,
                          int32_t commID, int ln, int32_t fn)
@@ -2808,8 +3368,11 @@ void chpl_cache_comm_put(void* addr, c_nodeid_t node, void* raddr,
 
   //saturating_increment(&info->put_since_release);
   //task_local->last_op = seqn_max(cache, addr, node, raddr, size);
+  task_use_cache(cache, task_local);
+  cache->busy++;
   cache_put(cache, addr, node, (raddr_t)raddr, size, task_local->last_acquire,
             commID, ln, fn);
+  cache->busy--;
   return;
 }
 
@@ -2833,8 +3396,11 @@ void chpl_cache_comm_get(void *addr, c_nodeid_t node, void* raddr,
 #endif
 
   //saturating_increment(&info->get_since_acquire);
+  task_use_cache(cache, task_local);
+  cache->busy++;
   cache_get(cache, addr, node, (raddr_t)raddr, size, task_local->last_acquire,
-            0, commID, ln, fn);
+            0, -1, commID, ln, fn);
+  cache->busy--;
 
   return;
 }
@@ -2851,8 +3417,11 @@ void chpl_cache_comm_prefetch(c_nodeid_t node, void* raddr,
            chpl_lookupFilename(fn), ln, node);
   // Always use the cache for prefetches.
   //saturating_increment(&info->prefetch_since_acquire);
+  task_use_cache(cache, task_local);
+  cache->busy++;
   cache_get(cache, NULL, node, (raddr_t)raddr, size, task_local->last_acquire,
-            0, CHPL_COMM_UNKNOWN_ID, ln, fn);
+            0, -1, CHPL_COMM_UNKNOWN_ID, ln, fn);
+  cache->busy--;
 }
 void chpl_cache_comm_get_strd(void *addr, void *dststr, c_nodeid_t node,
                               void *raddr, void *srcstr, void *count,
@@ -2901,6 +3470,21 @@ void chpl_cache_comm_put_strd(void *addr, void *dststr, c_nodeid_t node,
 #endif
 }
 
+void chpl_cache_getDiagnosticsHere(chpl_cacheDiagnostics *cd)
+{
+  pthread_mutex_lock(&stats_lock);
+  cache_stats_total(cd);
+  cache_stats_sub(cd, &stats_reset);
+  pthread_mutex_unlock(&stats_lock);
+}
+
+void chpl_cache_resetDiagnosticsHere(void)
+{
+  pthread_mutex_lock(&stats_lock);
+  cache_stats_total(&stats_reset);
+  pthread_mutex_unlock(&stats_lock);
+}
+
 // This is for debugging.
 void chpl_cache_print(void)
 {
@@ -2941,6 +3525,18 @@ void chpl_cache_set_enabled(int enabled)
 }
 */
 
+#else
+// ifdef HAS_CHPL_CACHE_FNS
+
+// Without a cache there is nothing to count.
+void chpl_cache_getDiagnosticsHere(chpl_cacheDiagnostics *cd)
+{
+  memset(cd, 0, sizeof(*cd));
+}
+
+void chpl_cache_resetDiagnosticsHere(void)
+{
+}
+
 #endif
 // end ifdef HAS_CHPL_CACHE_FNS
-
@@ -0,0 +1,315 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Detailed comm diagnostics, shared by all the comm layers.  See
+// chpl-comm-diags.h.
+//
+#include "chplrt.h"
+
+#include "chpl-atomics.h"
+#include "chpl-comm.h"
+#include "chpl-comm-diags.h"
+#include "chpl-mem-sys.h"
+#include "chpl-tasks.h"
+#include "chpl-thread-local-storage.h"
+#include "error.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+
+
+//
+// The owning thread is the only writer of a block's counters, but other
+// threads read them when they sum the blocks, so the counters are
+// atomics.  The owner updates them with relaxed loads and stores, which
+// on the platforms we support are plain memory accesses.
+//
+//
+// chpl_commDiagnostics is nothing but uint64_t counters, so we count
+// and sum it as an array.
+//
+#define DIAGS_NUM_COUNTS (sizeof(chpl_commDiagnostics) / sizeof(uint64_t))
+
+typedef struct diags_block_s {
+  atomic_uint_least64_t counts[DIAGS_NUM_COUNTS];
+  // [op][node] operation and byte counts
+  atomic_uint_least64_t* ops;
+  atomic_uint_least64_t* bytes;
+  atomic_uint_least64_t
+    latency[chpl_comm_diags_num_ops][CHPL_COMM_DIAGS_LATENCY_BUCKETS];
+  struct diags_block_s* next;
+} diags_block_t;
+
+//
+// Sums of the blocks, only ever used by the thread holding diags_lock.
+//
+typedef struct diags_sums_s {
+  uint64_t* ops;
+  uint64_t* bytes;
+  uint64_t latency[chpl_comm_diags_num_ops][CHPL_COMM_DIAGS_LATENCY_BUCKETS];
+} diags_sums_t;
+
+CHPL_TLS_DECL(diags_block_t*, diags_my_block);
+
+static pthread_once_t diags_once = PTHREAD_ONCE_INIT;
+static chpl_sync_aux_t diags_lock;  // protects the list and the baseline
+static diags_block_t* diags_blocks;
+static diags_sums_t* diags_baseline;
+static chpl_commDiagnostics diags_counts_baseline;
+
+
+static diags_block_t* alloc_block(void) {
+  diags_block_t* b;
+  size_t n = (size_t) chpl_comm_diags_num_ops * chpl_numNodes;
+  size_t i;
+  int op, k;
+
+  if ((b = sys_calloc(1, sizeof(*b))) == NULL
+      || (b->ops = sys_malloc(n * sizeof(b->ops[0]))) == NULL
+      || (b->bytes = sys_malloc(n * sizeof(b->bytes[0]))) == NULL)
+    chpl_internal_error("cannot allocate comm diagnostics counters");
+
+  for (i = 0; i < n; i++) {
+    atomic_init_uint_least64_t(&b->ops[i], 0);
+    atomic_init_uint_least64_t(&b->bytes[i], 0);
+  }
+  for (i = 0; i < DIAGS_NUM_COUNTS; i++)
+    atomic_init_uint_least64_t(&b->counts[i], 0);
+  for (op = 0; op < chpl_comm_diags_num_ops; op++)
+    for (k = 0; k < CHPL_COMM_DIAGS_LATENCY_BUCKETS; k++)
+      atomic_init_uint_least64_t(&b->latency[op][k], 0);
+
+  return b;
+}
+
+
+static diags_sums_t* alloc_sums(void) {
+  diags_sums_t* s;
+  size_t n = (size_t) chpl_comm_diags_num_ops * chpl_numNodes;
+
+  if ((s = sys_calloc(1, sizeof(*s))) == NULL
+      || (s->ops = sys_calloc(n, sizeof(s->ops[0]))) == NULL
+      || (s->bytes = sys_calloc(n, sizeof(s->bytes[0]))) == NULL)
+    chpl_internal_error("cannot allocate comm diagnostics counters");
+  return s;
+}
+
+
+static void free_sums(diags_sums_t* s) {
+  sys_free(s->ops);
+  sys_free(s->bytes);
+  sys_free(s);
+}
+
+
+static void diags_init_once(void) {
+  chpl_sync_initAux(&diags_lock);
+  CHPL_TLS_INIT(diags_my_block);
+  diags_baseline = alloc_sums();
+}
+
+
+static void diags_init(void) {
+  pthread_once(&diags_once, diags_init_once);
+}
+
+
+static diags_block_t* my_block(void) {
+  diags_block_t* b;
+
+  diags_init();
+  b = (diags_block_t*) CHPL_TLS_GET(diags_my_block);
+  if (b == NULL) {
+    b = alloc_block();
+    chpl_sync_lock(&diags_lock);
+    b->next = diags_blocks;
+    diags_blocks = b;
+    chpl_sync_unlock(&diags_lock);
+    CHPL_TLS_SET(diags_my_block, b);
+  }
+
+  return b;
+}
+
+
+// Only the owning thread may add to a counter in its block.
+static inline void counter_add(atomic_uint_least64_t* c, uint64_t n) {
+  uint64_t v = atomic_load_explicit_uint_least64_t(c, memory_order_relaxed);
+  atomic_store_explicit_uint_least64_t(c, v + n, memory_order_relaxed);
+}
+
+
+static inline uint64_t counter_get(atomic_uint_least64_t* c) {
+  return atomic_load_explicit_uint_least64_t(c, memory_order_relaxed);
+}
+
+
+static int latency_bucket(uint64_t ns) {
+  int i = 0;
+  while (ns > 1 && i < CHPL_COMM_DIAGS_LATENCY_BUCKETS - 1) {
+    ns >>= 1;
+    i++;
+  }
+  return i;
+}
+
+
+void chpl_comm_diags_record(chpl_comm_diags_op_t op, c_nodeid_t node,
+                            size_t bytes, uint64_t startTime) {
+  diags_block_t* b = my_block();
+  size_t i = (size_t) op * chpl_numNodes + node;
+
+  counter_add(&b->ops[i], 1);
+  counter_add(&b->bytes[i], bytes);
+  if (startTime != 0) {
+    uint64_t now = chpl_comm_diags_clock();
+    counter_add(&b->latency[op][latency_bucket(now > startTime
+                                               ? now - startTime : 0)], 1);
+  }
+}
+
+
+void chpl_comm_diags_incr_count(size_t i) {
+  counter_add(&my_block()->counts[i], 1);
+}
+
+//
+// Sum the operation counts of all the threads' blocks, less the
+// baseline if asked, into *sum.  Caller holds diags_lock.
+//
+static void sum_counts(chpl_commDiagnostics* sum, chpl_bool subtractBaseline) {
+  uint64_t* s = (uint64_t*) sum;
+  uint64_t* c;
+  diags_block_t* b;
+  size_t i;
+
+  memset(sum, 0, sizeof(*sum));
+
+  for (b = diags_blocks; b != NULL; b = b->next) {
+    for (i = 0; i < DIAGS_NUM_COUNTS; i++)
+      s[i] += counter_get(&b->counts[i]);
+  }
+
+  if (subtractBaseline) {
+    c = (uint64_t*) &diags_counts_baseline;
+    for (i = 0; i < DIAGS_NUM_COUNTS; i++)
+      s[i] -= c[i];
+  }
+}
+
+
+void chpl_comm_diags_resetCountsHere(void) {
+  diags_init();
+  chpl_sync_lock(&diags_lock);
+  sum_counts(&diags_counts_baseline, false);
+  chpl_sync_unlock(&diags_lock);
+}
+
+
+void chpl_comm_diags_getCountsHere(chpl_commDiagnostics* cd) {
+  diags_init();
+  chpl_sync_lock(&diags_lock);
+  sum_counts(cd, true);
+  chpl_sync_unlock(&diags_lock);
+}
+
+
+//
+// Sum the counters of all the threads' blocks, less the baseline, into
+// *sum.  Caller holds diags_lock.
+//
+static void sum_blocks(diags_sums_t* sum, chpl_bool subtractBaseline) {
+  size_t n = (size_t) chpl_comm_diags_num_ops * chpl_numNodes;
+  diags_block_t* b;
+  size_t i;
+  int op, k;
+
+  memset(sum->ops, 0, n * sizeof(sum->ops[0]));
+  memset(sum->bytes, 0, n * sizeof(sum->bytes[0]));
+  memset(sum->latency, 0, sizeof(sum->latency));
+
+  for (b = diags_blocks; b != NULL; b = b->next) {
+    for (i = 0; i < n; i++) {
+      sum->ops[i] += counter_get(&b->ops[i]);
+      sum->bytes[i] += counter_get(&b->bytes[i]);
+    }
+    for (op = 0; op < chpl_comm_diags_num_ops; op++)
+      for (k = 0; k < CHPL_COMM_DIAGS_LATENCY_BUCKETS; k++)
+        sum->latency[op][k] += counter_get(&b->latency[op][k]);
+  }
+
+  if (subtractBaseline) {
+    for (i = 0; i < n; i++) {
+      sum->ops[i] -= diags_baseline->ops[i];
+      sum->bytes[i] -= diags_baseline->bytes[i];
+    }
+    for (op = 0; op < chpl_comm_diags_num_ops; op++)
+      for (k = 0; k < CHPL_COMM_DIAGS_LATENCY_BUCKETS; k++)
+        sum->latency[op][k] -= diags_baseline->latency[op][k];
+  }
+}
+
+
+void chpl_comm_diags_resetHere(void) {
+  diags_init();
+  chpl_sync_lock(&diags_lock);
+  sum_blocks(diags_baseline, false);
+  chpl_sync_unlock(&diags_lock);
+}
+
+
+void chpl_comm_diags_getTrafficHere(int op, uint64_t* ops, uint64_t* bytes) {
+  diags_sums_t* sum;
+
+  if (op < 0 || op >= chpl_comm_diags_num_ops)
+    chpl_internal_error("invalid comm diagnostics op");
+
+  diags_init();
+  sum = alloc_sums();
+  chpl_sync_lock(&diags_lock);
+  sum_blocks(sum, true);
+  chpl_sync_unlock(&diags_lock);
+
+  memcpy(ops, &sum->ops[(size_t) op * chpl_numNodes],
+         chpl_numNodes * sizeof(ops[0]));
+  memcpy(bytes, &sum->bytes[(size_t) op * chpl_numNodes],
+         chpl_numNodes * sizeof(bytes[0]));
+
+  free_sums(sum);
+}
+
+
+void chpl_comm_diags_getLatencyHere(int op, uint64_t* hist) {
+  diags_sums_t* sum;
+
+  if (op < 0 || op >= chpl_comm_diags_num_ops)
+    chpl_internal_error("invalid comm diagnostics op");
+
+  diags_init();
+  sum = alloc_sums();
+  chpl_sync_lock(&diags_lock);
+  sum_blocks(sum, true);
+  chpl_sync_unlock(&diags_lock);
+
+  memcpy(hist, sum->latency[op], sizeof(sum->latency[op]));
+
+  free_sums(sum);
+}
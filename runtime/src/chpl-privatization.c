@@ -19,71 +19,127 @@
 
 #include "chplrt.h"
 #include "chpl-privatization.h"
+#include "chpl-atomics.h"
 #include "chpl-mem.h"
 #include "chpl-tasks.h"
 
-static int64_t chpl_capPrivateObjects = 0;
+//
+// Registration, lookup and clearing are all lock-free.  The only lock
+// is for allocating a new segment, which happens at most
+// CHPL_PRIVATIZATION_NUM_SEGS times.
+//
 static chpl_sync_aux_t privatizationSync;
 
-void** chpl_privateObjects = NULL;
+atomic_uintptr_t chpl_privateObjects[CHPL_PRIVATIZATION_NUM_SEGS];
+
+//
+// Free pids form a stack on locale 0, linked through a table laid out
+// like chpl_privateObjects, so the slot of a free pid just stays NULL.
+// Pids are allocated and freed rarely compared to how often they are
+// looked up, so the stack is protected by a lock.  The head holds the
+// top pid plus one (0 means empty).
+//
+static chpl_sync_aux_t freePidsSync;
+static int64_t* freePidLinks[CHPL_PRIVATIZATION_NUM_SEGS];
+static atomic_int_least64_t freePidsHead;
+
+static atomic_int_least64_t nextPid;
 
 void chpl_privatization_init(void) {
-    chpl_sync_initAux(&privatizationSync);
+  chpl_sync_initAux(&privatizationSync);
+  chpl_sync_initAux(&freePidsSync);
+  for (int seg = 0; seg < CHPL_PRIVATIZATION_NUM_SEGS; seg++)
+    atomic_init_uintptr_t(&chpl_privateObjects[seg], (uintptr_t) NULL);
+  atomic_init_int_least64_t(&freePidsHead, 0);
+  atomic_init_int_least64_t(&nextPid, 0);
+}
+
+static void** get_slot(int64_t pid) {
+  int seg = chpl_privatization_seg(pid);
+  void** segObjs;
+
+  segObjs = (void**) atomic_load_explicit_uintptr_t(&chpl_privateObjects[seg],
+                                                     memory_order_acquire);
+  if (segObjs == NULL) {
+    chpl_sync_lock(&privatizationSync);
+    segObjs = (void**) atomic_load_uintptr_t(&chpl_privateObjects[seg]);
+    if (segObjs == NULL) {
+      segObjs = chpl_mem_allocManyZero(CHPL_PRIVATIZATION_SEG0_SIZE << seg,
+                                       sizeof(void *),
+                                       CHPL_RT_MD_COMM_PRV_OBJ_ARRAY, 0, 0);
+      atomic_store_explicit_uintptr_t(&chpl_privateObjects[seg],
+                                      (uintptr_t) segObjs,
+                                      memory_order_release);
+    }
+    chpl_sync_unlock(&privatizationSync);
+  }
+
+  return &segObjs[chpl_privatization_segOffset(pid, seg)];
 }
 
-static inline int64_t max(int64_t a, int64_t b) {
-  return a > b ? a : b;
+// Call with freePidsSync held.
+static int64_t* get_free_link(int64_t pid) {
+  int seg = chpl_privatization_seg(pid);
+
+  if (freePidLinks[seg] == NULL)
+    freePidLinks[seg] = chpl_mem_allocMany(CHPL_PRIVATIZATION_SEG0_SIZE << seg,
+                                           sizeof(int64_t),
+                                           CHPL_RT_MD_COMM_PRV_OBJ_ARRAY,
+                                           0, 0);
+
+  return &freePidLinks[seg][chpl_privatization_segOffset(pid, seg)];
 }
 
 // Note that this function can be called in parallel and more notably it can be
 // called with non-monotonic pid's. e.g. this may be called with pid 27, and
-// then pid 2, so it has to ensure that the privatized array has at least pid+1
-// elements. Be __very__ careful if you have to update it.
+// then pid 2, so it has to make sure the segment holding pid exists.
 void chpl_newPrivatizedClass(void* v, int64_t pid) {
-  chpl_sync_lock(&privatizationSync);
-
-  // initialize array to a default size
-  if (chpl_privateObjects == NULL) {
-    chpl_capPrivateObjects = 2*max(pid, 4);
-    chpl_privateObjects =
-        chpl_mem_allocManyZero(chpl_capPrivateObjects, sizeof(void *),
-                           CHPL_RT_MD_COMM_PRV_OBJ_ARRAY, 0, 0);
-  } else {
-    // if we're out of space, double (or more) the array size
-    if (pid >= chpl_capPrivateObjects) {
-      void** tmp;
-      int64_t oldCap;
-
-      oldCap = chpl_capPrivateObjects;
-      chpl_capPrivateObjects = 2*max(pid, oldCap);
-
-      tmp = chpl_mem_allocManyZero(chpl_capPrivateObjects, sizeof(void *),
-                                   CHPL_RT_MD_COMM_PRV_OBJ_ARRAY, 0, 0);
-      chpl_memcpy((void*)tmp, (void*)chpl_privateObjects, (oldCap)*sizeof(void*));
-      chpl_privateObjects = tmp;
-      // purposely leak old copies of chpl_privateObject to avoid the need to
-      // lock chpl_getPrivatizedClass; TODO: fix with lock free data structure
-    }
-  }
-  chpl_privateObjects[pid] = v;
-
-  chpl_sync_unlock(&privatizationSync);
+  *get_slot(pid) = v;
 }
 
 void chpl_clearPrivatizedClass(int64_t i) {
-  chpl_sync_lock(&privatizationSync);
-  chpl_privateObjects[i] = NULL;
-  chpl_sync_unlock(&privatizationSync);
+  *get_slot(i) = NULL;
 }
 
 // Used to check for leaks of privatized classes
 int64_t chpl_numPrivatizedClasses(void) {
   int64_t ret = 0;
-  chpl_sync_lock(&privatizationSync);
-  for (int64_t i = 0; i < chpl_capPrivateObjects; i++) {
-    if (chpl_privateObjects[i])
-      ret++;
+  for (int seg = 0; seg < CHPL_PRIVATIZATION_NUM_SEGS; seg++) {
+    void** segObjs = (void**) atomic_load_uintptr_t(&chpl_privateObjects[seg]);
+    if (segObjs == NULL)
+      break;
+    for (int64_t i = 0; i < (CHPL_PRIVATIZATION_SEG0_SIZE << seg); i++) {
+      if (segObjs[i] != NULL)
+        ret++;
+    }
   }
-  chpl_sync_unlock(&privatizationSync);
   return ret;
 }
+
+int64_t chpl_allocPrivatizedPid(void) {
+  if (atomic_load_int_least64_t(&freePidsHead) != 0) {
+    int64_t pid = -1;
+
+    chpl_sync_lock(&freePidsSync);
+    {
+      int64_t head = atomic_load_int_least64_t(&freePidsHead);
+      if (head != 0) {
+        pid = head - 1;
+        atomic_store_int_least64_t(&freePidsHead, *get_free_link(pid));
+      }
+    }
+    chpl_sync_unlock(&freePidsSync);
+
+    if (pid >= 0)
+      return pid;
+  }
+
+  return atomic_fetch_add_int_least64_t(&nextPid, 1);
+}
+
+void chpl_freePrivatizedPid(int64_t pid) {
+  chpl_sync_lock(&freePidsSync);
+  *get_free_link(pid) = atomic_load_int_least64_t(&freePidsHead);
+  atomic_store_int_least64_t(&freePidsHead, pid + 1);
+  chpl_sync_unlock(&freePidsSync);
+}
@@ -20,6 +20,7 @@
 #include "chplrt.h"
 
 #include "chplmemtrack.h"
+#include "chpl-atomics.h"
 #include "chpl-mem.h"
 #include "chpl-mem-desc.h"
 #include "chpl-mem-sys.h"  // mem layer not initialized yet, need system alloc
@@ -28,6 +29,8 @@
 #include "chpl-comm.h"
 #include "chplcgfns.h"
 #include "chpl-linefile-support.h"
+#include "chpl-thread-local-storage.h"
+#include "chpltimers.h"
 #include "config.h"
 #include "error.h"
 
@@ -45,6 +48,8 @@ static void
 printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
                int32_t lineno, int32_t filename);
 
+static void memSampleInit(void);
+
 
 //
 // This is in the modules, in MemTracking.chpl.
@@ -57,9 +62,11 @@ extern void chpl_memTracking_returnConfigVals(chpl_bool* memTrack,
                                               size_t* memMax,
                                               size_t* memThreshold,
                                               c_string* memLog,
-                                              c_string* memLeaksLog);
+                                              c_string* memLeaksLog,
+                                              size_t* memSample);
 
 chpl_bool chpl_memTrack = false;
+chpl_bool chpl_memSample = false;
 
 typedef struct memTableEntry_struct { /* table entry */
   size_t number;
@@ -77,10 +84,35 @@ static int hashSizes[NUM_HASH_SIZE_INDICES] = { 1543, 3079, 6151, 12289, 24593,
                                                 196613, 393241, 786433, 1572869, 3145739,
                                                 6291469, 12582917, 25165843, 50331653,
                                                 100663319, 201326611, 402653189, 805306457 };
-static int hashSizeIndex = 0;
-static int hashSize = 0;
 
-static memTableEntry** memTable = NULL;
+//
+// The table is split into shards by address hash, each with its own
+// lock, hash table and statistics, so that allocations and frees in
+// different threads rarely contend and a resize only rehashes one
+// shard.  The statistics are merged when they are reported.
+//
+#define NUM_SHARDS_BITS 6
+#define NUM_SHARDS (1 << NUM_SHARDS_BITS)
+
+typedef struct {
+  size_t allocated;   /* total memory allocated */
+  size_t freed;       /* total memory freed */
+  size_t entries;     /* number of entries in hash table */
+  char pad[64 - 3 * sizeof(size_t)];
+} memShardStats;
+
+typedef struct {
+  chpl_sync_aux_t sync;
+  int hashSizeIndex;
+  int hashSize;
+  memTableEntry** table;
+  int64_t unflushed;  /* change in memory not yet added to totalMem */
+} memShard;
+
+static memShard shards[NUM_SHARDS];
+
+// These are read by other locales, so they need to be plain data.
+static memShardStats shardStats[NUM_SHARDS];
 
 static _Bool memStats = false;
 static _Bool memLeaksByType = false;
@@ -91,13 +123,26 @@ static size_t memThreshold = 0;
 static c_string memLog = NULL;
 static FILE* memLogFile = NULL;
 static c_string memLeaksLog = NULL;
+static size_t memSample = 0;
 
-static size_t totalMem = 0;       /* total memory currently allocated */
+//
+// Updating a global total on every allocation and free would make all
+// the threads contend for it, so each shard collects its changes and
+// only adds them to totalMem once they reach memQuantum bytes either
+// way.  totalMem is thus within NUM_SHARDS * memQuantum of the actual
+// total, which is good enough for enforcing memMax and maintaining the
+// high-water mark.  The exact total is the sum of the shards' stats,
+// and the reports use it too.  The high-water mark is read by other
+// locales, so it is a plain variable updated under a lock.
+//
+static int64_t memQuantum = 64 * 1024;
+static atomic_int_least64_t totalMem;
 static size_t maxMem = 0;         /* maximum total memory during run  */
-static size_t totalAllocated = 0; /* total memory allocated */
-static size_t totalFreed = 0;     /* total memory freed */
-static size_t totalEntries = 0;     /* number of entries in hash table */
+static chpl_sync_aux_t maxMem_sync;
 
+//
+// Serializes reports.
+//
 static chpl_sync_aux_t memTrack_sync;
 
 
@@ -127,7 +172,8 @@ void chpl_setMemFlags(void) {
                                     &memMax,
                                     &memThreshold,
                                     &memLog,
-                                    &memLeaksLog);
+                                    &memLeaksLog,
+                                    &memSample);
 
   if (local_memTrack
       || memStats
@@ -153,78 +199,120 @@ void chpl_setMemFlags(void) {
   }
 
   if (chpl_memTrack) {
+    int i;
+
     chpl_sync_initAux(&memTrack_sync);
-    hashSizeIndex = 0;
-    hashSize = hashSizes[hashSizeIndex];
-    memTable = sys_calloc(hashSize, sizeof(memTableEntry*));
+    chpl_sync_initAux(&maxMem_sync);
+    atomic_init_int_least64_t(&totalMem, 0);
+    // Keep memMax from being overshot by more than a quarter.
+    if (memMax > 0 && memMax / (4 * NUM_SHARDS) < (size_t) memQuantum)
+      memQuantum = (int64_t) (memMax / (4 * NUM_SHARDS));
+    for (i = 0; i < NUM_SHARDS; i++) {
+      chpl_sync_initAux(&shards[i].sync);
+      shards[i].hashSizeIndex = 0;
+      shards[i].hashSize = hashSizes[0];
+      shards[i].table = sys_calloc(shards[i].hashSize, sizeof(memTableEntry*));
+      shards[i].unflushed = 0;
+    }
+  }
+
+  if (memSample > 0) {
+    memSampleInit();
+    chpl_memSample = true;
   }
 }
 
 
-static unsigned hash(void* memAlloc, int hashSize) {
-  unsigned hashValue = 0;
-  char* fakeCharPtr = (char*)&memAlloc;
-  size_t i;
-  for (i = 0; i < sizeof(void*); i++) {
-    hashValue = *fakeCharPtr + 31 * hashValue;
-    fakeCharPtr++;
-  }
-  return hashValue % hashSize;
+static uint64_t hash(void* memAlloc) {
+  uint64_t hashValue = (uint64_t) (uintptr_t) memAlloc;
+  hashValue ^= hashValue >> 33;
+  hashValue *= UINT64_C(0xff51afd7ed558ccd);
+  hashValue ^= hashValue >> 33;
+  return hashValue;
 }
 
 
-static void increaseMemStat(size_t chunk, int32_t lineno, int32_t filename) {
-  totalMem += chunk;
-  totalAllocated += chunk;
-  if (memMax && (totalMem > memMax)) {
+static int shardIndex(void* memAlloc) {
+  return (int) (hash(memAlloc) >> (64 - NUM_SHARDS_BITS));
+}
+
+
+// assumes the shard's lock is held
+static void increaseMemStat(int shard, size_t chunk,
+                            int32_t lineno, int32_t filename) {
+  memShard* sh = &shards[shard];
+  size_t newTotal;
+
+  shardStats[shard].allocated += chunk;
+  sh->unflushed += chunk;
+  if (sh->unflushed < memQuantum)
+    return;
+
+  newTotal = (size_t) atomic_fetch_add_int_least64_t(&totalMem, sh->unflushed)
+             + sh->unflushed;
+  sh->unflushed = 0;
+  if (memMax && (newTotal > memMax)) {
     chpl_error("Exceeded memory limit", lineno, filename);
   }
-  if (totalMem > maxMem)
-    maxMem = totalMem;
+  chpl_sync_lock(&maxMem_sync);
+  if (newTotal > maxMem)
+    maxMem = newTotal;
+  chpl_sync_unlock(&maxMem_sync);
 }
 
 
-static void decreaseMemStat(size_t chunk) {
-  totalMem -= chunk; // > totalMem ? 0 : totalMem - chunk;
-  totalFreed += chunk;
+// assumes the shard's lock is held
+static void decreaseMemStat(int shard, size_t chunk) {
+  memShard* sh = &shards[shard];
+
+  shardStats[shard].freed += chunk;
+  sh->unflushed -= chunk;
+  if (sh->unflushed <= -memQuantum) {
+    (void) atomic_fetch_add_int_least64_t(&totalMem, sh->unflushed);
+    sh->unflushed = 0;
+  }
 }
 
 
 static void
-resizeTable(int direction) {
+resizeTable(memShard* sh, int direction) {
   memTableEntry** newMemTable = NULL;
   int newHashSizeIndex, newHashSize, newHashValue;
   int i;
   memTableEntry* me;
   memTableEntry* next;
 
-  newHashSizeIndex = hashSizeIndex + direction;
+  newHashSizeIndex = sh->hashSizeIndex + direction;
   newHashSize = hashSizes[newHashSizeIndex];
   newMemTable = sys_calloc(newHashSize, sizeof(memTableEntry*));
 
-  for (i = 0; i < hashSize; i++) {
-    for (me = memTable[i]; me != NULL; me = next) {
+  for (i = 0; i < sh->hashSize; i++) {
+    for (me = sh->table[i]; me != NULL; me = next) {
       next = me->nextInBucket;
-      newHashValue = hash(me->memAlloc, newHashSize);
+      newHashValue = hash(me->memAlloc) % newHashSize;
       me->nextInBucket = newMemTable[newHashValue];
       newMemTable[newHashValue] = me;
     }
   }
 
-  sys_free(memTable);
-  memTable = newMemTable;
-  hashSize = newHashSize;
-  hashSizeIndex = newHashSizeIndex;
+  sys_free(sh->table);
+  sh->table = newMemTable;
+  sh->hashSize = newHashSize;
+  sh->hashSizeIndex = newHashSizeIndex;
 }
 
-static void addMemTableEntry(void *memAlloc, size_t number, size_t size,
+// assumes the shard's lock is held
+static void addMemTableEntry(int shard, void *memAlloc,
+                             size_t number, size_t size,
                              chpl_mem_descInt_t description, int32_t lineno,
                              int32_t filename) {
+  memShard* sh = &shards[shard];
   unsigned hashValue;
   memTableEntry* memEntry;
 
-  if ((totalEntries+1)*2 > hashSize && hashSizeIndex < NUM_HASH_SIZE_INDICES-1)
-    resizeTable(1);
+  if ((shardStats[shard].entries+1)*2 > sh->hashSize
+      && sh->hashSizeIndex < NUM_HASH_SIZE_INDICES-1)
+    resizeTable(sh, 1);
 
   memEntry = (memTableEntry*) sys_calloc(1, sizeof(memTableEntry));
   if (!memEntry) {
@@ -232,33 +320,35 @@ static void addMemTableEntry(void *memAlloc, size_t number, size_t size,
                lineno, filename);
   }
 
-  hashValue = hash(memAlloc, hashSize);
-  memEntry->nextInBucket = memTable[hashValue];
-  memTable[hashValue] = memEntry;
+  hashValue = hash(memAlloc) % sh->hashSize;
+  memEntry->nextInBucket = sh->table[hashValue];
+  sh->table[hashValue] = memEntry;
   memEntry->description = description;
   memEntry->memAlloc = memAlloc;
   memEntry->lineno = lineno;
   memEntry->filename = filename;
   memEntry->number = number;
   memEntry->size = size;
-  increaseMemStat(number*size, lineno, filename);
-  totalEntries += 1;
+  increaseMemStat(shard, number*size, lineno, filename);
+  shardStats[shard].entries += 1;
 }
 
 
-static memTableEntry* removeMemTableEntry(void* address) {
-  unsigned hashValue = hash(address, hashSize);
-  memTableEntry* thisBucketEntry = memTable[hashValue];
+// assumes the shard's lock is held
+static memTableEntry* removeMemTableEntry(int shard, void* address) {
+  memShard* sh = &shards[shard];
+  unsigned hashValue = hash(address) % sh->hashSize;
+  memTableEntry* thisBucketEntry = sh->table[hashValue];
   memTableEntry* deletedBucket = NULL;
 
   if (!thisBucketEntry)
     return NULL;
 
   if (thisBucketEntry->memAlloc == address) {
-    memTable[hashValue] = thisBucketEntry->nextInBucket;
+    sh->table[hashValue] = thisBucketEntry->nextInBucket;
     deletedBucket = thisBucketEntry;
   } else {
-    for (thisBucketEntry = memTable[hashValue];
+    for (thisBucketEntry = sh->table[hashValue];
          thisBucketEntry != NULL;
          thisBucketEntry = thisBucketEntry->nextInBucket) {
 
@@ -271,15 +361,321 @@ static memTableEntry* removeMemTableEntry(void* address) {
     }
   }
   if (deletedBucket) {
-    decreaseMemStat(deletedBucket->number * deletedBucket->size);
-    totalEntries -= 1;
-    if (totalEntries*8 < hashSize && hashSizeIndex > 0)
-      resizeTable(-1);
+    decreaseMemStat(shard, deletedBucket->number * deletedBucket->size);
+    shardStats[shard].entries -= 1;
+    if (shardStats[shard].entries*8 < sh->hashSize && sh->hashSizeIndex > 0)
+      resizeTable(sh, -1);
   }
   return deletedBucket;
 }
 
 
+//
+// Sampling allocation profiler.
+//
+// With --memSample=N we record roughly one allocation per N bytes
+// allocated, attributed to its call site (file, line and memory
+// descriptor), instead of tracking every allocation.  Each thread
+// counts the bytes it allocates and records a sample whenever the
+// count crosses a multiple of N, so the common path is just a
+// thread-local add and compare.  A sample stands for N bytes, which
+// makes the per-site totals unbiased estimates of the bytes allocated
+// there.  Sampled allocations are remembered until they are freed so
+// that we can also report the live heap by site.  Frees are screened
+// by a small table of per-hash-bucket counts of live samples, so that
+// freeing memory that was not sampled, which is nearly all of it,
+// doesn't need a lock.
+//
+typedef struct memSampleSite_struct {
+  int32_t lineno;
+  int32_t filename;
+  chpl_mem_descInt_t description;
+  size_t samples;         /* number of sampled allocations */
+  size_t allocated;       /* estimated bytes allocated */
+  size_t live;            /* estimated bytes still allocated */
+  struct memSampleSite_struct* nextInBucket;
+} memSampleSite;
+
+typedef struct memSampleEntry_struct {
+  void* memAlloc;
+  size_t weight;
+  memSampleSite* site;
+  struct memSampleEntry_struct* nextInBucket;
+} memSampleEntry;
+
+#define MEM_SAMPLE_SITE_BUCKETS 1021
+#define MEM_SAMPLE_LIVE_BUCKETS 16381
+#define MEM_SAMPLE_FILTER_BITS 16
+#define MEM_SAMPLE_FILTER_SIZE (1 << MEM_SAMPLE_FILTER_BITS)
+
+static chpl_sync_aux_t memSample_sync;
+static memSampleSite** memSampleSites;
+static size_t memSampleNumSites;
+static memSampleEntry** memSampleLive;
+static atomic_int_least32_t* memSampleFilter;
+static _timevalue memSampleStartTime;
+
+CHPL_TLS_DECL(intptr_t, memSampleBytes);
+
+
+static void memSampleInit(void) {
+  int i;
+
+  chpl_sync_initAux(&memSample_sync);
+  memSampleSites = sys_calloc(MEM_SAMPLE_SITE_BUCKETS, sizeof(memSampleSite*));
+  memSampleLive = sys_calloc(MEM_SAMPLE_LIVE_BUCKETS, sizeof(memSampleEntry*));
+  memSampleFilter = sys_malloc(MEM_SAMPLE_FILTER_SIZE
+                               * sizeof(atomic_int_least32_t));
+  for (i = 0; i < MEM_SAMPLE_FILTER_SIZE; i++)
+    atomic_init_int_least32_t(&memSampleFilter[i], 0);
+  CHPL_TLS_INIT(memSampleBytes);
+  memSampleStartTime = chpl_now_timevalue();
+}
+
+
+static int memSampleFilterIndex(void* memAlloc) {
+  return (int) (hash(memAlloc) & (MEM_SAMPLE_FILTER_SIZE - 1));
+}
+
+
+// assumes memSample_sync is held
+static memSampleSite* memSampleFindSite(chpl_mem_descInt_t description,
+                                        int32_t lineno, int32_t filename) {
+  unsigned hashValue = ((unsigned) filename * 31 + (unsigned) lineno) * 31
+                       + (unsigned) description;
+  memSampleSite* site;
+
+  hashValue %= MEM_SAMPLE_SITE_BUCKETS;
+  for (site = memSampleSites[hashValue];
+       site != NULL;
+       site = site->nextInBucket) {
+    if (site->lineno == lineno && site->filename == filename
+        && site->description == description)
+      return site;
+  }
+
+  site = sys_calloc(1, sizeof(memSampleSite));
+  if (site == NULL)
+    return NULL;
+  site->lineno = lineno;
+  site->filename = filename;
+  site->description = description;
+  site->nextInBucket = memSampleSites[hashValue];
+  memSampleSites[hashValue] = site;
+  memSampleNumSites += 1;
+  return site;
+}
+
+
+static void sampleAlloc(void* memAlloc, size_t size,
+                        chpl_mem_descInt_t description,
+                        int32_t lineno, int32_t filename) {
+  size_t bytes = (size_t) (intptr_t) CHPL_TLS_GET(memSampleBytes) + size;
+  size_t weight;
+  memSampleSite* site;
+  memSampleEntry* entry;
+  unsigned hashValue;
+
+  if (bytes < memSample) {
+    CHPL_TLS_SET(memSampleBytes, (intptr_t) bytes);
+    return;
+  }
+  CHPL_TLS_SET(memSampleBytes, (intptr_t) (bytes % memSample));
+  weight = (bytes / memSample) * memSample;
+
+  entry = sys_malloc(sizeof(memSampleEntry));
+  if (entry == NULL)
+    return;
+
+  chpl_sync_lock(&memSample_sync);
+  site = memSampleFindSite(description, lineno, filename);
+  if (site == NULL) {
+    chpl_sync_unlock(&memSample_sync);
+    sys_free(entry);
+    return;
+  }
+  site->samples += 1;
+  site->allocated += weight;
+  site->live += weight;
+
+  entry->memAlloc = memAlloc;
+  entry->weight = weight;
+  entry->site = site;
+  hashValue = hash(memAlloc) % MEM_SAMPLE_LIVE_BUCKETS;
+  entry->nextInBucket = memSampleLive[hashValue];
+  memSampleLive[hashValue] = entry;
+  (void) atomic_fetch_add_int_least32_t(
+           &memSampleFilter[memSampleFilterIndex(memAlloc)], 1);
+  chpl_sync_unlock(&memSample_sync);
+}
+
+
+static void sampleFree(void* memAlloc) {
+  atomic_int_least32_t* filter;
+  memSampleEntry** prev;
+  memSampleEntry* entry;
+
+  if (memAlloc == NULL)
+    return;
+
+  filter = &memSampleFilter[memSampleFilterIndex(memAlloc)];
+  if (atomic_load_int_least32_t(filter) == 0)
+    return;
+
+  chpl_sync_lock(&memSample_sync);
+  for (prev = &memSampleLive[hash(memAlloc) % MEM_SAMPLE_LIVE_BUCKETS];
+       (entry = *prev) != NULL;
+       prev = &entry->nextInBucket) {
+    if (entry->memAlloc == memAlloc) {
+      *prev = entry->nextInBucket;
+      entry->site->live -= entry->weight;
+      (void) atomic_fetch_sub_int_least32_t(filter, 1);
+      break;
+    }
+  }
+  chpl_sync_unlock(&memSample_sync);
+
+  if (entry != NULL)
+    sys_free(entry);
+}
+
+
+static int memSampleSiteCmp(const void* p1, const void* p2) {
+  const memSampleSite* s1 = *(memSampleSite* const *) p1;
+  const memSampleSite* s2 = *(memSampleSite* const *) p2;
+  if (s1->allocated != s2->allocated)
+    return (s1->allocated < s2->allocated) ? 1 : -1;
+  if (s1->live != s2->live)
+    return (s1->live < s2->live) ? 1 : -1;
+  if (s1->filename != s2->filename)
+    return (s1->filename < s2->filename) ? -1 : 1;
+  if (s1->lineno != s2->lineno)
+    return (s1->lineno < s2->lineno) ? -1 : 1;
+  return (s1->description < s2->description) ? -1 :
+         (s1->description > s2->description) ? 1 : 0;
+}
+
+
+//
+// Print the sampled allocation profile for this locale, one line per
+// call site, ordered by estimated bytes allocated.  The rate is the
+// estimated bytes allocated at the site per second since startup.
+//
+void chpl_printMemSampleProfile(int32_t lineno, int32_t filename) {
+  memSampleSite** table;
+  memSampleSite* site;
+  size_t n, i;
+  int b;
+  double elapsed;
+  const int numberWidth = 12;
+  const int locWidth = 24;
+  char* loc;
+
+  if (!chpl_memSample) {
+    chpl_warning("invalid call to printMemSampleProfile(); rerun with "
+                 "--memSample",
+                 lineno, filename);
+    return;
+  }
+
+  chpl_sync_lock(&memSample_sync);
+
+  {
+    _timevalue now = chpl_now_timevalue();
+    elapsed = (chpl_timevalue_seconds(now)
+               - chpl_timevalue_seconds(memSampleStartTime))
+              + (chpl_timevalue_microseconds(now)
+                 - chpl_timevalue_microseconds(memSampleStartTime)) * 1e-6;
+  }
+  if (elapsed <= 0.0)
+    elapsed = 1e-6;
+
+  table = sys_malloc((memSampleNumSites + 1) * sizeof(memSampleSite*));
+  loc = sys_malloc(1024);
+  if (table == NULL || loc == NULL) {
+    chpl_sync_unlock(&memSample_sync);
+    sys_free(table);
+    sys_free(loc);
+    return;
+  }
+
+  n = 0;
+  for (b = 0; b < MEM_SAMPLE_SITE_BUCKETS; b++)
+    for (site = memSampleSites[b]; site != NULL; site = site->nextInBucket)
+      table[n++] = site;
+  qsort(table, n, sizeof(memSampleSite*), memSampleSiteCmp);
+
+  fprintf(memLogFile, "========================================\n");
+  fprintf(memLogFile, "Sampled Allocation Profile for Locale %" FORMAT_c_nodeid_t "\n",
+          chpl_nodeID);
+  fprintf(memLogFile, "1 sample per %zu bytes over %.3f seconds\n",
+          memSample, elapsed);
+  fprintf(memLogFile, "==============================================================================================\n");
+  fprintf(memLogFile, "%-*s  %-*s  %-*s  %-*s  %-*s  %s\n",
+          locWidth, "Allocated at",
+          numberWidth, "Samples",
+          numberWidth, "Allocated",
+          numberWidth, "Live",
+          numberWidth, "Bytes/sec",
+          "Description");
+  fprintf(memLogFile, "==============================================================================================\n");
+  for (i = 0; i < n; i++) {
+    site = table[i];
+    if (site->filename) {
+      snprintf(loc, 1024, "%s:%" PRId32,
+               chpl_lookupFilename(site->filename), site->lineno);
+    } else {
+      snprintf(loc, 1024, "--");
+    }
+    fprintf(memLogFile, "%-*s  %-*zu  %-*zu  %-*zu  %-*.0f  %s\n",
+            locWidth, loc,
+            numberWidth, site->samples,
+            numberWidth, site->allocated,
+            numberWidth, site->live,
+            numberWidth, site->allocated / elapsed,
+            chpl_mem_descString(site->description));
+  }
+  fprintf(memLogFile, "==============================================================================================\n");
+  fflush(memLogFile);
+
+  chpl_sync_unlock(&memSample_sync);
+
+  sys_free(table);
+  sys_free(loc);
+}
+
+
+//
+// Merge the per-shard statistics, ours or another locale's.
+//
+static void sumShardStats(c_nodeid_t node, size_t* allocated, size_t* freed,
+                          int32_t lineno, int32_t filename) {
+  static memShardStats remoteStats[NUM_SHARDS];
+  memShardStats* stats = shardStats;
+  int i;
+
+  if (node != chpl_nodeID) {
+    chpl_gen_comm_get(remoteStats, node, shardStats, sizeof(shardStats), -1 /* broke for hetero */, CHPL_COMM_UNKNOWN_ID, lineno, filename);
+    stats = remoteStats;
+  }
+
+  *allocated = *freed = 0;
+  for (i = 0; i < NUM_SHARDS; i++) {
+    *allocated += stats[i].allocated;
+    *freed += stats[i].freed;
+  }
+}
+
+
+//
+// The high-water mark is only maintained as memory is added to totalMem,
+// so it can be behind the exact current total.
+//
+static size_t maxAllocatedMem(size_t max, size_t current) {
+  return (current > max) ? current : max;
+}
+
+
 uint64_t chpl_memoryUsed(int32_t lineno, int32_t filename) {
   if (!chpl_memTrack) {
     chpl_warning("invalid call to memoryUsed(); rerun with --memTrack",
@@ -287,7 +683,11 @@ uint64_t chpl_memoryUsed(int32_t lineno, int32_t filename) {
     return 0;
   }
 
-  return (uint64_t)totalMem;
+  {
+    size_t allocated, freed;
+    sumShardStats(chpl_nodeID, &allocated, &freed, lineno, filename);
+    return (uint64_t) (allocated - freed);
+  }
 }
 
 
@@ -302,9 +702,12 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
   fprintf(memLogFile, "=================\n");
   fprintf(memLogFile, "Memory Statistics\n");
   if (chpl_numNodes == 1) {
+    size_t totalAllocated, totalFreed, maxAllocated;
+    sumShardStats(chpl_nodeID, &totalAllocated, &totalFreed, lineno, filename);
+    maxAllocated = maxAllocatedMem(maxMem, totalAllocated - totalFreed);
     fprintf(memLogFile, "==============================================================\n");
-    fprintf(memLogFile, "Current Allocated Memory               %zd\n", totalMem);
-    fprintf(memLogFile, "Maximum Simultaneous Allocated Memory  %zd\n", maxMem);
+    fprintf(memLogFile, "Current Allocated Memory               %zd\n", totalAllocated - totalFreed);
+    fprintf(memLogFile, "Maximum Simultaneous Allocated Memory  %zd\n", maxAllocated);
     fprintf(memLogFile, "Total Allocated Memory                 %zd\n", totalAllocated);
     fprintf(memLogFile, "Total Freed Memory                     %zd\n", totalFreed);
     fprintf(memLogFile, "==============================================================\n");
@@ -318,12 +721,11 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
     fprintf(memLogFile, "                                            Total Freed Memory\n");
     fprintf(memLogFile, "==============================================================\n");
     for (i = 0; i < chpl_numNodes; i++) {
-      static size_t m1, m2, m3, m4;
-      chpl_gen_comm_get(&m1, i, &totalMem,       sizeof(size_t), -1 /* broke for hetero */, CHPL_COMM_UNKNOWN_ID, lineno, filename);
+      static size_t m2, m3, m4;
       chpl_gen_comm_get(&m2, i, &maxMem,         sizeof(size_t), -1 /* broke for hetero */, CHPL_COMM_UNKNOWN_ID, lineno, filename);
-      chpl_gen_comm_get(&m3, i, &totalAllocated, sizeof(size_t), -1 /* broke for hetero */, CHPL_COMM_UNKNOWN_ID, lineno, filename);
-      chpl_gen_comm_get(&m4, i, &totalFreed,     sizeof(size_t), -1 /* broke for hetero */, CHPL_COMM_UNKNOWN_ID, lineno, filename);
-      fprintf(memLogFile, "%-9d  %-9zu  %-9zu  %-9zu  %-9zu\n", i, m1, m2, m3, m4);
+      sumShardStats(i, &m3, &m4, lineno, filename);
+      m2 = maxAllocatedMem(m2, m3 - m4);
+      fprintf(memLogFile, "%-9d  %-9zu  %-9zu  %-9zu  %-9zu\n", i, m3 - m4, m2, m3, m4);
     }
     fprintf(memLogFile, "==============================================================\n");
   }
@@ -341,7 +743,7 @@ static void printMemAllocsByType(_Bool forLeaks,
                                  int32_t lineno, int32_t filename) {
   size_t* table;
   memTableEntry* me;
-  int i;
+  int i, s;
   const int numberWidth   = 9;
   const int numEntries = CHPL_RT_MD_NUM+chpl_mem_numDescs;
 
@@ -354,12 +756,16 @@ static void printMemAllocsByType(_Bool forLeaks,
 
   table = (size_t*)sys_calloc(numEntries, 3*sizeof(size_t));
 
-  for (i = 0; i < hashSize; i++) {
-    for (me = memTable[i]; me != NULL; me = me->nextInBucket) {
-      table[3*me->description] += me->number*me->size;
-      table[3*me->description+1] += 1;
-      table[3*me->description+2] = me->description;
+  for (s = 0; s < NUM_SHARDS; s++) {
+    chpl_sync_lock(&shards[s].sync);
+    for (i = 0; i < shards[s].hashSize; i++) {
+      for (me = shards[s].table[i]; me != NULL; me = me->nextInBucket) {
+        table[3*me->description] += me->number*me->size;
+        table[3*me->description+1] += 1;
+        table[3*me->description+2] = me->description;
+      }
     }
+    chpl_sync_unlock(&shards[s].sync);
   }
 
   qsort(table, numEntries, 3*sizeof(size_t), memTableEntryCmp);
@@ -460,7 +866,7 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
 
   memTableEntry* memEntry;
   c_string memEntryFilename;
-  int n, i;
+  int n, i, s;
   char* loc;
   memTableEntry** table;
 
@@ -472,21 +878,25 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
 
   n = 0;
   filenameWidth = strlen("Allocated Memory (Bytes)");
-  for (i = 0; i < hashSize; i++) {
-    for (memEntry = memTable[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
-      size_t chunk = memEntry->number * memEntry->size;
-      if (chunk < threshold)
-        continue;
-      if (description != -1 && memEntry->description != description)
-        continue;
-      n += 1;
-      if (memEntry->filename) {
-        memEntryFilename = chpl_lookupFilename(memEntry->filename);
-        filenameLength = strlen(memEntryFilename);
-        if (filenameLength > filenameWidth)
-          filenameWidth = filenameLength;
+  for (s = 0; s < NUM_SHARDS; s++) {
+    chpl_sync_lock(&shards[s].sync);
+    for (i = 0; i < shards[s].hashSize; i++) {
+      for (memEntry = shards[s].table[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
+        size_t chunk = memEntry->number * memEntry->size;
+        if (chunk < threshold)
+          continue;
+        if (description != -1 && memEntry->description != description)
+          continue;
+        n += 1;
+        if (memEntry->filename) {
+          memEntryFilename = chpl_lookupFilename(memEntry->filename);
+          filenameLength = strlen(memEntryFilename);
+          if (filenameLength > filenameWidth)
+            filenameWidth = filenameLength;
+        }
       }
     }
+    chpl_sync_unlock(&shards[s].sync);
   }
 
   totalWidth = filenameWidth+numberWidth*4+descWidth+20;
@@ -508,15 +918,25 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
   if (!table)
     chpl_error("out of memory printing memory table", lineno, filename);
 
-  n = 0;
-  for (i = 0; i < hashSize; i++) {
-    for (memEntry = memTable[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
-      size_t chunk = memEntry->number * memEntry->size;
-      if (chunk < threshold)
-        continue;
-      if (description != -1 && memEntry->description != description)
-        continue;
-      table[n++] = memEntry;
+  //
+  // Entries allocated since we counted them are left out.
+  //
+  {
+    int maxN = n;
+    n = 0;
+    for (s = 0; s < NUM_SHARDS; s++) {
+      chpl_sync_lock(&shards[s].sync);
+      for (i = 0; i < shards[s].hashSize; i++) {
+        for (memEntry = shards[s].table[i]; memEntry != NULL && n < maxN; memEntry = memEntry->nextInBucket) {
+          size_t chunk = memEntry->number * memEntry->size;
+          if (chunk < threshold)
+            continue;
+          if (description != -1 && memEntry->description != description)
+            continue;
+          table[n++] = memEntry;
+        }
+      }
+      chpl_sync_unlock(&shards[s].sync);
     }
   }
   qsort(table, n, sizeof(memTableEntry*), descCmp);
@@ -550,6 +970,10 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
 
 
 void chpl_reportMemInfo() {
+  if (chpl_memSample) {
+    fprintf(memLogFile, "\n");
+    chpl_printMemSampleProfile(0, 0);
+  }
   if (memStats) {
     fprintf(memLogFile, "\n");
     chpl_printMemAllocStats(0, 0);
@@ -583,11 +1007,15 @@ void chpl_reportMemInfo() {
 void chpl_track_malloc(void* memAlloc, size_t number, size_t size,
                        chpl_mem_descInt_t description,
                        int32_t lineno, int32_t filename) {
+  if (chpl_memSample && memAlloc && chpl_mem_descTrack(description))
+    sampleAlloc(memAlloc, number * size, description, lineno, filename);
   if (number * size > memThreshold) {
     if (chpl_memTrack && chpl_mem_descTrack(description)) {
-      chpl_sync_lock(&memTrack_sync);
-      addMemTableEntry(memAlloc, number, size, description, lineno, filename);
-      chpl_sync_unlock(&memTrack_sync);
+      int shard = shardIndex(memAlloc);
+      chpl_sync_lock(&shards[shard].sync);
+      addMemTableEntry(shard, memAlloc, number, size, description,
+                       lineno, filename);
+      chpl_sync_unlock(&shards[shard].sync);
     }
     if (chpl_verbose_mem) {
       fprintf(memLogFile, "%" FORMAT_c_nodeid_t ": %s:%" PRId32
@@ -602,9 +1030,12 @@ void chpl_track_malloc(void* memAlloc, size_t number, size_t size,
 
 void chpl_track_free(void* memAlloc, int32_t lineno, int32_t filename) {
   memTableEntry* memEntry = NULL;
+  if (chpl_memSample)
+    sampleFree(memAlloc);
   if (chpl_memTrack) {
-    chpl_sync_lock(&memTrack_sync);
-    memEntry = removeMemTableEntry(memAlloc);
+    int shard = shardIndex(memAlloc);
+    chpl_sync_lock(&shards[shard].sync);
+    memEntry = removeMemTableEntry(shard, memAlloc);
     if (memEntry) {
       if (chpl_verbose_mem) {
         fprintf(memLogFile, "%" FORMAT_c_nodeid_t ": %s:%" PRId32
@@ -615,7 +1046,7 @@ void chpl_track_free(void* memAlloc, int32_t lineno, int32_t filename) {
       }
       sys_free(memEntry);
     }
-    chpl_sync_unlock(&memTrack_sync);
+    chpl_sync_unlock(&shards[shard].sync);
   } else if (chpl_verbose_mem && !memEntry) {
     fprintf(memLogFile, "%" FORMAT_c_nodeid_t ": %s:%" PRId32 ": free at %p\n",
             chpl_nodeID, (filename ? chpl_lookupFilename(filename) : "--"),
@@ -629,14 +1060,15 @@ void chpl_track_realloc_pre(void* memAlloc, size_t size,
                          int32_t lineno, int32_t filename) {
   memTableEntry* memEntry = NULL;
 
-  if (chpl_memTrack && size > memThreshold) {
-    chpl_sync_lock(&memTrack_sync);
-    if (memAlloc) {
-      memEntry = removeMemTableEntry(memAlloc);
-      if (memEntry)
-        sys_free(memEntry);
-    }
-    chpl_sync_unlock(&memTrack_sync);
+  if (chpl_memSample)
+    sampleFree(memAlloc);
+  if (chpl_memTrack && size > memThreshold && memAlloc) {
+    int shard = shardIndex(memAlloc);
+    chpl_sync_lock(&shards[shard].sync);
+    memEntry = removeMemTableEntry(shard, memAlloc);
+    if (memEntry)
+      sys_free(memEntry);
+    chpl_sync_unlock(&shards[shard].sync);
   }
 }
 
@@ -645,11 +1077,15 @@ void chpl_track_realloc_post(void* moreMemAlloc,
                          void* memAlloc, size_t size,
                          chpl_mem_descInt_t description,
                          int32_t lineno, int32_t filename) {
+  if (chpl_memSample && moreMemAlloc && chpl_mem_descTrack(description))
+    sampleAlloc(moreMemAlloc, size, description, lineno, filename);
   if (size > memThreshold) {
     if (chpl_memTrack && chpl_mem_descTrack(description)) {
-      chpl_sync_lock(&memTrack_sync);
-      addMemTableEntry(moreMemAlloc, 1, size, description, lineno, filename);
-      chpl_sync_unlock(&memTrack_sync);
+      int shard = shardIndex(moreMemAlloc);
+      chpl_sync_lock(&shards[shard].sync);
+      addMemTableEntry(shard, moreMemAlloc, 1, size, description,
+                       lineno, filename);
+      chpl_sync_unlock(&shards[shard].sync);
     }
     if (chpl_verbose_mem) {
       fprintf(memLogFile, "%" FORMAT_c_nodeid_t ": %s:%" PRId32
@@ -26,6 +26,7 @@
 #include "chpl-comm.h"
 #include "chpl-comm-callbacks.h"
 #include "chpl-comm-callbacks-internal.h"
+#include "chpl-comm-diags.h"
 #include "chpl-mem.h"
 #include "chplsys.h"
 #include "chpl-tasks.h"
@@ -49,8 +50,6 @@
 #include <assert.h>
 #include <time.h>
 
-static chpl_sync_aux_t chpl_comm_diagnostics_sync;
-static chpl_commDiagnostics chpl_comm_commDiagnostics;
 static int chpl_comm_no_debug_private = 0;
 static gasnet_seginfo_t* seginfo_table = NULL;
 
@@ -206,21 +205,44 @@ typedef struct {
   large_fork_t          large;
 } large_fork_task_t;
 
+//
+// Private broadcasts travel down a tree rooted at the node that started
+// them (see bcast_num_children() below).  Each node that receives one
+// forwards it to its children and then signals 'ack' on its parent
+// once its whole subtree has the data.
+//
 typedef struct {
-  void*   ack;
-  int     id;       // private broadcast table entry to update
-  int     size;     // size of data
-  char    data[0];  // data
+  void*       ack;
+  c_nodeid_t  root;     // node that started the broadcast
+  int         id;       // private broadcast table entry to update
+  int         size;     // size of data
+  char        data[0];  // data
 } priv_bcast_t;
 
 typedef struct {
-  void* ack;
-  int   id;       // private broadcast table entry to update
-  int   size;     // size of data
-  int   offset;   // offset of piece of data
-  char  data[0];  // data
+  void*       ack;
+  c_nodeid_t  root;     // node that started the broadcast
+  int         id;       // private broadcast table entry to update
+  int         size;     // size of data
+  int         offset;   // offset of piece of data
+  char        data[0];  // data
 } priv_bcast_large_t;
 
+//
+// A broadcast message that an interior node of the tree has received
+// and must forward to its children (see priv_bcast_forward() below).
+//
+typedef struct priv_bcast_fwd_s {
+  struct priv_bcast_fwd_s* next;
+  int                      op;      // PRIV_BCAST or PRIV_BCAST_LARGE
+  c_nodeid_t               root;
+  c_nodeid_t               parent;
+  void*                    ack;     // parent's done_t
+  done_t                   done;    // acks from our children
+  void*                    msg;     // copy of the message
+  size_t                   nbytes;
+} priv_bcast_fwd_t;
+
 typedef struct {
   void* ack; // acknowledgement object
   void* tgt; // target memory address
@@ -228,6 +250,63 @@ typedef struct {
   size_t size; // number of bytes.
 } xfer_info_t;
 
+//
+// Network atomics are done by the target node's processor, inside the
+// handler for an AMO request.  The handler replies with the result,
+// or for an unordered AMO just with an acknowledgement.
+//
+typedef enum {
+  amo_put,
+  amo_get,
+  amo_xchg,
+  amo_cmpxchg,
+  amo_and,
+  amo_or,
+  amo_xor,
+  amo_add,
+  amo_sub
+} amo_op_t;
+
+typedef enum {
+  amo_int32,
+  amo_int64,
+  amo_uint32,
+  amo_uint64,
+  amo_real32,
+  amo_real64
+} amo_type_t;
+
+typedef union {
+  int_least32_t  int32;
+  int_least64_t  int64;
+  uint_least32_t uint32;
+  uint_least64_t uint64;
+  _real32        real32;
+  _real64        real64;
+  chpl_bool32    bool32;
+} amo_val_t;
+
+typedef struct {
+  void*      ack;       // caller's amo_done_t, or if unordered, the
+                        //   calling task's count of AMOs in flight
+  chpl_bool  unordered;
+  void*      obj;       // target object
+  amo_op_t   op;
+  amo_type_t type;
+  amo_val_t  opnd1;
+  amo_val_t  opnd2;
+} amo_req_t;
+
+typedef struct {
+  done_t     done;
+  amo_val_t  res;
+} amo_done_t;
+
+typedef struct {
+  void*      ack;       // caller's amo_done_t
+  amo_val_t  res;
+} amo_reply_t;
+
 
 //
 // AM functions
@@ -250,7 +329,10 @@ typedef enum {
   EXIT_ANY,             // <unused> to be used for exit_any() cleanup
   BCAST_SEGINFO,        // broadcast for segment info table
   DO_REPLY_PUT,         // do a PUT here from another locale
-  DO_COPY_PAYLOAD       // copy AM payload to another address
+  DO_COPY_PAYLOAD,      // copy AM payload to another address
+  AMO,                  // do an atomic operation here
+  AMO_DONE,             // result of an AMO, to an amo_done_t
+  AMO_UNORDERED_DONE    // an unordered AMO is done
 } AM_handler_function_idx_t;
 
 static void AM_fork_fast(gasnet_token_t token, void* buf, size_t nbytes) {
@@ -324,6 +406,7 @@ static void AM_fork_fast_small(gasnet_token_t token, void* buf, size_t nbytes) {
 
 static void fork_wrapper(chpl_comm_on_bundle_t *f) {
   chpl_ftable_call(f->task_bundle.requested_fid, f);
+  chpl_comm_atomic_unordered_task_fence();
 
   GASNET_Safe(gasnet_AMRequestShort2(f->comm.caller, SIGNAL,
                                      Arg0(f->comm.ack), Arg1(f->comm.ack)));
@@ -379,6 +462,7 @@ static void fork_large_wrapper(large_fork_task_t* f) {
 
   // Call the on body function
   chpl_ftable_call(fid, arg);
+  chpl_comm_atomic_unordered_task_fence();
 
   // Signal completion
   GASNET_Safe(gasnet_AMRequestShort2(caller, SIGNAL, Arg0(ack), Arg1(ack)));
@@ -406,6 +490,7 @@ static void AM_fork_large(gasnet_token_t token, void* buf, size_t nbytes) {
 
 static void fork_nb_wrapper(chpl_comm_on_bundle_t *f) {
   chpl_ftable_call(f->task_bundle.requested_fid, f);
+  chpl_comm_atomic_unordered_task_fence();
 }
 
 static void AM_fork_nb(gasnet_token_t  token,
@@ -464,6 +549,7 @@ static void fork_nb_large_wrapper(large_fork_task_t* f) {
 
   // Call the user function
   chpl_ftable_call(fid, arg);
+  chpl_comm_atomic_unordered_task_fence();
 
   // Free the bundle we just allocated
   chpl_mem_free(arg, 0, 0);
@@ -502,22 +588,154 @@ static void AM_signal_long(gasnet_token_t token, void *buf, size_t nbytes,
     done->flag = 1;
 }
 
+//
+// Broadcasts use a BCAST_FANOUT-ary tree.  Nodes are ranked relative to
+// the root of the broadcast, so the root has rank 0 and the children of
+// rank r are ranks r*BCAST_FANOUT+1 .. r*BCAST_FANOUT+BCAST_FANOUT.
+// Every node must agree on the fanout, so it is not configurable.
+//
+#define BCAST_FANOUT 4
+
+static inline
+int bcast_rank(c_nodeid_t node, c_nodeid_t root) {
+  return (node - root + chpl_numNodes) % chpl_numNodes;
+}
+
+static inline
+c_nodeid_t bcast_node(int rank, c_nodeid_t root) {
+  return (rank + root) % chpl_numNodes;
+}
+
+static inline
+c_nodeid_t bcast_parent(c_nodeid_t node, c_nodeid_t root) {
+  return bcast_node((bcast_rank(node, root) - 1) / BCAST_FANOUT, root);
+}
+
+static inline
+int bcast_num_children(c_nodeid_t node, c_nodeid_t root) {
+  int first = bcast_rank(node, root) * BCAST_FANOUT + 1;
+  int num   = chpl_numNodes - first;
+
+  if (num < 0)
+    num = 0;
+  if (num > BCAST_FANOUT)
+    num = BCAST_FANOUT;
+
+  return num;
+}
+
+//
+// Send a private broadcast message to this node's children in the
+// tree.  The caller has pointed the message's ack at a done_t that
+// expects a signal from each child.
+//
+static void priv_bcast_to_children(int op, void* msg, size_t nbytes,
+                                   c_nodeid_t root) {
+  int first = bcast_rank(chpl_nodeID, root) * BCAST_FANOUT + 1;
+  int num   = bcast_num_children(chpl_nodeID, root);
+  int i;
+
+  for (i = 0; i < num; i++) {
+    GASNET_Safe(gasnet_AMRequestMedium0(bcast_node(first + i, root), op,
+                                        msg, nbytes));
+  }
+}
+
+//
+// An AM handler may only reply, so an interior node of the tree can't
+// forward a message from its handler.  The handler queues the message
+// instead, and the polling task forwards it to the children and then
+// signals the parent once they have all acked.  A leaf signals its
+// parent from the handler.  Either way a broadcast completes without
+// needing a free worker thread on any node.
+//
+static gasnet_hsl_t priv_bcast_fwd_lock = GASNET_HSL_INITIALIZER;
+static priv_bcast_fwd_t* volatile priv_bcast_fwd_queued = NULL;
+
+// Only the polling task touches this list
+static priv_bcast_fwd_t* priv_bcast_fwd_active = NULL;
+
+static void priv_bcast_forward(gasnet_token_t token, int op,
+                               void* buf, size_t nbytes,
+                               c_nodeid_t root, void* ack) {
+  if (bcast_num_children(chpl_nodeID, root) == 0) {
+    GASNET_Safe(gasnet_AMReplyShort2(token, SIGNAL, Arg0(ack), Arg1(ack)));
+  } else {
+    priv_bcast_fwd_t* f;
+
+    f = chpl_mem_alloc(sizeof(*f), CHPL_RT_MD_COMM_PRV_BCAST_DATA, 0, 0);
+    f->op     = op;
+    f->root   = root;
+    f->parent = bcast_parent(chpl_nodeID, root);
+    f->ack    = ack;
+    f->msg    = chpl_mem_alloc(nbytes, CHPL_RT_MD_COMM_PRV_BCAST_DATA, 0, 0);
+    f->nbytes = nbytes;
+    chpl_memcpy(f->msg, buf, nbytes);
+
+    gasnet_hsl_lock(&priv_bcast_fwd_lock);
+    f->next = priv_bcast_fwd_queued;
+    priv_bcast_fwd_queued = f;
+    gasnet_hsl_unlock(&priv_bcast_fwd_lock);
+  }
+}
+
+//
+// Called by the polling task: forward the queued broadcast messages,
+// and signal the parents of those whose children have all acked.
+//
+static void priv_bcast_progress(void) {
+  priv_bcast_fwd_t*  f;
+  priv_bcast_fwd_t** pf;
+
+  if (priv_bcast_fwd_queued != NULL) {
+    gasnet_hsl_lock(&priv_bcast_fwd_lock);
+    f = priv_bcast_fwd_queued;
+    priv_bcast_fwd_queued = NULL;
+    gasnet_hsl_unlock(&priv_bcast_fwd_lock);
+
+    while (f != NULL) {
+      priv_bcast_fwd_t* next = f->next;
+
+      init_done_obj(&f->done, bcast_num_children(chpl_nodeID, f->root));
+      if (f->op == PRIV_BCAST)
+        ((priv_bcast_t*) f->msg)->ack = &f->done;
+      else
+        ((priv_bcast_large_t*) f->msg)->ack = &f->done;
+      priv_bcast_to_children(f->op, f->msg, f->nbytes, f->root);
+
+      f->next = priv_bcast_fwd_active;
+      priv_bcast_fwd_active = f;
+      f = next;
+    }
+  }
+
+  pf = &priv_bcast_fwd_active;
+  while ((f = *pf) != NULL) {
+    if (f->done.flag) {
+      *pf = f->next;
+      GASNET_Safe(gasnet_AMRequestShort2(f->parent, SIGNAL,
+                                         Arg0(f->ack), Arg1(f->ack)));
+      chpl_mem_free(f->msg, 0, 0);
+      chpl_mem_free(f, 0, 0);
+    } else {
+      pf = &f->next;
+    }
+  }
+}
+
 static void AM_priv_bcast(gasnet_token_t token, void* buf, size_t nbytes) {
   priv_bcast_t* pbp = buf;
   chpl_memcpy(chpl_private_broadcast_table[pbp->id], pbp->data, pbp->size);
 
-  // Signal that the handler has completed
-  GASNET_Safe(gasnet_AMReplyShort2(token, SIGNAL,
-                                   Arg0(pbp->ack), Arg1(pbp->ack)));
+  priv_bcast_forward(token, PRIV_BCAST, buf, nbytes, pbp->root, pbp->ack);
 }
 
 static void AM_priv_bcast_large(gasnet_token_t token, void* buf, size_t nbytes) {
   priv_bcast_large_t* pblp = buf;
   chpl_memcpy((char*)chpl_private_broadcast_table[pblp->id]+pblp->offset, pblp->data, pblp->size);
 
-  // Signal that the handler has completed
-  GASNET_Safe(gasnet_AMReplyShort2(token, SIGNAL,
-                                   Arg0(pblp->ack), Arg1(pblp->ack)));
+  priv_bcast_forward(token, PRIV_BCAST_LARGE, buf, nbytes,
+                     pblp->root, pblp->ack);
 }
 
 static void AM_free(gasnet_token_t token, gasnet_handlerarg_t a0, gasnet_handlerarg_t a1) {
@@ -575,6 +793,105 @@ void AM_copy_payload(gasnet_token_t token, void* buf, size_t nbytes,
   GASNET_Safe(gasnet_AMReplyShort2(token, SIGNAL, ack0, ack1));
 }
 
+//
+// Do an AMO on this node's processor.  Every AMO on an object that
+// can be the target of network atomics goes through here, whether it
+// came from this node or another, so they are all coherent.
+//
+static void do_amo_on_cpu(amo_req_t* req, amo_val_t* res) {
+  void* obj = req->obj;
+
+#define CPU_AMO_COMMON(_m, _t)                                          \
+  case amo_put:                                                         \
+    atomic_store_##_t((atomic_##_t*) obj, req->opnd1._m);               \
+    break;                                                              \
+  case amo_get:                                                         \
+    res->_m = atomic_load_##_t((atomic_##_t*) obj);                     \
+    break;                                                              \
+  case amo_xchg:                                                        \
+    res->_m = atomic_exchange_##_t((atomic_##_t*) obj, req->opnd1._m);  \
+    break;                                                              \
+  case amo_cmpxchg:                                                     \
+    res->bool32 = atomic_compare_exchange_strong_##_t                   \
+                    ((atomic_##_t*) obj, req->opnd1._m, req->opnd2._m); \
+    break;                                                              \
+  case amo_add:                                                         \
+    res->_m = atomic_fetch_add_##_t((atomic_##_t*) obj, req->opnd1._m); \
+    break;                                                              \
+  case amo_sub:                                                         \
+    res->_m = atomic_fetch_sub_##_t((atomic_##_t*) obj, req->opnd1._m); \
+    break;
+
+#define CPU_AMO_INT(_m, _t)                                             \
+  switch (req->op) {                                                    \
+  CPU_AMO_COMMON(_m, _t)                                                \
+  case amo_and:                                                         \
+    res->_m = atomic_fetch_and_##_t((atomic_##_t*) obj, req->opnd1._m); \
+    break;                                                              \
+  case amo_or:                                                          \
+    res->_m = atomic_fetch_or_##_t((atomic_##_t*) obj, req->opnd1._m);  \
+    break;                                                              \
+  case amo_xor:                                                         \
+    res->_m = atomic_fetch_xor_##_t((atomic_##_t*) obj, req->opnd1._m); \
+    break;                                                              \
+  }
+
+#define CPU_AMO_REAL(_m, _t)                                            \
+  switch (req->op) {                                                    \
+  CPU_AMO_COMMON(_m, _t)                                                \
+  default:                                                              \
+    chpl_internal_error("unexpected real AMO");                         \
+  }
+
+  switch (req->type) {
+  case amo_int32:  CPU_AMO_INT(int32, int_least32_t);   break;
+  case amo_int64:  CPU_AMO_INT(int64, int_least64_t);   break;
+  case amo_uint32: CPU_AMO_INT(uint32, uint_least32_t); break;
+  case amo_uint64: CPU_AMO_INT(uint64, uint_least64_t); break;
+  case amo_real32: CPU_AMO_REAL(real32, _real32);       break;
+  case amo_real64: CPU_AMO_REAL(real64, _real64);       break;
+  }
+
+#undef CPU_AMO_COMMON
+#undef CPU_AMO_INT
+#undef CPU_AMO_REAL
+}
+
+static void AM_amo(gasnet_token_t token, void* buf, size_t nbytes) {
+  amo_req_t*  req = (amo_req_t*) buf;
+  amo_reply_t reply;
+
+  assert(nbytes == sizeof(amo_req_t));
+
+  do_amo_on_cpu(req, &reply.res);
+
+  if (req->unordered) {
+    GASNET_Safe(gasnet_AMReplyShort2(token, AMO_UNORDERED_DONE,
+                                     Arg0(req->ack), Arg1(req->ack)));
+  } else {
+    reply.ack = req->ack;
+    GASNET_Safe(gasnet_AMReplyMedium0(token, AMO_DONE,
+                                      &reply, sizeof(reply)));
+  }
+}
+
+static void AM_amo_done(gasnet_token_t token, void* buf, size_t nbytes) {
+  amo_reply_t* reply = (amo_reply_t*) buf;
+  amo_done_t*  d     = (amo_done_t*) reply->ack;
+
+  d->res = reply->res;
+  gasnett_local_wmb();
+  d->done.flag = 1;
+}
+
+static void AM_amo_unordered_done(gasnet_token_t token,
+                                  gasnet_handlerarg_t a0,
+                                  gasnet_handlerarg_t a1) {
+  atomic_uint_least64_t* pending =
+    (atomic_uint_least64_t*) get_ptr_from_args(a0, a1);
+  (void) atomic_fetch_sub_uint_least64_t(pending, 1);
+}
+
 static gasnet_handlerentry_t ftable[] = {
   {FORK,          AM_fork},
   {FORK_SMALL,    AM_fork_small},
@@ -592,7 +909,10 @@ static gasnet_handlerentry_t ftable[] = {
   {EXIT_ANY,      AM_exit_any},
   {BCAST_SEGINFO, AM_bcast_seginfo},
   {DO_REPLY_PUT,  AM_reply_put},
-  {DO_COPY_PAYLOAD, AM_copy_payload}
+  {DO_COPY_PAYLOAD, AM_copy_payload},
+  {AMO,           AM_amo},
+  {AMO_DONE,      AM_amo_done},
+  {AMO_UNORDERED_DONE, AM_amo_unordered_done}
 };
 
 //
@@ -628,9 +948,8 @@ chpl_comm_nb_handle_t chpl_comm_put_nb(void *addr, c_nodeid_t node, void* raddr,
   ret = gasnet_put_nb_bulk(node, raddr, addr, size);
 
   if (chpl_comm_diagnostics && !chpl_comm_no_debug_private) {
-    chpl_sync_lock(&chpl_comm_diagnostics_sync);
-    chpl_comm_commDiagnostics.put_nb++;
-    chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+    chpl_comm_diags_incr(put_nb);
+    chpl_comm_diags_record(chpl_comm_diags_put_nb, node, size, 0);
   }
 
   return (chpl_comm_nb_handle_t) ret;
@@ -666,9 +985,8 @@ chpl_comm_nb_handle_t chpl_comm_get_nb(void* addr, c_nodeid_t node, void* raddr,
   ret = gasnet_get_nb_bulk(addr, node, raddr, size);
 
   if (chpl_comm_diagnostics && !chpl_comm_no_debug_private) {
-    chpl_sync_lock(&chpl_comm_diagnostics_sync);
-    chpl_comm_commDiagnostics.get_nb++;
-    chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+    chpl_comm_diags_incr(get_nb);
+    chpl_comm_diags_record(chpl_comm_diags_get_nb, node, size, 0);
   }
 
   return (chpl_comm_nb_handle_t) ret;
@@ -737,6 +1055,7 @@ static void polling(void* x) {
   pollingRunning = 1;
   while (!pollingQuit) {
     (void) gasnet_AMPoll();
+    priv_bcast_progress();
     chpl_task_yield();
   }
   pollingRunning = 0;
@@ -916,15 +1235,11 @@ void chpl_comm_post_task_init(void) {
     sched_yield();
   }
 
-  // clear diags
-  memset(&chpl_comm_commDiagnostics, 0, sizeof(chpl_commDiagnostics));
-
   // Initialize the caching layer, if it is active.
   chpl_cache_init();
 }
 
 void chpl_comm_rollcall(void) {
-  chpl_sync_initAux(&chpl_comm_diagnostics_sync);
   chpl_msg(2, "executing on node %d of %d node(s): %s\n", chpl_nodeID, 
            chpl_numNodes, chpl_nodeName());
 }
@@ -941,50 +1256,105 @@ void chpl_comm_impl_regMemHeapInfo(void** start_p, size_t* size_p) {
 #endif
 }
 
+//
+// Locale 0 keeps the wide pointers for all the globals packed together
+// at the start of its segment.  Every other locale reserves the same
+// space at the start of its own segment (see regMemHeapInfo() above),
+// so the table can travel down the broadcast tree one level at a time:
+// each node GETs the whole table from its parent in a single transfer
+// and then serves it to its own children.  That takes O(log N) rounds
+// instead of one GET per global per node.
+//
+// With GASNET_SEGMENT_EVERYTHING only locale 0 has a table, so each
+// node GETs it from there, still in a single transfer.
+//
 void chpl_comm_broadcast_global_vars(int numGlobals) {
-  int i;
+  size_t      tableSize = numGlobals * sizeof(wide_ptr_t);
+  wide_ptr_t* table     = NULL;
+  int         i;
+
+#if defined(GASNET_SEGMENT_FAST) || defined(GASNET_SEGMENT_LARGE)
+  int myRank   = bcast_rank(chpl_nodeID, 0);
+  int myLevel  = 0;
+  int maxLevel = 0;
+  int first    = 1;             // rank of the first node on a level
+  int width    = BCAST_FANOUT;  // number of nodes on a level
+  int level;
+
+  table = (wide_ptr_t*) seginfo_table[chpl_nodeID].addr;
+
+  // Find the depth of the tree and this node's level in it
+  while (first < chpl_numNodes) {
+    maxLevel = maxLevel + 1;
+
+    if (myRank >= first)
+      myLevel = maxLevel;
+
+    first = first + width;
+    width = width * BCAST_FANOUT;
+  }
+
+  // Every node takes part in every barrier
+  for (level = 1; level <= maxLevel; level++) {
+    if (level == myLevel && numGlobals > 0) {
+      c_nodeid_t parent = bcast_parent(chpl_nodeID, 0);
+
+      chpl_comm_get(table, parent, seginfo_table[parent].addr, tableSize,
+                    -1 /*typeIndex: unused*/, CHPL_COMM_UNKNOWN_ID, 0, 0);
+    }
+
+    chpl_comm_barrier("broadcasting globals down the tree");
+  }
+#else
+  if (chpl_nodeID != 0 && numGlobals > 0) {
+    table = chpl_mem_alloc(tableSize, CHPL_RT_MD_COMM_PRV_BCAST_DATA, 0, 0);
+
+    chpl_comm_get(table, 0, seginfo_table[0].addr, tableSize,
+                  -1 /*typeIndex: unused*/, CHPL_COMM_UNKNOWN_ID, 0, 0);
+  }
+#endif
+
   if (chpl_nodeID != 0) {
     for (i = 0; i < numGlobals; i++) {
-      chpl_comm_get(chpl_globals_registry[i], 0,
-                    &((wide_ptr_t*)seginfo_table[0].addr)[i],
-                    sizeof(wide_ptr_t), -1 /*typeIndex: unused*/, CHPL_COMM_UNKNOWN_ID, 0, 0);
+      *chpl_globals_registry[i] = table[i];
     }
   }
+
+#if !defined(GASNET_SEGMENT_FAST) && !defined(GASNET_SEGMENT_LARGE)
+  if (table != NULL)
+    chpl_mem_free(table, 0, 0);
+#endif
 }
 
 void chpl_comm_broadcast_private(int id, size_t size, int32_t tid) {
-  int  node, offset;
+  int  offset;
   int  payloadSize = size + sizeof(priv_bcast_t);
-  done_t* done;
+  int  numChildren = bcast_num_children(chpl_nodeID, chpl_nodeID);
+  done_t done;
   int numOffsets=1;
 
-  // This can use the system allocator because it involves internode communication.
-  done = (done_t*) chpl_mem_allocManyZero(chpl_numNodes, sizeof(*done),
-                                          CHPL_RT_MD_COMM_FRK_DONE_FLAG,
-                                          0, 0);
+  if (numChildren == 0)
+    return;
+
   if (payloadSize <= gasnet_AMMaxMedium()) {
     priv_bcast_t* pbp = chpl_mem_allocMany(1, payloadSize, CHPL_RT_MD_COMM_PRV_BCAST_DATA, 0, 0);
     chpl_memcpy(pbp->data, chpl_private_broadcast_table[id], size);
+    pbp->ack = &done;
+    pbp->root = chpl_nodeID;
     pbp->id = id;
     pbp->size = size;
-    for (node = 0; node < chpl_numNodes; node++) {
-      if (node != chpl_nodeID) {
-        pbp->ack = &done[node];
-        init_done_obj(&done[node], 1);
-        GASNET_Safe(gasnet_AMRequestMedium0(node, PRIV_BCAST, pbp, payloadSize));
-      }
-    }
+    init_done_obj(&done, numChildren);
+    priv_bcast_to_children(PRIV_BCAST, pbp, payloadSize, chpl_nodeID);
     chpl_mem_free(pbp, 0, 0);
   } else {
     size_t maxpayloadsize = gasnet_AMMaxMedium();
     size_t maxsize = maxpayloadsize - sizeof(priv_bcast_large_t);
     priv_bcast_large_t* pblp = chpl_mem_allocMany(1, maxpayloadsize, CHPL_RT_MD_COMM_PRV_BCAST_DATA, 0, 0);
+    pblp->ack = &done;
+    pblp->root = chpl_nodeID;
     pblp->id = id;
-    numOffsets = (size+maxsize)/maxsize;
-    for (node = 0; node < chpl_numNodes; node++) {
-      if (node != chpl_nodeID)
-        init_done_obj(&done[node], numOffsets);
-    }
+    numOffsets = (size+maxsize-1)/maxsize;
+    init_done_obj(&done, numChildren * numOffsets);
     for (offset = 0; offset < size; offset += maxsize) {
       size_t thissize = size - offset;
       if (thissize > maxsize)
@@ -992,21 +1362,14 @@ void chpl_comm_broadcast_private(int id, size_t size, int32_t tid) {
       pblp->offset = offset;
       pblp->size = thissize;
       chpl_memcpy(pblp->data, (char*)chpl_private_broadcast_table[id]+offset, thissize);
-      for (node = 0; node < chpl_numNodes; node++) {
-        if (node != chpl_nodeID) {
-          pblp->ack = &done[node];
-          GASNET_Safe(gasnet_AMRequestMedium0(node, PRIV_BCAST_LARGE, pblp, sizeof(priv_bcast_large_t)+thissize));
-        }
-      }
+      priv_bcast_to_children(PRIV_BCAST_LARGE, pblp,
+                             sizeof(priv_bcast_large_t)+thissize,
+                             chpl_nodeID);
     }
     chpl_mem_free(pblp, 0, 0);
   }
-  // wait for the handlers to complete
-  for (node = 0; node < chpl_numNodes; node++) {
-    if (node != chpl_nodeID)
-      GASNET_BLOCKUNTIL(done[node].flag);
-  }
-  chpl_mem_free(done, 0, 0);
+  // wait for every subtree to have the data
+  wait_done_obj(&done);
 }
 
 void chpl_comm_barrier(const char *msg) {
@@ -1034,6 +1397,8 @@ void chpl_comm_barrier(const char *msg) {
 }
 
 void chpl_comm_pre_task_exit(int all) {
+  chpl_comm_atomic_unordered_task_fence();
+
   if (all) {
     chpl_comm_barrier("stop polling");
 
@@ -1113,6 +1478,7 @@ void  chpl_comm_put(void* addr, c_nodeid_t node, void* raddr,
                     size_t size, int32_t typeIndex,
                     int32_t commID, int ln, int32_t fn) {
   int remote_in_segment;
+  uint64_t diags_start = 0;
 
   if (chpl_nodeID == node) {
     memmove(raddr, addr, size);
@@ -1129,9 +1495,8 @@ void  chpl_comm_put(void* addr, c_nodeid_t node, void* raddr,
       printf("%d: %s:%d: remote put to %d\n", chpl_nodeID,
              chpl_lookupFilename(fn), ln, node);
     if (chpl_comm_diagnostics && !chpl_comm_no_debug_private) {
-      chpl_sync_lock(&chpl_comm_diagnostics_sync);
-      chpl_comm_commDiagnostics.put++;
-      chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+      chpl_comm_diags_incr(put);
+      diags_start = chpl_comm_diags_clock();
     }
 
     // Handle remote address not in remote segment.
@@ -1185,6 +1550,9 @@ void  chpl_comm_put(void* addr, c_nodeid_t node, void* raddr,
         wait_done_obj(&done);
       }
     }
+
+    if (diags_start != 0)
+      chpl_comm_diags_record(chpl_comm_diags_put, node, size, diags_start);
   }
 }
 
@@ -1195,6 +1563,7 @@ void  chpl_comm_get(void* addr, c_nodeid_t node, void* raddr,
                     size_t size, int32_t typeIndex,
                     int32_t commID, int ln, int32_t fn) {
   int remote_in_segment;
+  uint64_t diags_start = 0;
 
   if (chpl_nodeID == node) {
     memmove(addr, raddr, size);
@@ -1211,9 +1580,8 @@ void  chpl_comm_get(void* addr, c_nodeid_t node, void* raddr,
       printf("%d: %s:%d: remote get from %d\n", chpl_nodeID,
              chpl_lookupFilename(fn), ln, node);
     if (chpl_comm_diagnostics && !chpl_comm_no_debug_private) {
-      chpl_sync_lock(&chpl_comm_diagnostics_sync);
-      chpl_comm_commDiagnostics.get++;
-      chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+      chpl_comm_diags_incr(get);
+      diags_start = chpl_comm_diags_clock();
     }
 
     // Handle remote address not in remote segment.
@@ -1311,9 +1679,25 @@ void  chpl_comm_get(void* addr, c_nodeid_t node, void* raddr,
         chpl_mem_free(local_buf, 0, 0);
       }
     }
+
+    if (diags_start != 0)
+      chpl_comm_diags_record(chpl_comm_diags_get, node, size, diags_start);
   }
 }
 
+//
+// Total bytes moved by a strided transfer, given GASNet-style counts
+// (count[0] in bytes).
+//
+static inline
+size_t strd_xfer_bytes(size_t* cnt, size_t strlvls) {
+  size_t bytes = cnt[0];
+  size_t i;
+  for (i = 1; i <= strlvls; i++)
+    bytes *= cnt[i];
+  return bytes;
+}
+
 //
 // This is an adapter from Chapel code to GASNet's gasnet_gets_bulk. It does:
 // * convert count[0] and all of 'srcstr' and 'dststr' from counts of element
@@ -1326,6 +1710,7 @@ void  chpl_comm_get_strd(void* dstaddr, size_t* dststrides, c_nodeid_t srcnode_i
   int i;
   const size_t strlvls = (size_t)stridelevels;
   const gasnet_node_t srcnode = (gasnet_node_t)srcnode_id;
+  uint64_t diags_start = 0;
 
   size_t dststr[strlvls];
   size_t srcstr[strlvls];
@@ -1376,13 +1761,16 @@ void  chpl_comm_get_strd(void* dstaddr, size_t* dststrides, c_nodeid_t srcnode_i
     printf("%d: %s:%d: remote get from %d\n", chpl_nodeID,
            chpl_lookupFilename(fn), ln, srcnode);
   if (chpl_comm_diagnostics && !chpl_comm_no_debug_private) {
-    chpl_sync_lock(&chpl_comm_diagnostics_sync);
-    chpl_comm_commDiagnostics.get++;
-    chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+    chpl_comm_diags_incr(get);
+    diags_start = chpl_comm_diags_clock();
   }
 
   // TODO -- handle strided get for non-registered memory
   gasnet_gets_bulk(dstaddr, dststr, srcnode, srcaddr, srcstr, cnt, strlvls); 
+
+  if (diags_start != 0)
+    chpl_comm_diags_record(chpl_comm_diags_get_strd, srcnode,
+                           strd_xfer_bytes(cnt, strlvls), diags_start);
 }
 
 // See the comment for chpl_comm_gets().
@@ -1393,6 +1781,7 @@ void  chpl_comm_put_strd(void* dstaddr, size_t* dststrides, c_nodeid_t dstnode_i
   int i;
   const size_t strlvls = (size_t)stridelevels;
   const gasnet_node_t dstnode = (gasnet_node_t)dstnode_id;
+  uint64_t diags_start = 0;
 
   size_t dststr[strlvls];
   size_t srcstr[strlvls];
@@ -1441,12 +1830,15 @@ void  chpl_comm_put_strd(void* dstaddr, size_t* dststrides, c_nodeid_t dstnode_i
     printf("%d: %s:%d: remote get from %d\n", chpl_nodeID,
            chpl_lookupFilename(fn), ln, dstnode);
   if (chpl_comm_diagnostics && !chpl_comm_no_debug_private) {
-    chpl_sync_lock(&chpl_comm_diagnostics_sync);
-    chpl_comm_commDiagnostics.put++;
-    chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+    chpl_comm_diags_incr(put);
+    diags_start = chpl_comm_diags_clock();
   }
   // TODO -- handle strided put for non-registered memory
   gasnet_puts_bulk(dstnode, dstaddr, dststr, srcaddr, srcstr, cnt, strlvls); 
+
+  if (diags_start != 0)
+    chpl_comm_diags_record(chpl_comm_diags_put_strd, dstnode,
+                           strd_xfer_bytes(cnt, strlvls), diags_start);
 }
 
 static inline
@@ -1567,6 +1959,8 @@ void  execute_on_common(c_nodeid_t node, c_sublocid_t subloc,
 void  chpl_comm_execute_on(c_nodeid_t node, c_sublocid_t subloc,
                      chpl_fn_int_t fid,
                      chpl_comm_on_bundle_t *arg, size_t arg_size) {
+  uint64_t diags_start = 0;
+
   if (chpl_nodeID == node) {
     assert(0);
     chpl_ftable_call(fid, arg);
@@ -1582,13 +1976,16 @@ void  chpl_comm_execute_on(c_nodeid_t node, c_sublocid_t subloc,
     if (chpl_verbose_comm && !chpl_comm_no_debug_private)
       printf("%d: remote task created on %d\n", chpl_nodeID, node);
     if (chpl_comm_diagnostics && !chpl_comm_no_debug_private) {
-      chpl_sync_lock(&chpl_comm_diagnostics_sync);
-      chpl_comm_commDiagnostics.execute_on++;
-      chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+      chpl_comm_diags_incr(execute_on);
+      diags_start = chpl_comm_diags_clock();
     }
 
     execute_on_common(node, subloc, fid, arg, arg_size,
                      /*fast*/ false, /*blocking*/ true);
+
+    if (diags_start != 0)
+      chpl_comm_diags_record(chpl_comm_diags_execute_on, node, arg_size,
+                             diags_start);
   }
 }
 
@@ -1610,9 +2007,8 @@ void  chpl_comm_execute_on_nb(c_nodeid_t node, c_sublocid_t subloc,
     if (chpl_verbose_comm && !chpl_comm_no_debug_private)
       printf("%d: remote non-blocking task created on %d\n", chpl_nodeID, node);
     if (chpl_comm_diagnostics && !chpl_comm_no_debug_private) {
-      chpl_sync_lock(&chpl_comm_diagnostics_sync);
-      chpl_comm_commDiagnostics.execute_on_nb++;
-      chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+      chpl_comm_diags_incr(execute_on_nb);
+      chpl_comm_diags_record(chpl_comm_diags_execute_on_nb, node, arg_size, 0);
     }
   
     execute_on_common(node, subloc, fid, arg, arg_size,
@@ -1624,6 +2020,8 @@ void  chpl_comm_execute_on_nb(c_nodeid_t node, c_sublocid_t subloc,
 void  chpl_comm_execute_on_fast(c_nodeid_t node, c_sublocid_t subloc,
                           chpl_fn_int_t fid,
                           chpl_comm_on_bundle_t *arg, size_t arg_size) {
+  uint64_t diags_start = 0;
+
   if (chpl_nodeID == node) {
     assert(0);
     chpl_ftable_call(fid, arg);
@@ -1640,13 +2038,16 @@ void  chpl_comm_execute_on_fast(c_nodeid_t node, c_sublocid_t subloc,
       printf("%d: remote (no-fork) task created on %d\n",
              chpl_nodeID, node);
     if (chpl_comm_diagnostics && !chpl_comm_no_debug_private) {
-      chpl_sync_lock(&chpl_comm_diagnostics_sync);
-      chpl_comm_commDiagnostics.execute_on_fast++;
-      chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+      chpl_comm_diags_incr(execute_on_fast);
+      diags_start = chpl_comm_diags_clock();
     }
 
   execute_on_common(node, subloc, fid, arg, arg_size,
                     /*fast*/ true, /*blocking*/ true);
+
+    if (diags_start != 0)
+      chpl_comm_diags_record(chpl_comm_diags_execute_on_fast, node, arg_size,
+                             diags_start);
   }
 }
 
@@ -1655,6 +2056,194 @@ void chpl_comm_make_progress(void)
   gasnet_AMPoll();
 }
 
+//
+// Network atomics.
+//
+// Local AMOs are done right here.  Remote ones are sent to the target
+// node in an AM, and its handler does them there without creating a
+// task (see AM_amo()).  An unordered AMO doesn't wait for the reply;
+// instead the calling task counts it until the reply comes back, and
+// the task's fence waits for its count to drop to zero.  The count
+// lives in memory hung off the task-private data, so the handlers for
+// the replies can find it.  It is allocated when the task starts its
+// first unordered AMO, and freed by the fence.  Every task runs the
+// fence before it ends, so the count outlives its replies.
+//
+static
+atomic_uint_least64_t* task_amo_unordered(chpl_bool create) {
+  chpl_comm_taskPrvData_t* prv = &chpl_task_getPrvData()->comm_data;
+
+  if (prv->amo_unordered == NULL && create) {
+    atomic_uint_least64_t* pending;
+
+    pending = chpl_mem_alloc(sizeof(*pending), CHPL_RT_MD_COMM_UTIL, 0, 0);
+    atomic_init_uint_least64_t(pending, 0);
+    prv->amo_unordered = pending;
+  }
+  return (atomic_uint_least64_t*) prv->amo_unordered;
+}
+
+static inline
+void do_amo(amo_op_t op, amo_type_t type, size_t size,
+            void* opnd1, void* opnd2, int32_t node, void* obj,
+            void* res, size_t res_size, chpl_bool unordered) {
+  amo_req_t req;
+
+  req.ack  = NULL;
+  req.unordered = unordered;
+  req.obj  = obj;
+  req.op   = op;
+  req.type = type;
+  if (opnd1 != NULL)
+    memcpy(&req.opnd1, opnd1, size);
+  if (opnd2 != NULL)
+    memcpy(&req.opnd2, opnd2, size);
+
+  if (node == chpl_nodeID) {
+    amo_val_t my_res;
+    do_amo_on_cpu(&req, &my_res);
+    if (res != NULL)
+      memcpy(res, &my_res, res_size);
+    return;
+  }
+
+  if (chpl_verbose_comm && !chpl_comm_no_debug_private)
+    printf("%d: remote atomic on %d\n", chpl_nodeID, node);
+
+  if (unordered) {
+    atomic_uint_least64_t* pending = task_amo_unordered(true);
+
+    (void) atomic_fetch_add_uint_least64_t(pending, 1);
+    req.ack = pending;
+    GASNET_Safe(gasnet_AMRequestMedium0(node, AMO, &req, sizeof(req)));
+
+    // Nobody waits for an unordered AMO, so it has no latency.
+    if (chpl_comm_diagnostics && !chpl_comm_no_debug_private)
+      chpl_comm_diags_record(chpl_comm_diags_amo, node, size, 0);
+  } else {
+    amo_done_t d;
+    uint64_t diags_start = 0;
+
+    if (chpl_comm_diagnostics && !chpl_comm_no_debug_private)
+      diags_start = chpl_comm_diags_clock();
+
+    init_done_obj(&d.done, 1);
+    req.ack = &d;
+    GASNET_Safe(gasnet_AMRequestMedium0(node, AMO, &req, sizeof(req)));
+    wait_done_obj(&d.done);
+    if (res != NULL)
+      memcpy(res, &d.res, res_size);
+
+    if (diags_start != 0)
+      chpl_comm_diags_record(chpl_comm_diags_amo, node, size, diags_start);
+  }
+}
+
+#define AMO_SIZE(_f) sizeof(((amo_val_t*) NULL)->_f)
+
+#define DEFINE_CHPL_COMM_ATOMIC_PUT(_f)                                 \
+  void chpl_comm_atomic_put_##_f(void* desired, int32_t loc, void* obj, \
+                                 int ln, int32_t fn) {                  \
+    do_amo(amo_put, amo_##_f, AMO_SIZE(_f), desired, NULL, loc, obj,    \
+           NULL, 0, false);                                             \
+  }
+
+#define DEFINE_CHPL_COMM_ATOMIC_GET(_f)                                 \
+  void chpl_comm_atomic_get_##_f(void* result, int32_t loc, void* obj,  \
+                                 int ln, int32_t fn) {                  \
+    do_amo(amo_get, amo_##_f, AMO_SIZE(_f), NULL, NULL, loc, obj,       \
+           result, AMO_SIZE(_f), false);                                \
+  }
+
+#define DEFINE_CHPL_COMM_ATOMIC_XCHG(_f)                                \
+  void chpl_comm_atomic_xchg_##_f(void* desired, int32_t loc, void* obj, \
+                                  void* result, int ln, int32_t fn) {   \
+    do_amo(amo_xchg, amo_##_f, AMO_SIZE(_f), desired, NULL, loc, obj,   \
+           result, AMO_SIZE(_f), false);                                \
+  }
+
+#define DEFINE_CHPL_COMM_ATOMIC_CMPXCHG(_f)                             \
+  void chpl_comm_atomic_cmpxchg_##_f(void* expected, void* desired,     \
+                                     int32_t loc, void* obj,            \
+                                     chpl_bool32* result,               \
+                                     int ln, int32_t fn) {              \
+    do_amo(amo_cmpxchg, amo_##_f, AMO_SIZE(_f), expected, desired,      \
+           loc, obj, result, sizeof(*result), false);                   \
+  }
+
+#define DEFINE_CHPL_COMM_ATOMIC_BINARY(_o, _f)                          \
+  void chpl_comm_atomic_##_o##_##_f(void* operand, int32_t loc,         \
+                                    void* obj, int ln, int32_t fn) {    \
+    do_amo(amo_##_o, amo_##_f, AMO_SIZE(_f), operand, NULL, loc, obj,   \
+           NULL, 0, false);                                             \
+  }                                                                     \
+                                                                        \
+  void chpl_comm_atomic_fetch_##_o##_##_f(void* operand, int32_t loc,   \
+                                          void* obj, void* result,      \
+                                          int ln, int32_t fn) {         \
+    do_amo(amo_##_o, amo_##_f, AMO_SIZE(_f), operand, NULL, loc, obj,   \
+           result, AMO_SIZE(_f), false);                                \
+  }                                                                     \
+                                                                        \
+  void chpl_comm_atomic_##_o##_unordered_##_f(void* operand,            \
+                                              int32_t loc, void* obj,   \
+                                              int ln, int32_t fn) {     \
+    do_amo(amo_##_o, amo_##_f, AMO_SIZE(_f), operand, NULL, loc, obj,   \
+           NULL, 0, true);                                              \
+  }
+
+#define DEFINE_CHPL_COMM_ATOMIC_COMMON(_f)                              \
+  DEFINE_CHPL_COMM_ATOMIC_PUT(_f)                                       \
+  DEFINE_CHPL_COMM_ATOMIC_GET(_f)                                       \
+  DEFINE_CHPL_COMM_ATOMIC_XCHG(_f)                                      \
+  DEFINE_CHPL_COMM_ATOMIC_CMPXCHG(_f)                                   \
+  DEFINE_CHPL_COMM_ATOMIC_BINARY(add, _f)                               \
+  DEFINE_CHPL_COMM_ATOMIC_BINARY(sub, _f)
+
+#define DEFINE_CHPL_COMM_ATOMIC_INT(_f)                                 \
+  DEFINE_CHPL_COMM_ATOMIC_COMMON(_f)                                    \
+  DEFINE_CHPL_COMM_ATOMIC_BINARY(and, _f)                               \
+  DEFINE_CHPL_COMM_ATOMIC_BINARY(or, _f)                                \
+  DEFINE_CHPL_COMM_ATOMIC_BINARY(xor, _f)
+
+DEFINE_CHPL_COMM_ATOMIC_INT(int32)
+DEFINE_CHPL_COMM_ATOMIC_INT(int64)
+DEFINE_CHPL_COMM_ATOMIC_INT(uint32)
+DEFINE_CHPL_COMM_ATOMIC_INT(uint64)
+DEFINE_CHPL_COMM_ATOMIC_COMMON(real32)
+DEFINE_CHPL_COMM_ATOMIC_COMMON(real64)
+
+#undef DEFINE_CHPL_COMM_ATOMIC_PUT
+#undef DEFINE_CHPL_COMM_ATOMIC_GET
+#undef DEFINE_CHPL_COMM_ATOMIC_XCHG
+#undef DEFINE_CHPL_COMM_ATOMIC_CMPXCHG
+#undef DEFINE_CHPL_COMM_ATOMIC_BINARY
+#undef DEFINE_CHPL_COMM_ATOMIC_COMMON
+#undef DEFINE_CHPL_COMM_ATOMIC_INT
+#undef AMO_SIZE
+
+//
+// Wait for the unordered AMOs the calling task has started.
+//
+void chpl_comm_atomic_unordered_task_fence(void) {
+  atomic_uint_least64_t* pending = task_amo_unordered(false);
+
+  if (pending == NULL)
+    return;
+
+#ifndef CHPL_COMM_YIELD_TASK_WHILE_POLLING
+  GASNET_BLOCKUNTIL(atomic_load_uint_least64_t(pending) == 0);
+#else
+  while (atomic_load_uint_least64_t(pending) != 0) {
+    (void) gasnet_AMPoll();
+    chpl_task_yield();
+  }
+#endif
+
+  chpl_task_getPrvData()->comm_data.amo_unordered = NULL;
+  chpl_mem_free(pending, 0, 0);
+}
+
 
 void chpl_startVerboseComm() {
   chpl_verbose_comm = 1;
@@ -1705,15 +2294,11 @@ void chpl_stopCommDiagnosticsHere() {
 }
 
 void chpl_resetCommDiagnosticsHere() {
-  chpl_sync_lock(&chpl_comm_diagnostics_sync);
-  memset(&chpl_comm_commDiagnostics, 0, sizeof(chpl_commDiagnostics));
-  chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+  chpl_comm_diags_resetCountsHere();
 }
 
 void chpl_getCommDiagnosticsHere(chpl_commDiagnostics *cd) {
-  chpl_sync_lock(&chpl_comm_diagnostics_sync);
-  chpl_memcpy(cd, &chpl_comm_commDiagnostics, sizeof(chpl_commDiagnostics));
-  chpl_sync_unlock(&chpl_comm_diagnostics_sync);
+  chpl_comm_diags_getCountsHere(cd);
 }
 
 void chpl_comm_gasnet_help_register_global_var(int i, wide_ptr_t wide_addr) {
@@ -61,6 +61,7 @@ void chpl_comm_execute_on(c_nodeid_t node, c_sublocid_t subloc,
   assert(node != chpl_nodeID); // handled by the locale model
 
   CHPL_COMM_DIAGS_INC(execute_on);
+  CHPL_COMM_DIAGS_RECORD(execute_on, node, arg_size);
 
   if (chpl_comm_have_callbacks(chpl_comm_cb_event_kind_executeOn)) {
     chpl_comm_cb_info_t cb_data = 
@@ -84,6 +85,7 @@ void chpl_comm_execute_on_nb(c_nodeid_t node, c_sublocid_t subloc,
   assert(node != chpl_nodeID); // handled by the locale model
 
   CHPL_COMM_DIAGS_INC(execute_on_nb);
+  CHPL_COMM_DIAGS_RECORD(execute_on_nb, node, arg_size);
 
   if (chpl_comm_have_callbacks(chpl_comm_cb_event_kind_executeOn_nb)) {
     chpl_comm_cb_info_t cb_data = 
@@ -101,6 +103,7 @@ void chpl_comm_execute_on_fast(c_nodeid_t node, c_sublocid_t subloc,
   assert(node != chpl_nodeID); // handled by the locale model
 
   CHPL_COMM_DIAGS_INC(execute_on_fast);
+  CHPL_COMM_DIAGS_RECORD(execute_on_fast, node, arg_size);
 
   if (chpl_comm_have_callbacks(chpl_comm_cb_event_kind_executeOn_fast)) {
     chpl_comm_cb_info_t cb_data = 
@@ -0,0 +1,342 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chplrt.h"
+#include "chpl-env-gen.h"
+
+#include "rdma/fabric.h"
+#include "rdma/fi_atomic.h"
+#include "rdma/fi_domain.h"
+#include "rdma/fi_errno.h"
+
+#include "chpl-atomics.h"
+#include "chpl-comm.h"
+#include "chpl-mem.h"
+#include "chpl-tasks.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#include "comm-ofi-internal.h"
+
+//
+// Network atomics, done by the provider with fi_atomic() and friends.
+//
+// All AMOs go through the provider, even ones on this node, because
+// the provider's atomics need not be coherent with processor atomics
+// on the same location.  Not every provider supports every type and
+// operation; we find out which ones we can do at startup and halt if
+// the program asks for any other.
+//
+
+static struct ofi_stuff* ofi = NULL;
+
+//
+// Each AMO names one of these as its libfabric context.  An ordered
+// AMO waits on the stack for its flag.  An unordered one returns
+// right away, so its context is allocated, holds a copy of the
+// operand, and is freed when the completion shows up.  The calling
+// task counts its unordered AMOs until their completions show up, and
+// its fence waits for that count to drop to zero.  The count lives in
+// memory hung off the task-private data, allocated when the task
+// starts its first unordered AMO and freed by the fence.  Every task
+// runs the fence before it ends, so the count outlives the contexts
+// that point to it.
+//
+typedef struct {
+  volatile int           done;
+  atomic_uint_least64_t* pending;  // task's count, or NULL if ordered
+  uint64_t               opnd;
+} amo_ctx_t;
+
+typedef enum {
+  amo_plain,           // fi_atomic()
+  amo_fetch,           // fi_fetch_atomic()
+  amo_compare,         // fi_compare_atomic()
+  amo_num_kinds
+} amo_kind_t;
+
+static chpl_bool amo_valid[amo_num_kinds][FI_DATATYPE_LAST][FI_ATOMIC_OP_LAST];
+
+static const enum fi_datatype amo_types[] = {
+  FI_INT32, FI_INT64, FI_UINT32, FI_UINT64, FI_FLOAT, FI_DOUBLE
+};
+
+static const enum fi_op amo_ops[] = {
+  FI_ATOMIC_READ, FI_ATOMIC_WRITE, FI_CSWAP,
+  FI_BAND, FI_BOR, FI_BXOR, FI_SUM
+};
+
+void chpl_comm_ofi_atomics_init(struct ofi_stuff* _ofi) {
+  size_t i, j;
+  size_t count;
+
+  if (ofi != NULL) {
+    chpl_warning("ofi atomics already initialized.  Ignoring", 0, 0);
+    return;
+  }
+
+  ofi = _ofi;
+
+  for (i = 0; i < sizeof(amo_types) / sizeof(amo_types[0]); i++) {
+    for (j = 0; j < sizeof(amo_ops) / sizeof(amo_ops[0]); j++) {
+      enum fi_datatype t = amo_types[i];
+      enum fi_op o = amo_ops[j];
+      amo_valid[amo_plain][t][o]
+        = (fi_atomicvalid(ofi->tx_ep[0], t, o, &count) == FI_SUCCESS);
+      amo_valid[amo_fetch][t][o]
+        = (fi_fetch_atomicvalid(ofi->tx_ep[0], t, o, &count) == FI_SUCCESS);
+      amo_valid[amo_compare][t][o]
+        = (fi_compare_atomicvalid(ofi->tx_ep[0], t, o, &count)
+           == FI_SUCCESS);
+    }
+  }
+}
+
+static atomic_uint_least64_t* task_amo_unordered(chpl_bool create) {
+  chpl_comm_taskPrvData_t* prv = &chpl_task_getPrvData()->comm_data;
+
+  if (prv->amo_unordered == NULL && create) {
+    atomic_uint_least64_t* pending;
+
+    pending = chpl_mem_alloc(sizeof(*pending), CHPL_RT_MD_COMM_UTIL, 0, 0);
+    atomic_init_uint_least64_t(pending, 0);
+    prv->amo_unordered = pending;
+  }
+  return (atomic_uint_least64_t*) prv->amo_unordered;
+}
+
+static __thread int tx_index = -1;
+static inline int get_tx_index(void) {
+  if (tx_index == -1) {
+    tx_index = chpl_task_getId() % ofi->num_tx_ctx;
+  }
+  return tx_index;
+}
+
+//
+// Consume one completion, if there is one, from the given tx context.
+//
+static void amo_progress(int i) {
+  struct fi_cq_entry cqe;
+  ssize_t num_read;
+
+  num_read = fi_cq_read(ofi->tx_cq[i], &cqe, 1);
+  if (num_read > 0) {
+    amo_ctx_t* ctx = (amo_ctx_t*) cqe.op_context;
+    if (ctx->pending != NULL) {
+      atomic_uint_least64_t* pending = ctx->pending;
+      chpl_mem_free(ctx, 0, 0);
+      (void) atomic_fetch_sub_uint_least64_t(pending, 1);
+    } else {
+      ctx->done = 1;
+    }
+  } else if (num_read != -FI_EAGAIN) {
+    chpl_internal_error(fi_strerror(-num_read));
+  }
+}
+
+static inline size_t amo_size(enum fi_datatype type) {
+  return (type == FI_INT32 || type == FI_UINT32 || type == FI_FLOAT)
+         ? sizeof(int32_t) : sizeof(int64_t);
+}
+
+static void do_amo(amo_kind_t kind, enum fi_op op, enum fi_datatype type,
+                   void* opnd1, void* opnd2, int32_t node, void* obj,
+                   void* res, chpl_bool unordered) {
+  const int i = get_tx_index();
+  const fi_addr_t dest = ofi->rx_addrs[node][0];
+  const uint64_t addr = (uint64_t) (intptr_t) obj;
+  const uint64_t key = (uint64_t) node;
+  amo_ctx_t ctx = { 0 };
+  amo_ctx_t* ctxp = &ctx;
+
+  if (!amo_valid[kind][type][op]) {
+    chpl_internal_error("network atomic operation not supported by the "
+                        "libfabric provider (try CHPL_NETWORK_ATOMICS=none)");
+  }
+
+  if (unordered) {
+    assert(kind == amo_plain);
+    ctxp = chpl_mem_alloc(sizeof(*ctxp), CHPL_RT_MD_COMM_UTIL, 0, 0);
+    ctxp->done = 0;
+    ctxp->pending = task_amo_unordered(true);
+    memcpy(&ctxp->opnd, opnd1, amo_size(type));
+    opnd1 = &ctxp->opnd;
+    (void) atomic_fetch_add_uint_least64_t(ctxp->pending, 1);
+  }
+
+  switch (kind) {
+  case amo_plain:
+    OFICHKERR(fi_atomic(ofi->tx_ep[i], opnd1, 1, NULL,
+                        dest, addr, key, type, op, ctxp));
+    break;
+  case amo_fetch:
+    OFICHKERR(fi_fetch_atomic(ofi->tx_ep[i], opnd1, 1, NULL, res, NULL,
+                              dest, addr, key, type, op, ctxp));
+    break;
+  case amo_compare:
+    OFICHKERR(fi_compare_atomic(ofi->tx_ep[i], opnd2, 1, NULL,
+                                opnd1, NULL, res, NULL,
+                                dest, addr, key, type, op, ctxp));
+    break;
+  default:
+    chpl_internal_error("unexpected AMO kind");
+  }
+
+  if (node != chpl_nodeID) {
+    CHPL_COMM_DIAGS_RECORD(amo, node, amo_size(type));
+  }
+
+  if (!unordered) {
+    while (!ctx.done) {
+      amo_progress(i);
+      if (!ctx.done) {
+        chpl_task_yield();
+      }
+    }
+  }
+}
+
+#define DEFINE_CHPL_COMM_ATOMIC_PUT(_f, _d)                             \
+  void chpl_comm_atomic_put_##_f(void* desired, int32_t loc, void* obj, \
+                                 int ln, int32_t fn) {                  \
+    do_amo(amo_plain, FI_ATOMIC_WRITE, _d, desired, NULL, loc, obj,     \
+           NULL, false);                                                \
+  }
+
+#define DEFINE_CHPL_COMM_ATOMIC_GET(_f, _d)                             \
+  void chpl_comm_atomic_get_##_f(void* result, int32_t loc, void* obj,  \
+                                 int ln, int32_t fn) {                  \
+    do_amo(amo_fetch, FI_ATOMIC_READ, _d, result, NULL, loc, obj,       \
+           result, false);                                              \
+  }
+
+#define DEFINE_CHPL_COMM_ATOMIC_XCHG(_f, _d)                            \
+  void chpl_comm_atomic_xchg_##_f(void* desired, int32_t loc, void* obj, \
+                                  void* result, int ln, int32_t fn) {   \
+    do_amo(amo_fetch, FI_ATOMIC_WRITE, _d, desired, NULL, loc, obj,     \
+           result, false);                                              \
+  }
+
+#define DEFINE_CHPL_COMM_ATOMIC_CMPXCHG(_f, _d, _t)                     \
+  void chpl_comm_atomic_cmpxchg_##_f(void* expected, void* desired,     \
+                                     int32_t loc, void* obj,            \
+                                     chpl_bool32* result,               \
+                                     int ln, int32_t fn) {              \
+    _t old;                                                             \
+    do_amo(amo_compare, FI_CSWAP, _d, expected, desired, loc, obj,      \
+           &old, false);                                                \
+    *result = (memcmp(&old, expected, sizeof(old)) == 0);               \
+  }
+
+#define DEFINE_CHPL_COMM_ATOMIC_BINARY(_o, _f, _op, _d)                 \
+  void chpl_comm_atomic_##_o##_##_f(void* operand, int32_t loc,         \
+                                    void* obj, int ln, int32_t fn) {    \
+    do_amo(amo_plain, _op, _d, operand, NULL, loc, obj, NULL, false);   \
+  }                                                                     \
+                                                                        \
+  void chpl_comm_atomic_fetch_##_o##_##_f(void* operand, int32_t loc,   \
+                                          void* obj, void* result,      \
+                                          int ln, int32_t fn) {         \
+    do_amo(amo_fetch, _op, _d, operand, NULL, loc, obj, result, false); \
+  }                                                                     \
+                                                                        \
+  void chpl_comm_atomic_##_o##_unordered_##_f(void* operand,            \
+                                              int32_t loc, void* obj,   \
+                                              int ln, int32_t fn) {     \
+    do_amo(amo_plain, _op, _d, operand, NULL, loc, obj, NULL, true);    \
+  }
+
+//
+// libfabric has no subtract, so we add the negated operand.
+//
+#define DEFINE_CHPL_COMM_ATOMIC_SUB(_f, _d, _t)                         \
+  void chpl_comm_atomic_sub_##_f(void* operand, int32_t loc,            \
+                                 void* obj, int ln, int32_t fn) {       \
+    _t neg = -*(_t*) operand;                                           \
+    do_amo(amo_plain, FI_SUM, _d, &neg, NULL, loc, obj, NULL, false);   \
+  }                                                                     \
+                                                                        \
+  void chpl_comm_atomic_fetch_sub_##_f(void* operand, int32_t loc,      \
+                                       void* obj, void* result,         \
+                                       int ln, int32_t fn) {            \
+    _t neg = -*(_t*) operand;                                           \
+    do_amo(amo_fetch, FI_SUM, _d, &neg, NULL, loc, obj, result, false); \
+  }                                                                     \
+                                                                        \
+  void chpl_comm_atomic_sub_unordered_##_f(void* operand,               \
+                                           int32_t loc, void* obj,      \
+                                           int ln, int32_t fn) {        \
+    _t neg = -*(_t*) operand;                                           \
+    do_amo(amo_plain, FI_SUM, _d, &neg, NULL, loc, obj, NULL, true);    \
+  }
+
+#define DEFINE_CHPL_COMM_ATOMIC_COMMON(_f, _d, _t)                      \
+  DEFINE_CHPL_COMM_ATOMIC_PUT(_f, _d)                                   \
+  DEFINE_CHPL_COMM_ATOMIC_GET(_f, _d)                                   \
+  DEFINE_CHPL_COMM_ATOMIC_XCHG(_f, _d)                                  \
+  DEFINE_CHPL_COMM_ATOMIC_CMPXCHG(_f, _d, _t)                           \
+  DEFINE_CHPL_COMM_ATOMIC_BINARY(add, _f, FI_SUM, _d)                   \
+  DEFINE_CHPL_COMM_ATOMIC_SUB(_f, _d, _t)
+
+#define DEFINE_CHPL_COMM_ATOMIC_INT(_f, _d, _t)                         \
+  DEFINE_CHPL_COMM_ATOMIC_COMMON(_f, _d, _t)                            \
+  DEFINE_CHPL_COMM_ATOMIC_BINARY(and, _f, FI_BAND, _d)                  \
+  DEFINE_CHPL_COMM_ATOMIC_BINARY(or, _f, FI_BOR, _d)                    \
+  DEFINE_CHPL_COMM_ATOMIC_BINARY(xor, _f, FI_BXOR, _d)
+
+DEFINE_CHPL_COMM_ATOMIC_INT(int32, FI_INT32, int32_t)
+DEFINE_CHPL_COMM_ATOMIC_INT(int64, FI_INT64, int64_t)
+DEFINE_CHPL_COMM_ATOMIC_INT(uint32, FI_UINT32, uint32_t)
+DEFINE_CHPL_COMM_ATOMIC_INT(uint64, FI_UINT64, uint64_t)
+DEFINE_CHPL_COMM_ATOMIC_COMMON(real32, FI_FLOAT, float)
+DEFINE_CHPL_COMM_ATOMIC_COMMON(real64, FI_DOUBLE, double)
+
+#undef DEFINE_CHPL_COMM_ATOMIC_PUT
+#undef DEFINE_CHPL_COMM_ATOMIC_GET
+#undef DEFINE_CHPL_COMM_ATOMIC_XCHG
+#undef DEFINE_CHPL_COMM_ATOMIC_CMPXCHG
+#undef DEFINE_CHPL_COMM_ATOMIC_BINARY
+#undef DEFINE_CHPL_COMM_ATOMIC_SUB
+#undef DEFINE_CHPL_COMM_ATOMIC_COMMON
+#undef DEFINE_CHPL_COMM_ATOMIC_INT
+
+//
+// Wait for the unordered AMOs the calling task has started.  Their
+// completions can show up on any tx context, so we drain them all.
+//
+void chpl_comm_atomic_unordered_task_fence(void) {
+  atomic_uint_least64_t* pending = task_amo_unordered(false);
+  int i;
+
+  if (pending == NULL)
+    return;
+
+  while (atomic_load_uint_least64_t(pending) != 0) {
+    for (i = 0; i < ofi->num_tx_ctx; i++) {
+      amo_progress(i);
+    }
+    chpl_task_yield();
+  }
+
+  chpl_task_getPrvData()->comm_data.amo_unordered = NULL;
+  chpl_mem_free(pending, 0, 0);
+}
@@ -21,16 +21,20 @@
 #include "chpl-gen-includes.h"
 #include "comm-ofi-internal.h"
 
-static struct commDiags_atomic comm_diagnostics;
 static int chpl_comm_diags_enabled = 1; // for masking diags
 
-struct commDiags_atomic *chpl_comm_ofi_getCommDiags() {
-  return &comm_diagnostics;
+chpl_bool chpl_comm_ofi_commDiagsOn() {
+  return chpl_comm_diagnostics && chpl_comm_diags_enabled;
 }
 
-void chpl_comm_ofi_commDiagsInc(atomic_uint_least64_t *val) {
-  if (chpl_comm_diagnostics && chpl_comm_diags_enabled) {
-     atomic_fetch_add_uint_least64_t(val, 1);
+//
+// Operations don't wait for completion here yet, so we don't have
+// latencies to record.
+//
+void chpl_comm_ofi_commDiagsRecord(chpl_comm_diags_op_t op, c_nodeid_t node,
+                                   size_t bytes) {
+  if (chpl_comm_ofi_commDiagsOn()) {
+    chpl_comm_diags_record(op, node, bytes, 0);
   }
 }
 
@@ -89,27 +93,9 @@ void chpl_stopCommDiagnosticsHere() {
 }
 
 void chpl_resetCommDiagnosticsHere() {
-  atomic_store_uint_least64_t(&comm_diagnostics.get, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.get_nb, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.put, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.put_nb, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.test_nb, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.wait_nb, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.try_nb, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.execute_on, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.execute_on_fast, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.execute_on_nb, 0);
+  chpl_comm_diags_resetCountsHere();
 }
 
 void chpl_getCommDiagnosticsHere(chpl_commDiagnostics *cd) {
-  cd->get = atomic_load_uint_least64_t(&comm_diagnostics.get);
-  cd->get_nb = atomic_load_uint_least64_t(&comm_diagnostics.get_nb);
-  cd->put = atomic_load_uint_least64_t(&comm_diagnostics.put);
-  cd->put_nb = atomic_load_uint_least64_t(&comm_diagnostics.put_nb);
-  cd->test_nb = atomic_load_uint_least64_t(&comm_diagnostics.test_nb);
-  cd->wait_nb = atomic_load_uint_least64_t(&comm_diagnostics.wait_nb);
-  cd->try_nb = atomic_load_uint_least64_t(&comm_diagnostics.try_nb);
-  cd->execute_on = atomic_load_uint_least64_t(&comm_diagnostics.execute_on);
-  cd->execute_on_fast = atomic_load_uint_least64_t(&comm_diagnostics.execute_on_fast);
-  cd->execute_on_nb = atomic_load_uint_least64_t(&comm_diagnostics.execute_on_nb);
+  chpl_comm_diags_getCountsHere(cd);
 }
@@ -26,6 +26,8 @@
 #include "rdma/fi_cm.h"
 #include "rdma/fi_errno.h"
 
+#include "chpl-comm-diags.h"
+
 #define CALL_CHECK(fncall, errcode)                                     \
     do {                                                                \
       if ((fncall) != errcode) {                                        \
@@ -97,6 +99,12 @@ struct ofi_stuff {
 
 void chpl_comm_ofi_put_get_init(struct ofi_stuff*);
 
+//
+// Network atomics
+//
+
+void chpl_comm_ofi_atomics_init(struct ofi_stuff*);
+
 //
 // Active Messages (executeOn)
 //
@@ -118,24 +126,18 @@ void chpl_comm_ofi_am_handler(struct fi_cq_data_entry*);
 // Comm diagnostics
 //
 
-/* Dupe of the version in chpl-comm.h except with atomics */
-struct commDiags_atomic {
-  atomic_uint_least64_t get;
-  atomic_uint_least64_t get_nb;
-  atomic_uint_least64_t put;
-  atomic_uint_least64_t put_nb;
-  atomic_uint_least64_t test_nb;
-  atomic_uint_least64_t wait_nb;
-  atomic_uint_least64_t try_nb;
-  atomic_uint_least64_t execute_on;
-  atomic_uint_least64_t execute_on_fast;
-  atomic_uint_least64_t execute_on_nb;
-};
-
-struct commDiags_atomic *chpl_comm_ofi_getCommDiags(void);
-void chpl_comm_ofi_commDiagsInc(atomic_uint_least64_t *val);
+chpl_bool chpl_comm_ofi_commDiagsOn(void);
 
 #define CHPL_COMM_DIAGS_INC(comm_type)                                  \
-    chpl_comm_ofi_commDiagsInc(&(chpl_comm_ofi_getCommDiags()->comm_type))
+    do {                                                                \
+      if (chpl_comm_ofi_commDiagsOn())                                  \
+        chpl_comm_diags_incr(comm_type);                                \
+    } while (0)
+
+void chpl_comm_ofi_commDiagsRecord(chpl_comm_diags_op_t op, c_nodeid_t node,
+                                   size_t bytes);
+
+#define CHPL_COMM_DIAGS_RECORD(comm_type, node, bytes)                  \
+    chpl_comm_ofi_commDiagsRecord(chpl_comm_diags_##comm_type, node, bytes)
 
 #endif
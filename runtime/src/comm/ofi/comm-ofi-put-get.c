@@ -93,6 +93,7 @@ chpl_comm_nb_handle_t chpl_comm_put_nb(void *addr, c_nodeid_t node,
   }
 
   CHPL_COMM_DIAGS_INC(put_nb);
+  CHPL_COMM_DIAGS_RECORD(put_nb, node, size);
 
   return ofi_put(chpl_comm_cb_event_kind_put_nb,
                  addr, node, raddr, size, typeIndex, commID, ln, fn);
@@ -108,6 +109,7 @@ chpl_comm_nb_handle_t chpl_comm_get_nb(void* addr, c_nodeid_t node,
   }
 
   CHPL_COMM_DIAGS_INC(get_nb);
+  CHPL_COMM_DIAGS_RECORD(get_nb, node, size);
 
   return ofi_get(chpl_comm_cb_event_kind_get_nb,
                  addr, node, raddr, size, typeIndex, commID, ln, fn);
@@ -149,6 +151,7 @@ void  chpl_comm_put(void* addr, c_nodeid_t node, void* raddr,
   }
 
   CHPL_COMM_DIAGS_INC(put);
+  CHPL_COMM_DIAGS_RECORD(put, node, size);
 
   handle = ofi_put(chpl_comm_cb_event_kind_put,
                    addr, node, raddr, size, typeIndex, commID, ln, fn);
@@ -168,6 +171,7 @@ void  chpl_comm_get(void* addr, int32_t node, void* raddr,
   }
 
   CHPL_COMM_DIAGS_INC(get);
+  CHPL_COMM_DIAGS_RECORD(get, node, size);
 
   handle = ofi_get(chpl_comm_cb_event_kind_get,
                    addr, node, raddr, size, typeIndex, commID, ln, fn);
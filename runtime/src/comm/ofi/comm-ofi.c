@@ -115,6 +115,7 @@ void chpl_comm_post_task_init(void) {
 
   libfabric_init();
   chpl_comm_ofi_put_get_init(&ofi);
+  chpl_comm_ofi_atomics_init(&ofi);
   chpl_comm_ofi_am_init(&ofi);
 
   if (num_progress_threads > 0) {
@@ -464,6 +465,8 @@ void chpl_comm_barrier(const char *msg) {
 }
 
 void chpl_comm_pre_task_exit(int all) {
+  chpl_comm_atomic_unordered_task_fence();
+
   if (all) {
     chpl_comm_barrier("chpl_comm_pre_task_exit");
 
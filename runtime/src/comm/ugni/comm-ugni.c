@@ -46,6 +46,7 @@
 #include "chpl-comm.h"
 #include "chpl-comm-callbacks.h"
 #include "chpl-comm-callbacks-internal.h"
+#include "chpl-comm-diags.h"
 #include "chpl-env.h"
 #include "chpl-mem.h"
 #include "chplsys.h"
@@ -1254,30 +1255,6 @@ static volatile chpl_bool polling_task_please_exit = false;
 static volatile chpl_bool polling_task_done        = false;
 
 
-//
-// Comm diagnostic information.  The local_commDiagnostics_t type must
-// be kept in sync with the public chpl_commDiagnostics type defined
-// in chpl-comm.h.  We need our own diagnostic counter type because we
-// want to use atomic operations, and doing so requires specific types
-// for the individual counters.  Strictly speaking it is not necessary
-// that we put the individual counters in a struct type, but it seems
-// best to maintain similarity with how things are done elsewhere.
-//
-typedef struct {
-  atomic_uint_least64_t get;
-  atomic_uint_least64_t get_nb;
-  atomic_uint_least64_t put;
-  atomic_uint_least64_t put_nb;
-  atomic_uint_least64_t test_nb;
-  atomic_uint_least64_t wait_nb;
-  atomic_uint_least64_t try_nb;
-  atomic_uint_least64_t execute_on;
-  atomic_uint_least64_t execute_on_fast;
-  atomic_uint_least64_t execute_on_nb;
-} local_commDiagnostics_t;
-
-static local_commDiagnostics_t comm_diagnostics;
-
 static chpl_bool comm_diags_disabled_temporarily = false;
 
 
@@ -2640,17 +2617,6 @@ void set_up_for_polling(void)
 
 void chpl_comm_rollcall(void)
 {
-  atomic_init_uint_least64_t(&comm_diagnostics.get, 0);
-  atomic_init_uint_least64_t(&comm_diagnostics.get_nb, 0);
-  atomic_init_uint_least64_t(&comm_diagnostics.put, 0);
-  atomic_init_uint_least64_t(&comm_diagnostics.put_nb, 0);
-  atomic_init_uint_least64_t(&comm_diagnostics.test_nb, 0);
-  atomic_init_uint_least64_t(&comm_diagnostics.wait_nb, 0);
-  atomic_init_uint_least64_t(&comm_diagnostics.try_nb, 0);
-  atomic_init_uint_least64_t(&comm_diagnostics.execute_on, 0);
-  atomic_init_uint_least64_t(&comm_diagnostics.execute_on_fast, 0);
-  atomic_init_uint_least64_t(&comm_diagnostics.execute_on_nb, 0);
-
   chpl_msg(2, "executing on node %d of %d node(s): %s\n", chpl_nodeID,
            chpl_numNodes, chpl_nodeName());
 
@@ -4512,6 +4478,8 @@ void chpl_comm_put(void* addr, c_nodeid_t locale, void* raddr,
                    size_t size, int32_t typeIndex,
                    int32_t commID, int ln, int32_t fn)
 {
+  uint64_t diags_start = 0;
+
   DBG_P_LP(DBGF_IFACE|DBGF_GETPUT, "IFACE chpl_comm_put(%p, %d, %p, %zd)",
            addr, (int) locale, raddr, size);
 
@@ -4536,10 +4504,15 @@ void chpl_comm_put(void* addr, c_nodeid_t locale, void* raddr,
   if (chpl_verbose_comm && !comm_diags_disabled_temporarily)
     printf("%d: %s:%d: remote put to %d\n", chpl_nodeID,
            chpl_lookupFilename(fn), ln, locale);
-  if (chpl_comm_diagnostics && !comm_diags_disabled_temporarily)
-    (void) atomic_fetch_add_uint_least64_t(&comm_diagnostics.put, 1);
+  if (chpl_comm_diagnostics && !comm_diags_disabled_temporarily) {
+    chpl_comm_diags_incr(put);
+    diags_start = chpl_comm_diags_clock();
+  }
 
   do_remote_put(addr, locale, raddr, size, NULL, may_proxy_true);
+
+  if (diags_start != 0)
+    chpl_comm_diags_record(chpl_comm_diags_put, locale, size, diags_start);
 }
 
 
@@ -4754,6 +4727,8 @@ void chpl_comm_get(void* addr, c_nodeid_t locale, void* raddr,
                    size_t size, int32_t typeIndex,
                    int32_t commID, int ln, int32_t fn)
 {
+  uint64_t diags_start = 0;
+
   DBG_P_LP(DBGF_IFACE|DBGF_GETPUT, "IFACE chpl_comm_get(%p, %d, %p, %zd)",
            addr, (int) locale, raddr, size);
 
@@ -4778,10 +4753,15 @@ void chpl_comm_get(void* addr, c_nodeid_t locale, void* raddr,
   if (chpl_verbose_comm && !comm_diags_disabled_temporarily)
     printf("%d: %s:%d: remote get from %d\n", chpl_nodeID,
            chpl_lookupFilename(fn), ln, locale);
-  if (chpl_comm_diagnostics && !comm_diags_disabled_temporarily)
-    (void) atomic_fetch_add_uint_least64_t(&comm_diagnostics.get, 1);
+  if (chpl_comm_diagnostics && !comm_diags_disabled_temporarily) {
+    chpl_comm_diags_incr(get);
+    diags_start = chpl_comm_diags_clock();
+  }
 
   do_remote_get(addr, locale, raddr, size, may_proxy_true);
+
+  if (diags_start != 0)
+    chpl_comm_diags_record(chpl_comm_diags_get, locale, size, diags_start);
 }
 
 
@@ -5094,6 +5074,13 @@ void  chpl_comm_put_strd(void* dstaddr_arg, size_t* dststrides,
 
   PERFSTATS_INC(put_strd_cnt);
 
+  if (chpl_comm_diagnostics && !comm_diags_disabled_temporarily) {
+    size_t bytes = elemSize;
+    for (i = 0; i <= strlvls; i++)
+      bytes *= count[i];
+    chpl_comm_diags_record(chpl_comm_diags_put_strd, dstlocale, bytes, 0);
+  }
+
   // Communications callback support
   if (chpl_comm_have_callbacks(chpl_comm_cb_event_kind_put_strd)) {
       chpl_comm_cb_info_t cb_data =
@@ -5247,6 +5234,13 @@ void  chpl_comm_get_strd(void* dstaddr_arg, size_t* dststrides,
 
   PERFSTATS_INC(get_strd_cnt);
 
+  if (chpl_comm_diagnostics && !comm_diags_disabled_temporarily) {
+    size_t bytes = elemSize;
+    for (i = 0; i <= strlvls; i++)
+      bytes *= count[i];
+    chpl_comm_diags_record(chpl_comm_diags_get_strd, srclocale, bytes, 0);
+  }
+
   // Communications callback support
   if (chpl_comm_have_callbacks(chpl_comm_cb_event_kind_get_strd)) {
     chpl_comm_cb_info_t cb_data =
@@ -5421,8 +5415,10 @@ chpl_comm_nb_handle_t chpl_comm_get_nb(void* addr, c_nodeid_t locale,
   if (chpl_verbose_comm && !comm_diags_disabled_temporarily)
     printf("%d: %s:%d: remote non-blocking get from %d\n",
            chpl_nodeID, chpl_lookupFilename(fn), ln, locale);
-  if (chpl_comm_diagnostics && !comm_diags_disabled_temporarily)
-    (void) atomic_fetch_add_uint_least64_t(&comm_diagnostics.get_nb, 1);
+  if (chpl_comm_diagnostics && !comm_diags_disabled_temporarily) {
+    chpl_comm_diags_incr(get_nb);
+    chpl_comm_diags_record(chpl_comm_diags_get_nb, locale, size, 0);
+  }
 
   //
   // For now, if the local address isn't in a memory region known to the
@@ -5526,7 +5522,7 @@ int chpl_comm_test_nb_complete(chpl_comm_nb_handle_t h)
     printf("%d: test nb complete (%d, %d)\n", chpl_nodeID, i, j);
   }
   if (chpl_comm_diagnostics && !comm_diags_disabled_temporarily)
-    (void) atomic_fetch_add_uint_least64_t(&comm_diagnostics.test_nb, 1);
+    chpl_comm_diags_incr(test_nb);
 
   PERFSTATS_INC(test_nb_cnt);
 
@@ -5546,7 +5542,7 @@ void chpl_comm_wait_nb_some(chpl_comm_nb_handle_t* h, size_t nhandles)
       printf("%d: wait nb (%zd handles)\n", chpl_nodeID, nhandles);
   }
   if (chpl_comm_diagnostics && !comm_diags_disabled_temporarily)
-    (void) atomic_fetch_add_uint_least64_t(&comm_diagnostics.wait_nb, 1);
+    chpl_comm_diags_incr(wait_nb);
 
   PERFSTATS_INC(wait_nb_cnt);
 
@@ -5597,7 +5593,7 @@ int chpl_comm_try_nb_some(chpl_comm_nb_handle_t* h, size_t nhandles)
       printf("%d: try nb (%zd handles)\n", chpl_nodeID, nhandles);
   }
   if (chpl_comm_diagnostics && !comm_diags_disabled_temporarily)
-    (void) atomic_fetch_add_uint_least64_t(&comm_diagnostics.try_nb, 1);
+    chpl_comm_diags_incr(try_nb);
 
   PERFSTATS_INC(try_nb_cnt);
 
@@ -6187,6 +6183,61 @@ DEFINE_CHPL_COMM_ATOMIC_SUB(real64, double)
 #undef DEFINE_CHPL_COMM_ATOMIC_SUB
 
 
+//
+// Unordered atomics:
+//   _f: interface function name suffix (type)
+//   _o: AMO operation
+//
+// The NIC AMOs are already cheap to issue, so for now these are just
+// the ordered ones, and there is nothing left for a fence to wait for.
+//
+#define DEFINE_CHPL_COMM_ATOMIC_UNORDERED(_f, _o)                       \
+        /*==============================*/                              \
+        void chpl_comm_atomic_##_o##_unordered_##_f(void* opnd,         \
+                                                    int32_t loc,        \
+                                                    void* obj,          \
+                                                    int ln, int32_t fn) \
+        {                                                               \
+          chpl_comm_atomic_##_o##_##_f(opnd, loc, obj, ln, fn);         \
+        }
+
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(int32, and)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(int64, and)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(uint32, and)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(uint64, and)
+
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(int32, or)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(int64, or)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(uint32, or)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(uint64, or)
+
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(int32, xor)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(int64, xor)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(uint32, xor)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(uint64, xor)
+
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(int32, add)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(int64, add)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(uint32, add)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(uint64, add)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(real32, add)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(real64, add)
+
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(int32, sub)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(int64, sub)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(uint32, sub)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(uint64, sub)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(real32, sub)
+DEFINE_CHPL_COMM_ATOMIC_UNORDERED(real64, sub)
+
+#undef DEFINE_CHPL_COMM_ATOMIC_UNORDERED
+
+
+void chpl_comm_atomic_unordered_task_fence(void)
+{
+}
+
+
 static
 inline
 int amo_cmd_2_nic_op(fork_amo_cmd_t cmd, int fetching)
@@ -6220,6 +6271,7 @@ void do_nic_amo(void* opnd1, void* opnd2, c_nodeid_t locale,
   void*                 p_result = result;
   fork_amo_data_t       tmp_result;
   gni_post_descriptor_t post_desc;
+  uint64_t              diags_start = 0;
 
   if (size == 4) {
     if (!IS_ALIGNED_32(VP_TO_UI64(object)))
@@ -6292,8 +6344,15 @@ void do_nic_amo(void* opnd1, void* opnd2, c_nodeid_t locale,
   //
   PERFSTATS_INC(amo_cnt);
 
+  if (locale != chpl_nodeID
+      && chpl_comm_diagnostics && !comm_diags_disabled_temporarily)
+    diags_start = chpl_comm_diags_clock();
+
   post_fma_and_wait(locale, &post_desc, true);
 
+  if (diags_start != 0)
+    chpl_comm_diags_record(chpl_comm_diags_amo, locale, size, diags_start);
+
   if (p_result != result) {
     memcpy(result, p_result, size);
     if (p_result != &tmp_result)
@@ -6356,6 +6415,8 @@ void chpl_comm_execute_on(c_nodeid_t locale, c_sublocid_t subloc,
                           chpl_fn_int_t fid,
                           chpl_comm_on_bundle_t* arg, size_t arg_size)
 {
+  uint64_t diags_start = 0;
+
   DBG_P_LP(DBGF_IFACE|DBGF_RF,
            "IFACE chpl_comm_execute_on(%d:%d, ftable[%d](%p, %zd))",
            (int) locale, (int) subloc, (int) fid, arg, arg_size);
@@ -6372,11 +6433,17 @@ void chpl_comm_execute_on(c_nodeid_t locale, c_sublocid_t subloc,
 
   if (chpl_verbose_comm && !comm_diags_disabled_temporarily)
     printf("%d: remote task created on %d\n", chpl_nodeID, locale);
-  if (chpl_comm_diagnostics && !comm_diags_disabled_temporarily)
-    (void) atomic_fetch_add_uint_least64_t(&comm_diagnostics.execute_on, 1);
+  if (chpl_comm_diagnostics && !comm_diags_disabled_temporarily) {
+    chpl_comm_diags_incr(execute_on);
+    diags_start = chpl_comm_diags_clock();
+  }
 
   PERFSTATS_INC(fork_call_cnt);
   fork_call_common(locale, subloc, fid, arg, arg_size, false, true);
+
+  if (diags_start != 0)
+    chpl_comm_diags_record(chpl_comm_diags_execute_on, locale, arg_size,
+                           diags_start);
 }
 
 
@@ -6401,8 +6468,10 @@ void chpl_comm_execute_on_nb(c_nodeid_t locale, c_sublocid_t subloc,
   if (chpl_verbose_comm && !comm_diags_disabled_temporarily)
     printf("%d: remote non-blocking task created on %d\n", chpl_nodeID,
            locale);
-  if (chpl_comm_diagnostics && !comm_diags_disabled_temporarily)
-    (void) atomic_fetch_add_uint_least64_t(&comm_diagnostics.execute_on_nb, 1);
+  if (chpl_comm_diagnostics && !comm_diags_disabled_temporarily) {
+    chpl_comm_diags_incr(execute_on_nb);
+    chpl_comm_diags_record(chpl_comm_diags_execute_on_nb, locale, arg_size, 0);
+  }
 
   PERFSTATS_INC(fork_call_nb_cnt);
   fork_call_common(locale, subloc, fid, arg, arg_size, false, false);
@@ -6413,6 +6482,8 @@ void chpl_comm_execute_on_fast(c_nodeid_t locale, c_sublocid_t subloc,
                                chpl_fn_int_t fid,
                                chpl_comm_on_bundle_t* arg, size_t arg_size)
 {
+  uint64_t diags_start = 0;
+
   DBG_P_LP(DBGF_IFACE|DBGF_RF,
            "IFACE chpl_comm_execute_on_fast(%d:%d, ftable[%d](%p, %zd))",
            (int) locale, (int) subloc, (int) fid, arg, arg_size);
@@ -6430,8 +6501,10 @@ void chpl_comm_execute_on_fast(c_nodeid_t locale, c_sublocid_t subloc,
   if (chpl_verbose_comm && !comm_diags_disabled_temporarily)
     printf("%d: remote (no-fork) task created on %d\n",
            chpl_nodeID, locale);
-  if (chpl_comm_diagnostics && !comm_diags_disabled_temporarily)
-    (void) atomic_fetch_add_uint_least64_t(&comm_diagnostics.execute_on_fast, 1);
+  if (chpl_comm_diagnostics && !comm_diags_disabled_temporarily) {
+    chpl_comm_diags_incr(execute_on_fast);
+    diags_start = chpl_comm_diags_clock();
+  }
 
   //
   // Note: the rf_handler() logic assumes that fast implies blocking.
@@ -6439,6 +6512,10 @@ void chpl_comm_execute_on_fast(c_nodeid_t locale, c_sublocid_t subloc,
   //
   PERFSTATS_INC(fork_call_fast_cnt);
   fork_call_common(locale, subloc, fid, arg, arg_size, true, true);
+
+  if (diags_start != 0)
+    chpl_comm_diags_record(chpl_comm_diags_execute_on_fast, locale, arg_size,
+                           diags_start);
 }
 
 
@@ -7235,16 +7312,7 @@ void chpl_stopCommDiagnosticsHere()
 
 void chpl_resetCommDiagnosticsHere()
 {
-  atomic_store_uint_least64_t(&comm_diagnostics.get, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.get_nb, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.put, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.put_nb, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.test_nb, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.wait_nb, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.try_nb, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.execute_on, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.execute_on_fast, 0);
-  atomic_store_uint_least64_t(&comm_diagnostics.execute_on_nb, 0);
+  chpl_comm_diags_resetCountsHere();
 
 #define _PSV_STORE(psv) atomic_store_uint_least64_t(&_PSV_VAR(psv), 0);
   PERFSTATS_DO_ALL(_PSV_STORE);
@@ -7254,16 +7322,7 @@ void chpl_resetCommDiagnosticsHere()
 
 void chpl_getCommDiagnosticsHere(chpl_commDiagnostics *cd)
 {
-  cd->get             = atomic_load_uint_least64_t(&comm_diagnostics.get);
-  cd->get_nb          = atomic_load_uint_least64_t(&comm_diagnostics.get_nb);
-  cd->put             = atomic_load_uint_least64_t(&comm_diagnostics.put);
-  cd->put_nb          = atomic_load_uint_least64_t(&comm_diagnostics.put_nb);
-  cd->test_nb         = atomic_load_uint_least64_t(&comm_diagnostics.test_nb);
-  cd->wait_nb         = atomic_load_uint_least64_t(&comm_diagnostics.wait_nb);
-  cd->try_nb          = atomic_load_uint_least64_t(&comm_diagnostics.try_nb);
-  cd->execute_on      = atomic_load_uint_least64_t(&comm_diagnostics.execute_on);
-  cd->execute_on_fast = atomic_load_uint_least64_t(&comm_diagnostics.execute_on_fast);
-  cd->execute_on_nb   = atomic_load_uint_least64_t(&comm_diagnostics.execute_on_nb);
+  chpl_comm_diags_getCountsHere(cd);
 }
 
 void chpl_comm_ugni_help_register_global_var(int i, wide_ptr_t wide)
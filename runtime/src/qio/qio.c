@@ -36,6 +36,7 @@
 #endif
 
 #include "qio.h"
+#include "qio_async.h"
 #include "qbuffer.h"
 
 #include "error.h"
@@ -223,7 +224,8 @@ error:
   return err;
 }
 
-qioerr qio_preadv(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, ssize_t* num_read)
+static
+qioerr _qio_preadv(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, int async, ssize_t* num_read)
 {
   ssize_t nread = 0;
   int64_t num_bytes = qbuffer_iter_num_bytes(start, end);
@@ -249,9 +251,12 @@ qioerr qio_preadv(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffe
   if( err ) goto error;
 
   // read into our buffer.
-  if (file->fd != -1) // Do we have an fd?
-    err = qio_int_to_err(sys_preadv(file->fd, iov, iovcnt, seek_to_offset, &nread));
-  else 
+  if (file->fd != -1) { // Do we have an fd?
+    if (async)
+      err = qio_int_to_err(qio_async_preadv(file->fd, iov, iovcnt, seek_to_offset, &nread));
+    else
+      err = qio_int_to_err(sys_preadv(file->fd, iov, iovcnt, seek_to_offset, &nread));
+  } else 
   if (file->fsfns){ // Have something
     if (file->fsfns->preadv) {// We have preadv
       err = file->fsfns->preadv(file->file_info, iov, iovcnt, seek_to_offset, &nread, file->fs_info);
@@ -268,6 +273,11 @@ error:
 
 }
 
+qioerr qio_preadv(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, ssize_t* num_read)
+{
+  return _qio_preadv(file, buf, start, end, seek_to_offset, 0, num_read);
+}
+
 qioerr qio_freadv(FILE* fp, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, ssize_t* num_read)
 {
   int64_t total_read = 0;
@@ -365,7 +375,8 @@ error:
 
 
 
-qioerr qio_pwritev(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, ssize_t* num_written)
+static
+qioerr _qio_pwritev(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, int async, ssize_t* num_written)
 {
   ssize_t nwritten = 0;
   int64_t num_bytes = qbuffer_iter_num_bytes(start, end);
@@ -391,9 +402,12 @@ qioerr qio_pwritev(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuff
   if( err ) goto error;
 
   // write from our buffer
-  if (file->fd != -1) // So see if we have an fd we can use
-    err = qio_int_to_err(sys_pwritev(file->fd, iov, iovcnt, seek_to_offset, &nwritten));
-  else // Don't have an fd
+  if (file->fd != -1) { // So see if we have an fd we can use
+    if (async)
+      err = qio_int_to_err(qio_async_pwritev(file->fd, iov, iovcnt, seek_to_offset, &nwritten));
+    else
+      err = qio_int_to_err(sys_pwritev(file->fd, iov, iovcnt, seek_to_offset, &nwritten));
+  } else // Don't have an fd
   if (file->fsfns) { // We have something
     if (file->fsfns->pwritev) { // Do we have pwritev
       err = file->fsfns->pwritev(file->file_info, iov, iovcnt, seek_to_offset, &nwritten, file->fs_info);
@@ -410,6 +424,11 @@ error:
   return err;
 }
 
+qioerr qio_pwritev(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, ssize_t* num_written)
+{
+  return _qio_pwritev(file, buf, start, end, seek_to_offset, 0, num_written);
+}
+
 qioerr qio_recv(fd_t sockfd, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int flags,
               sys_sockaddr_t* src_addr_out, /* can be NULL */
               void* ancillary_out, socklen_t* ancillary_len_inout, /* can be NULL */
@@ -556,6 +575,12 @@ qio_hint_t choose_io_method(qio_file_t* file, qio_hint_t hints, qio_hint_t defau
     } else method = QIO_METHOD_READWRITE; // Else we can't seek, so set to use readv and writev
 
   } else { // Regular FS. So do what we did before
+    if( method == QIO_METHOD_ASYNC &&
+        (isfilestar || !(fdflags & QIO_FDFLAG_SEEKABLE)) ) {
+      // Async I/O is positional; choose something else for
+      // pipes, sockets and FILE*s.
+      method = QIO_METHOD_DEFAULT;
+    }
     if( method < QIO_MIN_METHOD || method > QIO_MAX_METHOD ) {
       // bad method number. Use default, or choose one.
       if( default_hints & QIO_METHODMASK ) {
@@ -2341,6 +2366,9 @@ qioerr _buffered_read_atleast(qio_channel_t* ch, int64_t amt)
       case QIO_METHOD_PREADPWRITE:
         err = qio_preadv(ch->file, &ch->buf, read_start, read_end, read_start.offset, &num_read);
         break;
+      case QIO_METHOD_ASYNC:
+        err = _qio_preadv(ch->file, &ch->buf, read_start, read_end, read_start.offset, 1, &num_read);
+        break;
       case QIO_METHOD_FREADFWRITE:
         err = qio_freadv(ch->file->fp, &ch->buf, read_start, read_end, &num_read);
         break;
@@ -2571,6 +2599,9 @@ qioerr _qio_buffered_behind(qio_channel_t* ch, int flushall)
         case QIO_METHOD_PREADPWRITE:
           err = qio_pwritev(ch->file, &ch->buf, write_start, write_end, write_start.offset, &num_written);
           break;
+        case QIO_METHOD_ASYNC:
+          err = _qio_pwritev(ch->file, &ch->buf, write_start, write_end, write_start.offset, 1, &num_written);
+          break;
         case QIO_METHOD_FREADFWRITE:
           err = qio_fwritev(ch->file->fp, &ch->buf, write_start, write_end, &num_written);
           break;
@@ -2798,6 +2829,14 @@ qioerr _qio_unbuffered_write(qio_channel_t* ch, const void* ptr, ssize_t len_in,
         case QIO_METHOD_PREADPWRITE:
           err = qio_int_to_err(sys_pwrite(ch->file->fd, ptr, len, _right_mark_start(ch), &num_written));
           break;
+        case QIO_METHOD_ASYNC:
+          {
+            struct iovec iov;
+            iov.iov_base = (void*) ptr;
+            iov.iov_len = len;
+            err = qio_int_to_err(qio_async_pwritev(ch->file->fd, &iov, 1, _right_mark_start(ch), &num_written));
+          }
+          break;
         case QIO_METHOD_FREADFWRITE:
           if( ch->file->fp ) {
             num_written_u = fwrite(ptr, 1, len, ch->file->fp);
@@ -2888,6 +2927,14 @@ qioerr _qio_unbuffered_read(qio_channel_t* ch, void* ptr, ssize_t len_in, ssize_
         case QIO_METHOD_PREADPWRITE:
           err = qio_int_to_err(sys_pread(ch->file->fd, ptr, len, _right_mark_start(ch), &num_read));
           break;
+        case QIO_METHOD_ASYNC:
+          {
+            struct iovec iov;
+            iov.iov_base = ptr;
+            iov.iov_len = len;
+            err = qio_int_to_err(qio_async_preadv(ch->file->fd, &iov, 1, _right_mark_start(ch), &num_read));
+          }
+          break;
         case QIO_METHOD_FREADFWRITE:
           if( ch->file->fp ) {
             num_read_u = fread(ptr, 1, len, ch->file->fp);
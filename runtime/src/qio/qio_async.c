@@ -0,0 +1,528 @@
+/*
+ * Copyright 2004-2018 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "sys_basic.h"
+
+#ifndef CHPL_RT_UNIT_TEST
+#include "chplrt.h"
+#include "chpl-env.h"
+#include "chpl-tasks.h"
+#endif
+
+#include "qio_async.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define QIO_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+// One outstanding read or write.  These live on the stack of the
+// task that issued them, which does not return until done is set.
+typedef struct qio_async_req_s {
+  int writing;
+  fd_t fd;
+  const struct iovec* iov;
+  int iovcnt;
+  off_t offset;
+
+  ssize_t result;
+  err_t err;
+  int done;
+
+  struct qio_async_req_s* next;
+} qio_async_req_t;
+
+typedef enum {
+  QIO_ASYNC_ENGINE_SYNC,
+  QIO_ASYNC_ENGINE_THREADS,
+  QIO_ASYNC_ENGINE_URING
+} qio_async_engine_t;
+
+static pthread_once_t async_once = PTHREAD_ONCE_INIT;
+static qio_async_engine_t async_engine = QIO_ASYNC_ENGINE_THREADS;
+
+
+static
+const char* async_env(const char* ev)
+{
+#ifndef CHPL_RT_UNIT_TEST
+  return chpl_env_rt_get(ev, NULL);
+#else
+  char buf[64];
+  snprintf(buf, sizeof(buf), "CHPL_RT_%s", ev);
+  return getenv(buf);
+#endif
+}
+
+// Let some other task run while we wait for a request to complete.
+static inline
+void async_yield(void)
+{
+#ifndef CHPL_RT_UNIT_TEST
+  chpl_task_yield();
+#else
+  sched_yield();
+#endif
+}
+
+static inline
+int async_is_done(qio_async_req_t* req)
+{
+  return __atomic_load_n(&req->done, __ATOMIC_ACQUIRE);
+}
+
+static inline
+void async_set_done(qio_async_req_t* req)
+{
+  __atomic_store_n(&req->done, 1, __ATOMIC_RELEASE);
+}
+
+
+//
+// Thread-pool engine
+//
+// A fixed set of pthreads pops requests off a shared FIFO and runs
+// them with the ordinary synchronous calls.  Only the pool threads
+// block in the kernel; the issuing tasks yield until their request
+// is marked done.
+//
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_cond = PTHREAD_COND_INITIALIZER;
+static qio_async_req_t* pool_head;
+static qio_async_req_t* pool_tail;
+
+static
+void* pool_worker(void* arg)
+{
+  (void) arg;
+
+  while( 1 ) {
+    qio_async_req_t* req;
+
+    pthread_mutex_lock(&pool_lock);
+    while( pool_head == NULL )
+      pthread_cond_wait(&pool_cond, &pool_lock);
+    req = pool_head;
+    pool_head = req->next;
+    if( pool_head == NULL ) pool_tail = NULL;
+    pthread_mutex_unlock(&pool_lock);
+
+    req->result = 0;
+    if( req->writing )
+      req->err = sys_pwritev(req->fd, req->iov, req->iovcnt,
+                             req->offset, &req->result);
+    else
+      req->err = sys_preadv(req->fd, req->iov, req->iovcnt,
+                            req->offset, &req->result);
+    async_set_done(req);
+  }
+
+  return NULL;
+}
+
+static
+int pool_init(void)
+{
+  const char* s = async_env("QIO_ASYNC_THREADS");
+  int nthreads = (s != NULL) ? atoi(s) : 4;
+  int started = 0;
+  int i;
+
+  if( nthreads < 1 ) nthreads = 1;
+
+  for( i = 0; i < nthreads; i++ ) {
+    pthread_t thread;
+    pthread_attr_t attr;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    if( pthread_create(&thread, &attr, pool_worker, NULL) == 0 ) started++;
+    pthread_attr_destroy(&attr);
+  }
+
+  return started > 0;
+}
+
+static
+void pool_submit(qio_async_req_t* req)
+{
+  req->next = NULL;
+  pthread_mutex_lock(&pool_lock);
+  if( pool_tail ) pool_tail->next = req;
+  else pool_head = req;
+  pool_tail = req;
+  pthread_cond_signal(&pool_cond);
+  pthread_mutex_unlock(&pool_lock);
+}
+
+
+#ifdef QIO_HAS_IO_URING
+//
+// io_uring engine
+//
+// There is one ring per locale.  A task adds its SQE under ring_lock
+// and then submits every SQE queued so far with a single
+// io_uring_enter, so tasks issuing I/O at the same time share system
+// calls.  Completions are reaped by whichever waiting task gets there
+// first; each CQE carries a pointer to its request.
+//
+#define URING_ENTRIES 256
+
+static struct {
+  int fd;
+  unsigned entries;
+
+  unsigned* sq_head;
+  unsigned* sq_tail;
+  unsigned* sq_mask;
+  unsigned* sq_array;
+  struct io_uring_sqe* sqes;
+
+  unsigned* cq_head;
+  unsigned* cq_tail;
+  unsigned* cq_mask;
+  struct io_uring_cqe* cqes;
+
+  // SQEs added but not yet handed to the kernel
+  unsigned pending;
+  // requests submitted but not yet reaped; bounded by entries so the
+  // completion ring (2*entries) can never overflow
+  unsigned inflight;
+} ring;
+
+static pthread_mutex_t ring_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static
+int uring_init(void)
+{
+  struct io_uring_params p;
+  size_t sq_sz, cq_sz;
+  char* sq_ptr = MAP_FAILED;
+  char* cq_ptr = MAP_FAILED;
+  void* sqes;
+  int fd;
+
+  memset(&p, 0, sizeof(p));
+  fd = (int) syscall(__NR_io_uring_setup, URING_ENTRIES, &p);
+  if( fd < 0 ) return 0;
+
+  sq_sz = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+  cq_sz = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  if( p.features & IORING_FEAT_SINGLE_MMAP ) {
+    if( cq_sz > sq_sz ) sq_sz = cq_sz;
+    cq_sz = sq_sz;
+  }
+
+  sq_ptr = mmap(NULL, sq_sz, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+                fd, IORING_OFF_SQ_RING);
+  if( sq_ptr == MAP_FAILED ) goto error;
+
+  if( p.features & IORING_FEAT_SINGLE_MMAP ) {
+    cq_ptr = sq_ptr;
+  } else {
+    cq_ptr = mmap(NULL, cq_sz, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+                  fd, IORING_OFF_CQ_RING);
+    if( cq_ptr == MAP_FAILED ) goto error;
+  }
+
+  sqes = mmap(NULL, p.sq_entries * sizeof(struct io_uring_sqe),
+              PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+              fd, IORING_OFF_SQES);
+  if( sqes == MAP_FAILED ) goto error;
+
+  ring.fd = fd;
+  ring.entries = p.sq_entries;
+  ring.sq_head = (unsigned*) (sq_ptr + p.sq_off.head);
+  ring.sq_tail = (unsigned*) (sq_ptr + p.sq_off.tail);
+  ring.sq_mask = (unsigned*) (sq_ptr + p.sq_off.ring_mask);
+  ring.sq_array = (unsigned*) (sq_ptr + p.sq_off.array);
+  ring.sqes = (struct io_uring_sqe*) sqes;
+  ring.cq_head = (unsigned*) (cq_ptr + p.cq_off.head);
+  ring.cq_tail = (unsigned*) (cq_ptr + p.cq_off.tail);
+  ring.cq_mask = (unsigned*) (cq_ptr + p.cq_off.ring_mask);
+  ring.cqes = (struct io_uring_cqe*) (cq_ptr + p.cq_off.cqes);
+  ring.pending = 0;
+  ring.inflight = 0;
+
+  return 1;
+
+error:
+  if( cq_ptr != MAP_FAILED && cq_ptr != sq_ptr ) munmap(cq_ptr, cq_sz);
+  if( sq_ptr != MAP_FAILED ) munmap(sq_ptr, sq_sz);
+  close(fd);
+  return 0;
+}
+
+// Move any available completions to their requests.
+// Must be called with ring_lock held.
+static
+void uring_reap_locked(void)
+{
+  unsigned head = *ring.cq_head;
+  unsigned tail = __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE);
+
+  while( head != tail ) {
+    struct io_uring_cqe* cqe = &ring.cqes[head & *ring.cq_mask];
+    qio_async_req_t* req = (qio_async_req_t*) (uintptr_t) cqe->user_data;
+
+    if( cqe->res < 0 ) {
+      req->result = 0;
+      req->err = -cqe->res;
+    } else {
+      req->result = cqe->res;
+      req->err = 0;
+    }
+    async_set_done(req);
+    ring.inflight--;
+    head++;
+  }
+
+  __atomic_store_n(ring.cq_head, head, __ATOMIC_RELEASE);
+}
+
+// Hand every queued SQE to the kernel.
+static
+void uring_flush(void)
+{
+  unsigned n;
+  int ret;
+
+  if( __atomic_load_n(&ring.pending, __ATOMIC_RELAXED) == 0 ) return;
+
+  pthread_mutex_lock(&ring_lock);
+  n = ring.pending;
+  ring.pending = 0;
+  pthread_mutex_unlock(&ring_lock);
+
+  if( n == 0 ) return;
+
+  ret = (int) syscall(__NR_io_uring_enter, ring.fd, n, 0, 0, NULL, 0);
+  if( ret < 0 ) ret = 0;
+  if( (unsigned) ret < n ) {
+    // EAGAIN/EBUSY or a short submit; leave the rest for the next flush.
+    pthread_mutex_lock(&ring_lock);
+    ring.pending += n - ret;
+    pthread_mutex_unlock(&ring_lock);
+  }
+}
+
+static
+void uring_submit(qio_async_req_t* req)
+{
+  while( 1 ) {
+    unsigned tail, idx;
+    struct io_uring_sqe* sqe;
+
+    pthread_mutex_lock(&ring_lock);
+    uring_reap_locked();
+    tail = *ring.sq_tail;
+    if( ring.inflight >= ring.entries ||
+        tail - __atomic_load_n(ring.sq_head, __ATOMIC_ACQUIRE) >= ring.entries ) {
+      // Ring is full; let the kernel and the other tasks make progress.
+      pthread_mutex_unlock(&ring_lock);
+      uring_flush();
+      async_yield();
+      continue;
+    }
+
+    idx = tail & *ring.sq_mask;
+    sqe = &ring.sqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = req->writing ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->fd = req->fd;
+    sqe->addr = (uint64_t) (uintptr_t) req->iov;
+    sqe->len = req->iovcnt;
+    sqe->off = req->offset;
+    sqe->user_data = (uint64_t) (uintptr_t) req;
+    ring.sq_array[idx] = idx;
+    __atomic_store_n(ring.sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ring.pending++;
+    ring.inflight++;
+    pthread_mutex_unlock(&ring_lock);
+    break;
+  }
+
+  uring_flush();
+}
+
+// Reap any completions, without waiting for the lock or the kernel.
+// Waiting tasks call this between yields, so if another task holds the
+// lock we just try again on the next call.
+static
+void uring_poll(void)
+{
+  uring_flush();
+
+  if( __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE) ==
+      __atomic_load_n(ring.cq_head, __ATOMIC_RELAXED) )
+    return;
+
+  if( pthread_mutex_trylock(&ring_lock) == 0 ) {
+    uring_reap_locked();
+    pthread_mutex_unlock(&ring_lock);
+  }
+}
+#endif
+
+
+static
+void async_init(void)
+{
+  const char* engine = async_env("QIO_ASYNC_ENGINE");
+  int want_uring = (engine == NULL || 0 == strcmp(engine, "uring"));
+
+#ifdef QIO_HAS_IO_URING
+  if( want_uring && uring_init() ) {
+    async_engine = QIO_ASYNC_ENGINE_URING;
+    return;
+  }
+#else
+  (void) want_uring;
+#endif
+
+  async_engine = QIO_ASYNC_ENGINE_THREADS;
+  if( ! pool_init() ) {
+    // Could not start any helpers; pool_submit would never complete.
+    // Requests are run inline instead (see async_run).
+    async_engine = QIO_ASYNC_ENGINE_SYNC;
+  }
+}
+
+const char* qio_async_engine_name(void)
+{
+  pthread_once(&async_once, async_init);
+  switch( async_engine ) {
+    case QIO_ASYNC_ENGINE_URING:
+      return "uring";
+    case QIO_ASYNC_ENGINE_THREADS:
+      return "threads";
+    case QIO_ASYNC_ENGINE_SYNC:
+      return "sync";
+  }
+  return "unknown";
+}
+
+// Run one request, which covers at most IOV_MAX iovecs, to completion.
+static
+void async_run(qio_async_req_t* req)
+{
+  req->done = 0;
+
+  switch( async_engine ) {
+#ifdef QIO_HAS_IO_URING
+    case QIO_ASYNC_ENGINE_URING:
+      uring_submit(req);
+      while( ! async_is_done(req) ) {
+        async_yield();
+        uring_poll();
+      }
+      return;
+#endif
+    case QIO_ASYNC_ENGINE_THREADS:
+      pool_submit(req);
+      while( ! async_is_done(req) ) async_yield();
+      return;
+    default:
+      break;
+  }
+
+  // QIO_ASYNC_ENGINE_SYNC
+
+  req->result = 0;
+  if( req->writing )
+    req->err = sys_pwritev(req->fd, req->iov, req->iovcnt,
+                           req->offset, &req->result);
+  else
+    req->err = sys_preadv(req->fd, req->iov, req->iovcnt,
+                          req->offset, &req->result);
+}
+
+static
+err_t async_rw(int writing, fd_t fd, const struct iovec* iov, int iovcnt, off_t seek_to_offset, ssize_t* num_out)
+{
+  ssize_t got_total = 0;
+  err_t err_out = 0;
+  int i;
+  int niovs;
+
+  pthread_once(&async_once, async_init);
+
+  // Like sys_preadv/sys_pwritev, split into IOV_MAX pieces and stop
+  // at the first short transfer; callers loop for the rest.
+  for( i = 0; i < iovcnt; i += niovs ) {
+    qio_async_req_t req;
+
+    niovs = iovcnt - i;
+    if( niovs > IOV_MAX ) niovs = IOV_MAX;
+
+    req.writing = writing;
+    req.fd = fd;
+    req.iov = &iov[i];
+    req.iovcnt = niovs;
+    req.offset = seek_to_offset + got_total;
+    async_run(&req);
+
+    if( req.err ) {
+      err_out = req.err;
+      break;
+    }
+    got_total += req.result;
+    if( req.result != sys_iov_total_bytes(&iov[i], niovs) ) break;
+  }
+
+  if( ! writing && err_out == 0 && got_total == 0 &&
+      sys_iov_total_bytes(iov, iovcnt) != 0 ) err_out = EEOF;
+
+  *num_out = got_total;
+
+  return err_out;
+}
+
+err_t qio_async_preadv(fd_t fd, const struct iovec* iov, int iovcnt, off_t seek_to_offset, ssize_t* num_read_out)
+{
+  return async_rw(0, fd, iov, iovcnt, seek_to_offset, num_read_out);
+}
+
+err_t qio_async_pwritev(fd_t fd, const struct iovec* iov, int iovcnt, off_t seek_to_offset, ssize_t* num_written_out)
+{
+  return async_rw(1, fd, iov, iovcnt, seek_to_offset, num_written_out);
+}
@@ -24,7 +24,9 @@
 #include "chplrt.h"
 #include "chpl_rt_utils_static.h"
 #include "chplcgfns.h"
+#include "chpl-atomics.h"
 #include "chpl-comm.h"
+#include "chpl-env.h"
 #include "chplexit.h"
 #include "chpl-locale-model.h"
 #include "chpl-mem.h"
@@ -48,6 +50,11 @@
 //
 // task pool: linked list of tasks
 //
+// In work-stealing mode (CHPL_RT_TASKS_WORK_STEALING) the pool only
+// holds moved tasks, tasks created by threads that have no deque, and
+// deque overflow.  Everything else lives on the creating thread's
+// deque; see "Work stealing" below.
+//
 typedef struct task_pool_struct* task_pool_p;
 
 typedef struct {
@@ -61,6 +68,9 @@ typedef struct task_pool_struct {
   task_pool_p      next;         // double-link pointers for pool
   task_pool_p      prev;
 
+  atomic_bool          claimed;  // work stealing: task has been started
+  atomic_int_least32_t refs;     // work stealing: deque/pool/list refs
+
   chpl_task_prvDataImpl_t chpl_data;
 
   chpl_task_bundle_t bundle; // ends in a variable-length array
@@ -76,10 +86,29 @@ typedef struct lockReport {
 } lockReport_t;
 
 
+//
+// Work-stealing deque (Chase-Lev).  The owning thread pushes and takes
+// at the bottom (LIFO); other threads steal from the top (FIFO).  The
+// buffer is fixed-size; when it fills up, new tasks go to the shared
+// task pool instead, so we never have to reclaim a buffer that a thief
+// might still be reading.
+//
+#define TASK_DEQUE_SIZE 1024  // must be a power of 2
+
+typedef struct {
+  atomic_int_least64_t top;
+  char                 pad[64];  // keep thieves off the owner's line
+  atomic_int_least64_t bottom;
+  atomic_uintptr_t     buf[TASK_DEQUE_SIZE];
+} task_deque_t;
+
+
 // This is the data that is private to each thread.
 typedef struct {
   task_pool_p   ptask;
   lockReport_t* lockRprt;
+  task_deque_t* deque;      // work stealing: our deque, if we have one
+  uint32_t      steal_seed; // work stealing: victim selection state
 } thread_private_data_t;
 
 
@@ -94,14 +123,17 @@ static volatile task_pool_p
 static volatile task_pool_p
                            task_pool_tail;     // tail of task pool
 
-static int                 queued_task_cnt;    // number of tasks in task pool
+static atomic_int_least32_t
+                           queued_task_cnt;    // number of tasks in task pool
 static int64_t             extra_task_cnt;     // number of tasks being run by
                                                //   threads occupied already
 static int                 blocked_thread_cnt; // number of threads that
                                                //   cannot make progress
-static int                 idle_thread_cnt;    // number of threads looking
+static atomic_int_least32_t
+                           idle_thread_cnt;    // number of threads looking
                                                //   for work
-static uint64_t            progress_cnt;       // number of unblock operations,
+static atomic_uint_least64_t
+                           progress_cnt;       // number of unblock operations,
                                                //   as a proxy for progress
 
 static chpl_thread_mutex_t block_report_lock;   // critical section lock
@@ -113,11 +145,28 @@ static chpl_thread_mutex_t taskTable_lock;     // critical section lock
 
 static chpl_fn_p comm_task_fn;
 
+static chpl_bool           work_stealing = false; // per-thread deques?
+static task_deque_t**      ws_deques;          // deques of all workers
+static int                 ws_max_deques;      // capacity of ws_deques
+static atomic_int_least32_t
+                           ws_num_deques;      // number registered so far
+
 //
 // Internal functions.
 //
 static void                    enqueue_task(task_pool_p, task_pool_p*);
 static void                    dequeue_task(task_pool_p);
+static chpl_bool               task_pool_nonempty(void);
+static void                    execute_task_inline(task_pool_p, task_pool_p);
+static void                    ws_init(void);
+static void                    ws_register_thread(thread_private_data_t*);
+static void                    ws_enqueue_task(task_pool_p, task_pool_p*,
+                                               chpl_bool, chpl_bool);
+static task_pool_p             ws_find_task(thread_private_data_t*);
+static chpl_bool               ws_claim_task(task_pool_p);
+static void                    ws_release_task(task_pool_p);
+static void                    ws_drop_claimed(task_deque_t*);
+static void                    ws_compact_deque(task_deque_t*);
 static void                    comm_task_wrapper(void*);
 static void                    taskCallBody(chpl_fn_int_t, chpl_fn_p,
                                             chpl_task_bundle_t*, size_t,
@@ -137,6 +186,7 @@ static void                    check_for_deadlock(void);
 static void                    thread_begin(void*);
 static void                    thread_end(void);
 static void                    maybe_add_thread(void);
+static void                    announce_task(task_pool_p);
 static task_pool_p             add_to_task_pool(chpl_fn_int_t, chpl_fn_p,
                                                 chpl_task_bundle_t*, size_t,
                                                 chpl_bool, task_pool_p*,
@@ -212,7 +262,7 @@ static void sync_wait_and_lock(chpl_sync_aux_t *s,
   }
 
   if (blockreport)
-    progress_cnt++;
+    (void) atomic_fetch_add_uint_least64_t(&progress_cnt, 1);
 }
 
 void chpl_sync_lock(chpl_sync_aux_t *s) {
@@ -333,14 +383,18 @@ void chpl_task_init(void) {
   chpl_thread_mutexInit(&extra_task_lock);
   chpl_thread_mutexInit(&task_id_lock);
   chpl_thread_mutexInit(&task_list_lock);
-  queued_task_cnt = 0;
+  atomic_init_int_least32_t(&queued_task_cnt, 0);
   blocked_thread_cnt = 0;
-  idle_thread_cnt = 0;
+  atomic_init_int_least32_t(&idle_thread_cnt, 0);
   extra_task_cnt = 0;
   task_pool_head = task_pool_tail = NULL;
 
   chpl_thread_init(thread_begin, thread_end);
 
+  work_stealing = chpl_env_rt_get_bool("TASKS_WORK_STEALING", false);
+  if (work_stealing)
+    ws_init();
+
   //
   // Set main thread private data, so that things that require access
   // to it, like chpl_task_getID() and chpl_task_setSerial(), can be
@@ -354,7 +408,7 @@ void chpl_task_init(void) {
   setup_main_thread_private_data();
 
   if (blockreport) {
-    progress_cnt = 0;
+    atomic_init_uint_least64_t(&progress_cnt, 0);
     chpl_thread_mutexInit(&block_report_lock);
   }
 
@@ -381,6 +435,10 @@ static void* do_callMain(void* arg) {
   // make sure this thread has thread-private data.
   setup_main_thread_private_data();
 
+  // the main task creates tasks too, so give it a deque to put them on
+  if (work_stealing)
+    ws_register_thread(chpl_thread_getPrivateData());
+
   // make sure that the lock report is set up.
   if (blockreport)
     initializeLockReportForThread();
@@ -521,7 +579,7 @@ static void comm_task_wrapper(void* arg) {
 //
 static inline
 void enqueue_task(task_pool_p ptask, task_pool_p* p_task_list_head) {
-  queued_task_cnt++;
+  (void) atomic_fetch_add_int_least32_t(&queued_task_cnt, 1);
 
   //
   // Add to pool.
@@ -552,8 +610,8 @@ void enqueue_task(task_pool_p ptask, task_pool_p* p_task_list_head) {
 
 static inline
 void dequeue_task(task_pool_p ptask) {
-  assert(queued_task_cnt > 0);
-  queued_task_cnt--;
+  assert(atomic_load_int_least32_t(&queued_task_cnt) > 0);
+  (void) atomic_fetch_sub_int_least32_t(&queued_task_cnt, 1);
 
   //
   // Remove from pool.
@@ -596,7 +654,8 @@ void chpl_task_addToTaskList(chpl_fn_int_t fid,
   assert(subloc == c_sublocid_any);
 
   // begin critical section
-  chpl_thread_mutexLock(&threading_lock);
+  if (!work_stealing)
+    chpl_thread_mutexLock(&threading_lock);
 
   if (task_list_locale == chpl_nodeID) {
     (void) add_to_task_pool(fid, chpl_ftable[fid], arg, arg_size,
@@ -616,7 +675,8 @@ void chpl_task_addToTaskList(chpl_fn_int_t fid,
   }
 
   // end critical section
-  chpl_thread_mutexUnlock(&threading_lock);
+  if (!work_stealing)
+    chpl_thread_mutexUnlock(&threading_lock);
 }
 
 
@@ -630,6 +690,78 @@ void chpl_task_executeTasksInList(void** p_task_list_void) {
 
   curr_ptask = get_current_ptask();
 
+  if (work_stealing) {
+    task_pool_p next_ptask;
+    chpl_bool is_begin_list;
+
+    if (*p_task_list_head == NULL)
+      return;
+
+    //
+    // If this is a begin list, its first task could be claimed and
+    // freed out from under us, so look at it under the lock.
+    //
+    chpl_thread_mutexLock(&task_list_lock);
+    is_begin_list = (*p_task_list_head != NULL
+                     && (*p_task_list_head)->p_list_head != NULL);
+    chpl_thread_mutexUnlock(&task_list_lock);
+
+    if (!is_begin_list) {
+      //
+      // A cobegin/coforall list.  Only the task that built it walks
+      // it, and nobody else unlinks from it, so no locking is needed.
+      // Tasks some other thread already claimed are just skipped.
+      // Either way we drop the list's reference.
+      //
+      child_ptask = *p_task_list_head;
+      *p_task_list_head = NULL;
+      while (child_ptask != NULL) {
+        next_ptask = child_ptask->list_next;
+        if (ws_claim_task(child_ptask))
+          execute_task_inline(curr_ptask, child_ptask);
+        ws_release_task(child_ptask);
+        child_ptask = next_ptask;
+      }
+    }
+    else {
+      //
+      // A begin list.  Other tasks may be adding to it and whoever
+      // claims a task unlinks it, all under task_list_lock, so anything
+      // still on the list is unclaimed.
+      //
+      while (*p_task_list_head != NULL) {
+        chpl_thread_mutexLock(&task_list_lock);
+        if ((child_ptask = *p_task_list_head) != NULL) {
+          atomic_store_bool(&child_ptask->claimed, true);
+          if ((*p_task_list_head = child_ptask->list_next) != NULL)
+            child_ptask->list_next->list_prev = NULL;
+        }
+        chpl_thread_mutexUnlock(&task_list_lock);
+
+        if (child_ptask == NULL)
+          break;
+
+        (void) atomic_fetch_sub_int_least32_t(&queued_task_cnt, 1);
+        execute_task_inline(curr_ptask, child_ptask);
+        ws_release_task(child_ptask);
+      }
+    }
+
+    //
+    // Tasks we just ran inline that we'd also pushed on our own deque
+    // are sitting at the bottom of it.  Drop those entries now, rather
+    // than leaving them to pile up until this thread next looks for
+    // work, which it may not do for a long time.
+    //
+    {
+      thread_private_data_t* tp =
+        (thread_private_data_t*) chpl_thread_getPrivateData();
+      if (tp != NULL && tp->deque != NULL)
+        ws_drop_claimed(tp->deque);
+    }
+    return;
+  }
+
   while (*p_task_list_head != NULL) {
     chpl_fn_p task_to_run_fun = NULL;
 
@@ -647,61 +779,70 @@ void chpl_task_executeTasksInList(void** p_task_list_void) {
     if (task_to_run_fun == NULL)
       continue;
 
-    set_current_ptask(child_ptask);
+    execute_task_inline(curr_ptask, child_ptask);
+    chpl_mem_free(child_ptask, 0, 0);
+  }
+}
+
 
-    // begin critical section
-    chpl_thread_mutexLock(&extra_task_lock);
+//
+// Run a task from a task list on the current thread, in place of the
+// task that owns the list.
+//
+static void execute_task_inline(task_pool_p curr_ptask,
+                                task_pool_p child_ptask) {
+  set_current_ptask(child_ptask);
 
-    extra_task_cnt++;
+  // begin critical section
+  chpl_thread_mutexLock(&extra_task_lock);
 
-    // end critical section
-    chpl_thread_mutexUnlock(&extra_task_lock);
+  extra_task_cnt++;
 
-    if (do_taskReport) {
-      chpl_thread_mutexLock(&taskTable_lock);
-      chpldev_taskTable_set_suspended(curr_ptask->bundle.id);
-      chpldev_taskTable_set_active(child_ptask->bundle.id);
-      chpl_thread_mutexUnlock(&taskTable_lock);
-    }
+  // end critical section
+  chpl_thread_mutexUnlock(&extra_task_lock);
 
-    if (blockreport)
-      initializeLockReportForThread();
+  if (do_taskReport) {
+    chpl_thread_mutexLock(&taskTable_lock);
+    chpldev_taskTable_set_suspended(curr_ptask->bundle.id);
+    chpldev_taskTable_set_active(child_ptask->bundle.id);
+    chpl_thread_mutexUnlock(&taskTable_lock);
+  }
 
-    chpl_task_do_callbacks(chpl_task_cb_event_kind_begin,
-                           child_ptask->bundle.requested_fid,
-                           child_ptask->bundle.filename,
-                           child_ptask->bundle.lineno,
-                           child_ptask->bundle.id,
-                           child_ptask->bundle.is_executeOn);
+  if (blockreport)
+    initializeLockReportForThread();
 
-    (*task_to_run_fun)(&child_ptask->bundle);
+  chpl_task_do_callbacks(chpl_task_cb_event_kind_begin,
+                         child_ptask->bundle.requested_fid,
+                         child_ptask->bundle.filename,
+                         child_ptask->bundle.lineno,
+                         child_ptask->bundle.id,
+                         child_ptask->bundle.is_executeOn);
 
-    chpl_task_do_callbacks(chpl_task_cb_event_kind_end,
-                           child_ptask->bundle.requested_fid,
-                           child_ptask->bundle.filename,
-                           child_ptask->bundle.lineno,
-                           child_ptask->bundle.id,
-                           child_ptask->bundle.is_executeOn);
+  (*child_ptask->bundle.requested_fn)(&child_ptask->bundle);
 
-    if (do_taskReport) {
-      chpl_thread_mutexLock(&taskTable_lock);
-      chpldev_taskTable_set_active(curr_ptask->bundle.id);
-      chpldev_taskTable_remove(child_ptask->bundle.id);
-      chpl_thread_mutexUnlock(&taskTable_lock);
-    }
+  chpl_task_do_callbacks(chpl_task_cb_event_kind_end,
+                         child_ptask->bundle.requested_fid,
+                         child_ptask->bundle.filename,
+                         child_ptask->bundle.lineno,
+                         child_ptask->bundle.id,
+                         child_ptask->bundle.is_executeOn);
 
-    // begin critical section
-    chpl_thread_mutexLock(&extra_task_lock);
+  if (do_taskReport) {
+    chpl_thread_mutexLock(&taskTable_lock);
+    chpldev_taskTable_set_active(curr_ptask->bundle.id);
+    chpldev_taskTable_remove(child_ptask->bundle.id);
+    chpl_thread_mutexUnlock(&taskTable_lock);
+  }
 
-    extra_task_cnt--;
+  // begin critical section
+  chpl_thread_mutexLock(&extra_task_lock);
 
-    // end critical section
-    chpl_thread_mutexUnlock(&extra_task_lock);
+  extra_task_cnt--;
 
-    set_current_ptask(curr_ptask);
-    chpl_mem_free(child_ptask, 0, 0);
+  // end critical section
+  chpl_thread_mutexUnlock(&extra_task_lock);
 
-  }
+  set_current_ptask(curr_ptask);
 }
 
 
@@ -719,13 +860,15 @@ void taskCallBody(chpl_fn_int_t fid, chpl_fn_p fp,
                   c_sublocid_t subloc,
                   int lineno, int32_t filename) {
   // begin critical section
-  chpl_thread_mutexLock(&threading_lock);
+  if (!work_stealing)
+    chpl_thread_mutexLock(&threading_lock);
 
   (void) add_to_task_pool(fid, fp, arg, arg_size, true,
                           NULL, false, lineno, filename);
 
   // end critical section
-  chpl_thread_mutexUnlock(&threading_lock);
+  if (!work_stealing)
+    chpl_thread_mutexUnlock(&threading_lock);
 }
 
 
@@ -847,7 +990,7 @@ size_t chpl_task_getCallStackSize(void) {
 }
 
 uint32_t chpl_task_getNumQueuedTasks(void) {
-  return queued_task_cnt;
+  return atomic_load_int_least32_t(&queued_task_cnt);
 }
 
 int32_t chpl_task_getNumBlockedTasks(void) {
@@ -858,7 +1001,8 @@ int32_t chpl_task_getNumBlockedTasks(void) {
     chpl_thread_mutexLock(&threading_lock);
     chpl_thread_mutexLock(&block_report_lock);
 
-    numBlockedTasks = blocked_thread_cnt - idle_thread_cnt;
+    numBlockedTasks = blocked_thread_cnt
+                      - atomic_load_int_least32_t(&idle_thread_cnt);
 
     // end critical section
     chpl_thread_mutexUnlock(&block_report_lock);
@@ -960,10 +1104,35 @@ static void report_all_tasks(void) {
   // print out pending tasks
   printf("Pending tasks:\n");
   while (pendingTask != NULL) {
-    printf("- %s:%d\n", chpl_lookupFilename(pendingTask->bundle.filename),
-           pendingTask->bundle.lineno);
+    if (!work_stealing
+        || !atomic_load_bool(&pendingTask->claimed))
+      printf("- %s:%d\n", chpl_lookupFilename(pendingTask->bundle.filename),
+             pendingTask->bundle.lineno);
     pendingTask = pendingTask->next;
   }
+  if (work_stealing) {
+    //
+    // This is racy, but so is walking the pool above.  When we're
+    // here because of a deadlock nothing is moving anyway.
+    //
+    int32_t num_deques = atomic_load_int_least32_t(&ws_num_deques);
+    int32_t i;
+    int64_t j, top, bottom;
+    for (i = 0; i < num_deques; i++) {
+      task_deque_t* dq = ws_deques[i];
+      top = atomic_load_int_least64_t(&dq->top);
+      bottom = atomic_load_int_least64_t(&dq->bottom);
+      for (j = top; j < bottom; j++) {
+        pendingTask = (task_pool_p)
+          atomic_load_uintptr_t(&dq->buf[j & (TASK_DEQUE_SIZE - 1)]);
+        if (pendingTask != NULL
+            && !atomic_load_bool(&pendingTask->claimed))
+          printf("- %s:%d\n",
+                 chpl_lookupFilename(pendingTask->bundle.filename),
+                 pendingTask->bundle.lineno);
+      }
+    }
+  }
   printf("\n");
 
   // print out running tasks
@@ -1047,7 +1216,8 @@ static chpl_bool set_block_loc(int lineno, int32_t filename) {
   tp = get_thread_private_data();
   tp->lockRprt->filename = filename;
   tp->lockRprt->lineno = lineno;
-  tp->lockRprt->prev_progress_cnt = progress_cnt;
+  tp->lockRprt->prev_progress_cnt =
+    atomic_load_uint_least64_t(&progress_cnt);
   tp->lockRprt->maybeLocked = true;
 
   // Begin critical section
@@ -1094,7 +1264,8 @@ static void check_for_deadlock(void) {
   // internal consistency.
   assert(blockreport);
 
-  if (get_thread_private_data()->lockRprt->prev_progress_cnt < progress_cnt)
+  if (get_thread_private_data()->lockRprt->prev_progress_cnt
+      < atomic_load_uint_least64_t(&progress_cnt))
     return;
 
   fflush(stdout);
@@ -1125,9 +1296,14 @@ thread_begin(void* ptask_void) {
 
   tp->ptask = NULL;
   tp->lockRprt = NULL;
+  tp->deque = NULL;
+  tp->steal_seed = 0;
   if (blockreport)
     initializeLockReportForThread();
 
+  if (work_stealing)
+    ws_register_thread(tp);
+
   while (true) {
     //
     // wait for a task to be present in the task pool
@@ -1143,7 +1319,7 @@ thread_begin(void* ptask_void) {
     // that were waiting on the signal, but since there was a performance
     // impact from keeping it as a hybrid as opposed to merely yielding,
     // it was decided that we would return to the simple yield case.
-    while (!task_pool_head) {
+    while (!task_pool_nonempty()) {
       if (set_block_loc(0, CHPL_FILE_IDX_IDLE_TASK)) {
         // all other tasks appear to be blocked
         struct timeval deadline, now;
@@ -1151,54 +1327,72 @@ thread_begin(void* ptask_void) {
         deadline.tv_sec += 1;
         do {
           chpl_thread_yield();
-          if (!task_pool_head)
+          if (!task_pool_nonempty())
             gettimeofday(&now, NULL);
-        } while (!task_pool_head
+        } while (!task_pool_nonempty()
                  && (now.tv_sec < deadline.tv_sec
                      || (now.tv_sec == deadline.tv_sec
                          && now.tv_usec < deadline.tv_usec)));
-        if (!task_pool_head) {
+        if (!task_pool_nonempty()) {
           check_for_deadlock();
         }
       }
       else {
         do {
           chpl_thread_yield();
-        } while (!task_pool_head);
+        } while (!task_pool_nonempty());
       }
 
       unset_block_loc();
     }
  
-    //
-    // Just now the pool had at least one task in it.  Lock and see if
-    // there's something still there.
-    //
-    chpl_thread_mutexLock(&threading_lock);
-    if (!task_pool_head) {
-      chpl_thread_mutexUnlock(&threading_lock);
-      continue;
+    if (work_stealing) {
+      //
+      // Some task was unclaimed just now.  Look for it in our own
+      // deque, then the shared pool, then other threads' deques.  If
+      // somebody beat us to it, go back to waiting.
+      //
+      if ((ptask = ws_find_task(tp)) == NULL) {
+        chpl_thread_yield();
+        continue;
+      }
+
+      if (blockreport)
+        (void) atomic_fetch_add_uint_least64_t(&progress_cnt, 1);
+
+      (void) atomic_fetch_sub_int_least32_t(&idle_thread_cnt, 1);
     }
+    else {
+      //
+      // Just now the pool had at least one task in it.  Lock and see if
+      // there's something still there.
+      //
+      chpl_thread_mutexLock(&threading_lock);
+      if (!task_pool_head) {
+        chpl_thread_mutexUnlock(&threading_lock);
+        continue;
+      }
 
-    //
-    // We've found a task to run.
-    //
+      //
+      // We've found a task to run.
+      //
 
-    if (blockreport)
-      progress_cnt++;
+      if (blockreport)
+        (void) atomic_fetch_add_uint_least64_t(&progress_cnt, 1);
 
-    //
-    // start new task; remove task from pool also add to task to task-table
-    // (structure in ChapelRuntime that keeps track of currently running tasks
-    // for task-reports on deadlock or Ctrl+C).
-    //
-    ptask = task_pool_head;
-    idle_thread_cnt--;
+      //
+      // start new task; remove task from pool also add to task to
+      // task-table (structure in ChapelRuntime that keeps track of
+      // currently running tasks for task-reports on deadlock or Ctrl+C).
+      //
+      ptask = task_pool_head;
+      (void) atomic_fetch_sub_int_least32_t(&idle_thread_cnt, 1);
 
-    dequeue_task(ptask);
+      dequeue_task(ptask);
 
-    // end critical section
-    chpl_thread_mutexUnlock(&threading_lock);
+      // end critical section
+      chpl_thread_mutexUnlock(&threading_lock);
+    }
 
     tp->ptask = ptask;
 
@@ -1231,18 +1425,29 @@ thread_begin(void* ptask_void) {
     }
 
     tp->ptask = NULL;
-    chpl_mem_free(ptask, 0, 0);
 
-    // begin critical section
-    chpl_thread_mutexLock(&threading_lock);
+    if (work_stealing) {
+      ws_release_task(ptask);
 
-    //
-    // finished task; increment idle count
-    //
-    idle_thread_cnt++;
+      //
+      // finished task; increment idle count
+      //
+      (void) atomic_fetch_add_int_least32_t(&idle_thread_cnt, 1);
+    }
+    else {
+      chpl_mem_free(ptask, 0, 0);
 
-    // end critical section
-    chpl_thread_mutexUnlock(&threading_lock);
+      // begin critical section
+      chpl_thread_mutexLock(&threading_lock);
+
+      //
+      // finished task; increment idle count
+      //
+      (void) atomic_fetch_add_int_least32_t(&idle_thread_cnt, 1);
+
+      // end critical section
+      chpl_thread_mutexUnlock(&threading_lock);
+    }
   }
 }
 
@@ -1256,6 +1461,11 @@ static void thread_end(void)
 
   tp = (thread_private_data_t*) chpl_thread_getPrivateData();
   if (tp != NULL) {
+    //
+    // A work-stealing deque is deliberately left in place, since other
+    // threads may still be looking at it.  Threads only end when the
+    // program does.
+    //
     if (tp->lockRprt != NULL) {
       chpl_mem_free(tp->lockRprt, 0, 0);
       tp->lockRprt = NULL;
@@ -1274,7 +1484,7 @@ static void maybe_add_thread(void) {
 
   if (!warning_issued && chpl_thread_canCreate()) {
     if (chpl_thread_create(NULL) == 0) {
-      idle_thread_cnt++;
+      (void) atomic_fetch_add_int_least32_t(&idle_thread_cnt, 1);
     }
     else {
       int32_t max_threads = chpl_thread_getMaxThreads();
@@ -1298,8 +1508,10 @@ static void maybe_add_thread(void) {
 
 
 // create a task from the given function pointer and arguments
-// and append it to the end of the task pool
-// assumes threading_lock has already been acquired!
+// and append it to the end of the task pool, or in work-stealing
+// mode push it on this thread's deque
+// assumes threading_lock has already been acquired, unless work
+// stealing is on, in which case it must not be held!
 static inline
 task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
                              chpl_task_bundle_t* a, size_t a_size,
@@ -1329,6 +1541,8 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
   ptask->list_prev              = NULL;
   ptask->next                   = NULL;
   ptask->prev                   = NULL;
+  atomic_init_bool(&ptask->claimed, false);
+  atomic_init_int_least32_t(&ptask->refs, 0);
   ptask->chpl_data              = pv;
   ptask->bundle.is_executeOn    = is_executeOn;
   ptask->bundle.lineno          = lineno;
@@ -1338,8 +1552,51 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
   ptask->bundle.requested_fn    = fp;
   ptask->bundle.id              = get_next_task_id();
 
+  if (work_stealing) {
+    //
+    // Nothing stops another thread from starting the task as soon as
+    // it's on a deque, so do the create callbacks and the task table
+    // entry first.
+    //
+    announce_task(ptask);
+    ws_enqueue_task(ptask, p_task_list_head, is_begin_stmt, is_executeOn);
+
+    //
+    // If we now have more tasks than threads to run them on, try to
+    // start another thread.  Only take the lock when it looks like we
+    // could actually do so.
+    //
+    if (atomic_load_int_least32_t(&queued_task_cnt)
+          > atomic_load_int_least32_t(&idle_thread_cnt)
+        && chpl_thread_canCreate()) {
+      chpl_thread_mutexLock(&threading_lock);
+      if (atomic_load_int_least32_t(&queued_task_cnt)
+          > atomic_load_int_least32_t(&idle_thread_cnt))
+        maybe_add_thread();
+      chpl_thread_mutexUnlock(&threading_lock);
+    }
+
+    return ptask;
+  }
+
   enqueue_task(ptask, p_task_list_head);
 
+  announce_task(ptask);
+
+  // If we now have more tasks than threads to run them on, try to start
+  // another thread
+  if (atomic_load_int_least32_t(&queued_task_cnt)
+      > atomic_load_int_least32_t(&idle_thread_cnt)) {
+    maybe_add_thread();
+  }
+
+  return ptask;
+}
+
+
+// do the create callbacks for a new task and add it to the task table
+static inline
+void announce_task(task_pool_p ptask) {
   chpl_task_do_callbacks(chpl_task_cb_event_kind_create,
                          ptask->bundle.requested_fid,
                          ptask->bundle.filename,
@@ -1354,17 +1611,356 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
                           (uint64_t) (intptr_t) ptask);
     chpl_thread_mutexUnlock(&taskTable_lock);
   }
+}
 
-  // If we now have more tasks than threads to run them on, try to start
-  // another thread
-  if (queued_task_cnt > idle_thread_cnt) {
-    maybe_add_thread();
+
+// Work stealing
+
+//
+// Is there anything for an idle thread to do?  In work-stealing mode
+// the queued task count is maintained exactly (a task stops counting
+// when it's claimed), so we can tell without looking at the deques.
+//
+static inline
+chpl_bool task_pool_nonempty(void) {
+  if (work_stealing)
+    return atomic_load_int_least32_t(&queued_task_cnt) > 0;
+  return task_pool_head != NULL;
+}
+
+
+static void ws_init(void) {
+  int32_t max_threads = chpl_thread_getMaxThreads();
+
+  //
+  // One deque per worker thread plus one for the main task.  If the
+  // number of threads is unbounded, threads beyond what we planned for
+  // just use the shared pool; they can still steal.
+  //
+  ws_max_deques = ((max_threads > 0) ? max_threads : 256) + 1;
+  ws_deques = (task_deque_t**) chpl_mem_calloc(ws_max_deques,
+                                               sizeof(task_deque_t*),
+                                               CHPL_RT_MD_THREAD_PRV_DATA,
+                                               0, 0);
+  atomic_init_int_least32_t(&ws_num_deques, 0);
+}
+
+
+static void ws_register_thread(thread_private_data_t* tp) {
+  task_deque_t* dq;
+  int32_t i;
+
+  chpl_thread_mutexLock(&threading_lock);
+
+  i = atomic_load_int_least32_t(&ws_num_deques);
+  if (i < ws_max_deques) {
+    dq = (task_deque_t*) chpl_mem_calloc(1, sizeof(task_deque_t),
+                                         CHPL_RT_MD_THREAD_PRV_DATA,
+                                         0, 0);
+    atomic_init_int_least64_t(&dq->top, 0);
+    atomic_init_int_least64_t(&dq->bottom, 0);
+    ws_deques[i] = dq;
+    tp->deque = dq;
+    atomic_store_int_least32_t(&ws_num_deques, i + 1);
+  }
+  tp->steal_seed = 2654435761U * (uint32_t) (i + 1);
+
+  chpl_thread_mutexUnlock(&threading_lock);
+}
+
+
+//
+// Owner only: push a task on the bottom of our deque.  Returns false
+// if the deque is full.
+//
+static inline
+chpl_bool task_deque_push(task_deque_t* dq, task_pool_p ptask) {
+  int64_t b = atomic_load_explicit_int_least64_t(&dq->bottom,
+                                                 memory_order_relaxed);
+  int64_t t = atomic_load_explicit_int_least64_t(&dq->top,
+                                                 memory_order_acquire);
+  if (b - t >= TASK_DEQUE_SIZE)
+    return false;
+  atomic_store_explicit_uintptr_t(&dq->buf[b & (TASK_DEQUE_SIZE - 1)],
+                                  (uintptr_t) ptask, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  atomic_store_explicit_int_least64_t(&dq->bottom, b + 1,
+                                      memory_order_relaxed);
+  return true;
+}
+
+
+//
+// Owner only: take the most recently pushed task, if any.
+//
+static inline
+task_pool_p task_deque_take(task_deque_t* dq) {
+  int64_t b = atomic_load_explicit_int_least64_t(&dq->bottom,
+                                                 memory_order_relaxed) - 1;
+  int64_t t;
+  task_pool_p ptask = NULL;
+
+  atomic_store_explicit_int_least64_t(&dq->bottom, b, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+  t = atomic_load_explicit_int_least64_t(&dq->top, memory_order_relaxed);
+  if (t <= b) {
+    ptask = (task_pool_p)
+      atomic_load_explicit_uintptr_t(&dq->buf[b & (TASK_DEQUE_SIZE - 1)],
+                                     memory_order_relaxed);
+    if (t == b) {
+      // last one; race any thieves for it
+      if (!atomic_compare_exchange_strong_explicit_int_least64_t(
+             &dq->top, t, t + 1, memory_order_seq_cst))
+        ptask = NULL;
+      atomic_store_explicit_int_least64_t(&dq->bottom, b + 1,
+                                          memory_order_relaxed);
+    }
+  }
+  else {
+    atomic_store_explicit_int_least64_t(&dq->bottom, b + 1,
+                                        memory_order_relaxed);
   }
+  return ptask;
+}
+
+
+//
+// Any thread: steal the oldest task, if any.  Returns NULL if the
+// deque is empty or we lost a race for the task.
+//
+static inline
+task_pool_p task_deque_steal(task_deque_t* dq) {
+  int64_t t = atomic_load_explicit_int_least64_t(&dq->top,
+                                                 memory_order_acquire);
+  int64_t b;
+  task_pool_p ptask;
 
+  atomic_thread_fence(memory_order_seq_cst);
+  b = atomic_load_explicit_int_least64_t(&dq->bottom, memory_order_acquire);
+  if (t >= b)
+    return NULL;
+  ptask = (task_pool_p)
+    atomic_load_explicit_uintptr_t(&dq->buf[t & (TASK_DEQUE_SIZE - 1)],
+                                   memory_order_relaxed);
+  if (!atomic_compare_exchange_strong_explicit_int_least64_t(
+         &dq->top, t, t + 1, memory_order_seq_cst))
+    return NULL;
   return ptask;
 }
 
 
+//
+// Owner only: discard entries for already-claimed tasks from the
+// bottom of our deque, stopping at the first unclaimed one.
+//
+static void ws_drop_claimed(task_deque_t* dq) {
+  task_pool_p ptask;
+
+  while ((ptask = task_deque_take(dq)) != NULL) {
+    if (!atomic_load_bool(&ptask->claimed)) {
+      // we just took its slot, so this can't fail
+      (void) task_deque_push(dq, ptask);
+      return;
+    }
+    ws_release_task(ptask);
+  }
+}
+
+
+//
+// Owner only: our deque is full.  Discard the entries for all the
+// already-claimed tasks in it, keeping the rest in their original
+// order.  ws_drop_claimed() only gets the ones at the bottom, so this
+// gets any that were left behind under unclaimed tasks.
+//
+static void ws_compact_deque(task_deque_t* dq) {
+  task_pool_p keep[TASK_DEQUE_SIZE];
+  task_pool_p ptask;
+  int n = 0;
+
+  while ((ptask = task_deque_take(dq)) != NULL) {
+    if (atomic_load_bool(&ptask->claimed))
+      ws_release_task(ptask);
+    else
+      keep[n++] = ptask;
+  }
+
+  while (n > 0)
+    (void) task_deque_push(dq, keep[--n]);
+}
+
+
+//
+// Make a new task available.  It goes on this thread's deque if we
+// have one, and the shared pool otherwise.  Moved tasks always go to
+// the pool, since they're usually created by a thread (the comm
+// thread, say) that never takes tasks off its own deque.  Each place
+// the task is recorded (deque or pool entry, task list) holds a
+// reference to it, and whoever drops the last one frees it.
+//
+// Only the task that owns a cobegin/coforall task list adds to it, and
+// it does so before it walks the list, so those lists need no locking
+// and p_list_head stays NULL.  Any task can add to a begin list (the
+// one for a sync block, say), even after the owner is done walking it,
+// so those are doubly linked and protected by task_list_lock, and the
+// claiming thread unlinks the task.  A non-NULL p_list_head marks
+// tasks on such lists.
+//
+static void ws_enqueue_task(task_pool_p ptask,
+                            task_pool_p* p_task_list_head,
+                            chpl_bool is_begin_stmt,
+                            chpl_bool use_pool) {
+  thread_private_data_t* tp;
+
+  atomic_store_int_least32_t(&ptask->refs,
+                             (p_task_list_head == NULL) ? 1 : 2);
+
+  if (p_task_list_head != NULL) {
+    if (is_begin_stmt) {
+      chpl_thread_mutexLock(&task_list_lock);
+      ptask->p_list_head = p_task_list_head;
+      ptask->list_next = *p_task_list_head;
+      if (*p_task_list_head != NULL)
+        (*p_task_list_head)->list_prev = ptask;
+      ptask->list_prev = NULL;
+      *p_task_list_head = ptask;
+      chpl_thread_mutexUnlock(&task_list_lock);
+    }
+    else {
+      ptask->list_next = *p_task_list_head;
+      *p_task_list_head = ptask;
+    }
+  }
+
+  (void) atomic_fetch_add_int_least32_t(&queued_task_cnt, 1);
+
+  tp = (thread_private_data_t*) chpl_thread_getPrivateData();
+  if (!use_pool && tp != NULL && tp->deque != NULL) {
+    if (task_deque_push(tp->deque, ptask))
+      return;
+    // full; make room by dropping entries for claimed tasks, and retry
+    ws_compact_deque(tp->deque);
+    if (task_deque_push(tp->deque, ptask))
+      return;
+  }
+
+  chpl_thread_mutexLock(&threading_lock);
+  if (task_pool_tail)
+    task_pool_tail->next = ptask;
+  else
+    task_pool_head = ptask;
+  ptask->prev = task_pool_tail;
+  task_pool_tail = ptask;
+  chpl_thread_mutexUnlock(&threading_lock);
+}
+
+
+//
+// Find an unclaimed task and claim it: first our own deque, newest
+// first, then the shared pool, then the other deques, starting with a
+// random victim.  Entries for tasks that were already claimed (run
+// from a task list) are discarded along the way.
+//
+static task_pool_p ws_find_task(thread_private_data_t* tp) {
+  task_pool_p ptask;
+  int32_t num_deques;
+  int32_t i, start;
+
+  if (tp->deque != NULL) {
+    while ((ptask = task_deque_take(tp->deque)) != NULL) {
+      if (ws_claim_task(ptask))
+        return ptask;
+      ws_release_task(ptask);
+    }
+  }
+
+  while (task_pool_head != NULL) {
+    chpl_thread_mutexLock(&threading_lock);
+    if ((ptask = task_pool_head) != NULL) {
+      if ((task_pool_head = ptask->next) == NULL)
+        task_pool_tail = NULL;
+      else
+        task_pool_head->prev = NULL;
+    }
+    chpl_thread_mutexUnlock(&threading_lock);
+
+    if (ptask == NULL)
+      break;
+    if (ws_claim_task(ptask))
+      return ptask;
+    ws_release_task(ptask);
+  }
+
+  num_deques = atomic_load_int_least32_t(&ws_num_deques);
+  if (num_deques == 0)
+    return NULL;
+
+  tp->steal_seed ^= tp->steal_seed << 13;
+  tp->steal_seed ^= tp->steal_seed >> 17;
+  tp->steal_seed ^= tp->steal_seed << 5;
+  start = (int32_t) (tp->steal_seed % (uint32_t) num_deques);
+
+  for (i = 0; i < num_deques; i++) {
+    task_deque_t* dq = ws_deques[(start + i) % num_deques];
+    if (dq == tp->deque)
+      continue;
+    while ((ptask = task_deque_steal(dq)) != NULL) {
+      if (ws_claim_task(ptask))
+        return ptask;
+      ws_release_task(ptask);
+    }
+  }
+
+  return NULL;
+}
+
+
+//
+// Claim a task for running.  Exactly one caller wins.  For a task on
+// a begin list, the winner also unlinks it and drops the list's
+// reference (the caller still holds its own).
+//
+static inline
+chpl_bool ws_claim_task(task_pool_p ptask) {
+  if (atomic_load_explicit_bool(&ptask->claimed, memory_order_relaxed))
+    return false;
+
+  if (ptask->p_list_head == NULL) {
+    if (atomic_exchange_bool(&ptask->claimed, true))
+      return false;
+  }
+  else {
+    chpl_thread_mutexLock(&task_list_lock);
+    if (atomic_load_bool(&ptask->claimed)) {
+      chpl_thread_mutexUnlock(&task_list_lock);
+      return false;
+    }
+    atomic_store_bool(&ptask->claimed, true);
+    if (ptask == *(ptask->p_list_head))
+      *(ptask->p_list_head) = ptask->list_next;
+    else
+      ptask->list_prev->list_next = ptask->list_next;
+    if (ptask->list_next != NULL)
+      ptask->list_next->list_prev = ptask->list_prev;
+    chpl_thread_mutexUnlock(&task_list_lock);
+    ws_release_task(ptask);
+  }
+
+  (void) atomic_fetch_sub_int_least32_t(&queued_task_cnt, 1);
+  return true;
+}
+
+
+//
+// Drop a reference to a task, freeing it if that was the last one.
+//
+static inline
+void ws_release_task(task_pool_p ptask) {
+  if (atomic_fetch_sub_int_least32_t(&ptask->refs, 1) == 1)
+    chpl_mem_free(ptask, 0, 0);
+}
+
+
 // Threads
 
 uint32_t chpl_task_getNumThreads(void) {
@@ -1372,5 +1968,5 @@ uint32_t chpl_task_getNumThreads(void) {
 }
 
 uint32_t chpl_task_getNumIdleThreads(void) {
-  return idle_thread_cnt;
+  return atomic_load_int_least32_t(&idle_thread_cnt);
 }
@@ -24,6 +24,7 @@
 #include "chplrt.h"
 #include "chpl_rt_utils_static.h"
 #include "chplcgfns.h"
+#include "chpl-cache.h"
 #include "chpl-comm.h"
 #include "chplexit.h"
 #include "chpl-locale-model.h"
@@ -41,6 +42,7 @@
 #include <errno.h>
 #include <sys/time.h>
 #include <sys/mman.h>
+#include <sched.h>
 #include <unistd.h>
 #include <math.h>
 
@@ -278,9 +280,28 @@ pthread_t pthread_self(void) {
 
 #endif
 
+//
+// MassiveThreads may resume a task on a different worker after any
+// operation that can suspend it, so the remote data cache has to be
+// told about those.  A task in the middle of a cache operation must
+// stay on its worker, so in that case just let other pthreads run.
+//
+static inline void chpl_myth_yield(void) {
+  if (chpl_cache_task_try_migrate_out()) {
+    myth_yield();
+    chpl_cache_task_migrate_in();
+  } else {
+    sched_yield();
+  }
+}
+
 void chpl_sync_lock(chpl_sync_aux_t * s) {
+  int migrated;
   enter_();
+  migrated = chpl_cache_task_try_migrate_out();
   myth_felock_lock(s->felock);
+  if (migrated)
+    chpl_cache_task_migrate_in();
   return_from_();
 }
 
@@ -292,15 +313,23 @@ void chpl_sync_unlock(chpl_sync_aux_t * s) {
 
 void chpl_sync_waitFullAndLock(chpl_sync_aux_t * s,
                                int32_t lineno, int32_t filename) {
+  int migrated;
   enter_();
+  migrated = chpl_cache_task_try_migrate_out();
   myth_felock_wait_and_lock(s->felock, 1);
+  if (migrated)
+    chpl_cache_task_migrate_in();
   return_from_();
 }
 
 void chpl_sync_waitEmptyAndLock(chpl_sync_aux_t * s,
                                 int32_t lineno, int32_t filename) {
+  int migrated;
   enter_();
+  migrated = chpl_cache_task_try_migrate_out();
   myth_felock_wait_and_lock(s->felock, 0);
+  if (migrated)
+    chpl_cache_task_migrate_in();
   return_from_();
 }
 
@@ -472,6 +501,7 @@ void myth_chpl_create(chpl_bool is_executeOn,
                       chpl_task_bundle_t* arg, size_t arg_size) {
   myth_thread_t th = 0;
   myth_thread_attr_t attr[1];
+  int migrated;
   chpl_task_do_callbacks(chpl_task_cb_event_kind_create,
                          fid,
                          filename,
@@ -491,7 +521,11 @@ void myth_chpl_create(chpl_bool is_executeOn,
   myth_thread_attr_init(attr);
   attr->custom_data_size = arg_size;
   attr->custom_data = arg;
+  // The new task runs first, and the creator may be stolen meanwhile.
+  migrated = chpl_cache_task_try_migrate_out();
   myth_create_ex(&th, attr, (myth_func_t)myth_chpl_wrap, 0);
+  if (migrated)
+    chpl_cache_task_migrate_in();
 }
 
 //
@@ -620,7 +654,7 @@ char* chpl_task_idToString(char* buff, size_t size, chpl_taskID_t id) {
 //
 void chpl_task_yield(void) {
   enter_();
-  myth_yield();
+  chpl_myth_yield();
   return_from_();
 }
 
@@ -639,7 +673,7 @@ void chpl_task_sleep(double secs) {
   t = cur_time();
   end_t = t + secs;
   while (t < end_t) {
-    myth_yield();
+    chpl_myth_yield();
     t = cur_time();
   }
   return_from_();
@@ -688,7 +722,7 @@ chpl_task_bundle_t* chpl_task_getPrvBundle(void) {
 int chpl_task_supportsRemoteCache(void) {
   enter_();
   return_from_();
-  return 0;
+  return 1;
 }
 #endif
 
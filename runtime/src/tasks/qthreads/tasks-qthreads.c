@@ -37,6 +37,7 @@
 
 #include "arg.h"
 #include "error.h"
+#include "chpl-cache.h"
 #include "chplcgfns.h"
 #include "chpl-comm.h"
 #include "chplexit.h"
@@ -181,13 +182,54 @@ chpl_qthread_tls_t chpl_qthread_comm_task_tls = {
 
 static syncvar_t exit_ret = SYNCVAR_STATIC_EMPTY_INITIALIZER;
 
+//
+// Any point at which a task gives up its worker is one at which it may
+// be resumed by a different worker (and thus a different pthread), so
+// the remote data cache has to be told about it.  A task that is in the
+// middle of a cache operation must stay on its pthread, so in that case
+// just let other pthreads run.
+//
+static inline void yield_maybe_migrate(void)
+{
+    if (chpl_cache_task_try_migrate_out()) {
+        qthread_yield();
+        chpl_cache_task_migrate_in();
+    } else {
+        sched_yield();
+    }
+}
+
+static inline void syncvar_readFE_maybe_migrate(syncvar_t *sv)
+{
+    int migrated = chpl_cache_task_try_migrate_out();
+    qthread_syncvar_readFE(NULL, sv);
+    if (migrated)
+        chpl_cache_task_migrate_in();
+}
+
+//
+// Moving to another sublocale is only requested between cache
+// operations, never from inside one, so a pinned task here is a bug.
+// Staying put would leave the task silently running on the wrong
+// sublocale.
+//
+void chpl_qthread_migrate_to(qthread_shepherd_id_t shep)
+{
+    if (!chpl_cache_task_try_migrate_out()) {
+        chpl_internal_error("task cannot change sublocales during a "
+                            "remote cache operation");
+    }
+    qthread_migrate_to(shep);
+    chpl_cache_task_migrate_in();
+}
+
 void chpl_task_yield(void)
 {
     PROFILE_INCR(profile_task_yield,1);
     if (qthread_shep() == NO_SHEPHERD) {
         sched_yield();
     } else {
-        qthread_yield();
+        yield_maybe_migrate();
     }
 }
 
@@ -215,12 +257,12 @@ void chpl_sync_lock(chpl_sync_aux_t *s)
 
     while (l != s->lockers_out) {
         uncontested_lock = false;
-        qthread_yield();
+        yield_maybe_migrate();
     }
 
     if (uncontested_lock) {
         if ((++s->uncontested_locks & 0x5F) == 0) {
-            qthread_yield();
+            yield_maybe_migrate();
         }
     }
 }
@@ -252,7 +294,7 @@ void chpl_sync_waitFullAndLock(chpl_sync_aux_t *s,
     chpl_sync_lock(s);
     while (s->is_full == 0) {
         chpl_sync_unlock(s);
-        qthread_syncvar_readFE(NULL, &(s->signal_full));
+        syncvar_readFE_maybe_migrate(&(s->signal_full));
         chpl_sync_lock(s);
     }
 }
@@ -267,7 +309,7 @@ void chpl_sync_waitEmptyAndLock(chpl_sync_aux_t *s,
     chpl_sync_lock(s);
     while (s->is_full != 0) {
         chpl_sync_unlock(s);
-        qthread_syncvar_readFE(NULL, &(s->signal_empty));
+        syncvar_readFE_maybe_migrate(&(s->signal_empty));
         chpl_sync_lock(s);
     }
 }
@@ -1036,7 +1078,7 @@ void chpl_task_sleep(double secs)
         qtimer_t t = qtimer_create();
         qtimer_start(t);
         do {
-            qthread_yield();
+            yield_maybe_migrate();
             qtimer_stop(t);
         } while (qtimer_secs(t) < secs);
         qtimer_destroy(t);
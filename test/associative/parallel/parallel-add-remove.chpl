@@ -0,0 +1,47 @@
+// Concurrent adds, removes and lookups on a parSafe associative domain,
+// including duplicate adds and growth/shrinkage while tasks are active.
+config const n = 100000;
+
+var D: domain(int);
+var A: [D] int;
+
+// every index added by several tasks at once
+forall i in 1..n*4 with (ref D) do D += i % n;
+writeln("size after duplicate adds: ", D.size);
+
+forall i in D do A[i] = i;
+writeln("sum: ", (+ reduce A) == n*(n-1)/2);
+
+// remove the odd indices while looking up the even ones
+cobegin with (ref D) {
+  forall i in 1..n-1 by 2 with (ref D) do D -= i;
+  forall i in 0..n-1 by 2 do if !D.member(i) then halt("lost ", i);
+}
+writeln("size after removes: ", D.size);
+writeln("members: ", && reduce [i in 0..n-1] (D.member(i) == (i % 2 == 0)));
+writeln("values kept: ", && reduce [i in D] (A[i] == i));
+
+// shrink far enough to resize, then grow again in parallel
+forall i in 0..n-1 by 2 with (ref D) do if i >= 100 then D -= i;
+writeln("size after shrinking: ", D.size);
+forall i in 1..n with (ref D) do D += -i;
+writeln("size after regrowing: ", D.size);
+
+var E: domain(string);
+E.requestCapacity(n);
+forall i in 1..n with (ref E) do E += (i % 1000):string;
+writeln("string domain size: ", E.size);
+
+// remove and re-add string indices while other tasks look up ones
+// that stay put
+forall i in 0..#1000 with (ref E) do E += "k" + i;
+cobegin with (ref E) {
+  forall i in 0..#n with (ref E) {
+    const s = (i % 1000):string;
+    E -= s;
+    E += s;
+  }
+  forall i in 0..#n do
+    if !E.member("k" + (i % 1000)) then halt("lost k", i % 1000);
+}
+writeln("string domain size after re-adding: ", E.size);
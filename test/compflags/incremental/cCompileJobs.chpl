@@ -0,0 +1,15 @@
+// Each module is its own translation unit with --incremental; make
+// sure they still link together when compiled concurrently.
+module Helper {
+  proc square(x: int) return x*x;
+}
+
+module cCompileJobs {
+  use Helper;
+
+  proc main() {
+    var total = 0;
+    for i in 1..10 do total += square(i);
+    writeln(total);
+  }
+}
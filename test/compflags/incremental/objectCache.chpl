@@ -0,0 +1,16 @@
+// Compiled once by objectCache.precomp and again by the test itself,
+// both with the same --c-object-cache directory.  The second build
+// should take every module object from the cache (see .prediff).
+module Helper {
+  proc square(x: int) return x*x;
+}
+
+module objectCache {
+  use Helper;
+
+  proc main() {
+    var total = 0;
+    for i in 1..10 do total += square(i);
+    writeln(total);
+  }
+}
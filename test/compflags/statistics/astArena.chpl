@@ -0,0 +1,2 @@
+// See astArena.prediff
+writeln("hello");
@@ -0,0 +1,2 @@
+// See passesProfile.prediff
+writeln("hello");
@@ -0,0 +1,15 @@
+// Distributions, domains and arrays that are created and destroyed in
+// a loop should keep reusing the same privatization ids.
+
+use BlockDist;
+
+config const n = 1000;
+
+var maxPid = -1;
+for i in 1..n {
+  const D = {1..10} dmapped Block({1..10});
+  var A: [D] int;
+  maxPid = max(maxPid, D.dist._pid, D._pid, A._pid);
+}
+
+writeln(maxPid < 10);
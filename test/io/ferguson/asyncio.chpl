@@ -0,0 +1,43 @@
+// Write and read back a file using asynchronous I/O, including
+// many tasks reading disjoint regions at once.
+config const n = 100000;
+config const nTasks = 8;
+const fileName = "asyncio.bin";
+
+{
+  var f = open(fileName, iomode.cw, hints=IOHINT_ASYNC);
+  var w = f.writer(kind=iokind.native);
+  for i in 1..n do w.write(i);
+  w.close();
+  f.close();
+}
+
+var f = open(fileName, iomode.r, hints=IOHINT_ASYNC);
+writeln("size ok: ", f.length() == n * numBytes(int));
+
+const perTask = n / nTasks;
+var sums: [0..#nTasks] int;
+coforall t in 0..#nTasks {
+  const lo = t * perTask,
+        hi = if t == nTasks-1 then n else lo + perTask;
+  var r = f.reader(kind=iokind.native,
+                   start=lo*numBytes(int), end=hi*numBytes(int));
+  var x: int;
+  while r.read(x) do sums[t] += x;
+  r.close();
+}
+writeln("sum ok: ", + reduce sums == n*(n+1)/2);
+
+// reading past the end reports EOF
+var r = f.reader(kind=iokind.native, start=n*numBytes(int));
+var x: int;
+writeln("eof ok: ", !r.read(x));
+r.close();
+f.close();
+
+// The engine is io_uring where the kernel has it, and otherwise the
+// thread pool; running the requests synchronously means neither worked.
+require "qio_async.h";
+extern proc qio_async_engine_name(): c_string;
+const engine = qio_async_engine_name():string;
+writeln("engine ok: ", engine == "uring" || engine == "threads");
@@ -0,0 +1,31 @@
+// Force the thread-pool engine and check that it is the one that ran.
+config const n = 10000;
+config const nTasks = 4;
+const fileName = "asyncioThreads.bin";
+
+{
+  var f = open(fileName, iomode.cw, hints=IOHINT_ASYNC);
+  var w = f.writer(kind=iokind.native);
+  for i in 1..n do w.write(i);
+  w.close();
+  f.close();
+}
+
+var f = open(fileName, iomode.r, hints=IOHINT_ASYNC);
+const perTask = n / nTasks;
+var sums: [0..#nTasks] int;
+coforall t in 0..#nTasks {
+  const lo = t * perTask,
+        hi = if t == nTasks-1 then n else lo + perTask;
+  var r = f.reader(kind=iokind.native,
+                   start=lo*numBytes(int), end=hi*numBytes(int));
+  var x: int;
+  while r.read(x) do sums[t] += x;
+  r.close();
+}
+f.close();
+writeln("sum ok: ", + reduce sums == n*(n+1)/2);
+
+require "qio_async.h";
+extern proc qio_async_engine_name(): c_string;
+writeln("engine: ", qio_async_engine_name():string);
@@ -0,0 +1,5 @@
+// file.lines() can't be zippered with other iterators
+var f = opentmp();
+var A: [1..10] string;
+forall (a, line) in zip(A, f.lines()) do
+  a = line;
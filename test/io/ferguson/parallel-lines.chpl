@@ -0,0 +1,36 @@
+// Check that the parallel iterators for file.lines() yield every line once
+config const n = 200000;
+
+var f = opentmp();
+{
+  var w = f.writer();
+  for i in 1..n do
+    w.writeln(i);
+  // The last line has no trailing newline
+  w.write(n+1);
+  w.close();
+}
+
+var count: atomic int;
+var sum: atomic int;
+forall line in f.lines() {
+  count.add(1);
+  sum.add(line.strip():int);
+}
+writeln(count.read() == n+1);
+writeln(sum.read() == (n+1)*(n+2)/2);
+
+// lines starting in the middle of the file
+var tail: atomic int;
+const start = f.length() - 7;
+forall line in f.lines(start=start) do
+  tail.add(1);
+writeln(tail.read());
+
+// serial iteration is unchanged
+var serialCount = 0;
+for line in f.lines() do
+  serialCount += 1;
+writeln(serialCount == n+1);
+
+f.close();
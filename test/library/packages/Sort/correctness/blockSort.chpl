@@ -0,0 +1,40 @@
+/*
+ *  Check the distributed sample sort of Block arrays.
+ */
+
+use Sort, Random, BlockDist;
+
+config const n = 100000;
+
+record AbsKeyCmp {
+  proc key(a) { return abs(a); }
+}
+
+record ModCompareCmp {
+  proc compare(a, b) { return a % 1000 - b % 1000; }
+}
+
+proc test(Init: [] int, comparator, msg) {
+  const D = {1..Init.size} dmapped Block({1..max(1, Init.size)});
+  var A: [D] int = Init;
+  sort(A, comparator);
+  writeln(msg, ": ", isSorted(A, comparator), " ", + reduce A == + reduce Init);
+}
+
+var R: [1..n] int;
+fillRandom(R, 42);
+R %= 100000;
+
+test(R, defaultComparator, "random");
+test(R, reverseComparator, "reversed");
+test(R, new AbsKeyCmp(), "abs key");
+test(R, new ModCompareCmp(), "compare");
+var Equal: [1..n] int = 7,
+    Descending: [1..n] int = [i in 1..n] n - i,
+    Small: [1..10] int = [i in 1..10] 10 - i,
+    Empty: [1..0] int;
+
+test(Equal, defaultComparator, "equal");
+test(Descending, defaultComparator, "descending");
+test(Small, defaultComparator, "small");
+test(Empty, defaultComparator, "empty");
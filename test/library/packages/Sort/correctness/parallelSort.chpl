@@ -0,0 +1,67 @@
+/*
+ *  Check the parallel engines behind sort() on arrays large enough to
+ *  use them.
+ */
+
+use Sort, Random;
+
+config const n = 100000;
+
+record AbsKeyCmp {
+  proc key(a) { return abs(a); }
+}
+
+record ModCompareCmp {
+  proc compare(a, b) { return a % 1000 - b % 1000; }
+}
+
+// The sum checks that A still holds the same elements
+proc check(msg, A, comparator, sum) {
+  const newSum = + reduce A;
+  const sameSum = if isRealType(A.eltType) then abs(newSum - sum) < 1e-6
+                  else newSum == sum;
+  writeln(msg, ": ", isSorted(A, comparator), " ", sameSum);
+}
+
+proc test(type t, comparator, msg) {
+  var A: [1..n] t;
+  fillRandom(A, 42);
+  if isIntegralType(t) && numBits(t) >= 32 then A = A % (100000: t);
+  const sum = + reduce A;
+  sort(A, comparator);
+  check(msg, A, comparator, sum);
+}
+
+test(int, defaultComparator, "int");
+test(int(32), defaultComparator, "int(32)");
+test(uint, defaultComparator, "uint");
+test(uint(8), defaultComparator, "uint(8)");
+test(real, defaultComparator, "real");
+test(int, reverseComparator, "int reversed");
+test(int, new AbsKeyCmp(), "int by abs key");
+test(int, new ModCompareCmp(), "int by compare");
+test(real, new ReverseComparator(new AbsKeyCmp()), "real by reversed abs key");
+
+{
+  var A: [0..#n] real;
+  fillRandom(A, 7);
+  A -= 0.5;
+  A[0] = -0.0;
+  A[1] = 0.0;
+  const sum = + reduce A;
+  sort(A);
+  check("negative reals", A, defaultComparator, sum);
+}
+
+{
+  var A: [0..#n] int = 5;
+  sort(A);
+  check("equal ints", A, defaultComparator, 5 * n);
+}
+
+{
+  var A: [1..n] string;
+  for (a, i) in zip(A, 1..) do a = ((i * 7919) % n): string;
+  sort(A);
+  writeln("strings: ", isSorted(A));
+}
@@ -0,0 +1,38 @@
+use BlockDist, UnorderedAtomics;
+
+config const n = 1000,
+             m = 10 * n;
+
+const D = {0..#n} dmapped Block({0..#n});
+
+var hist: [D] atomic int;
+var bits: [D] atomic uint;
+var total: atomic real;
+
+forall i in 0..#m {
+  unorderedAtomicAdd(hist[(i * 7) % n], 2);
+  unorderedAtomicSub(hist[(i * 7) % n], 1);
+  unorderedAtomicOr(bits[i % n], 1:uint << (i / n):uint);
+  unorderedAtomicAdd(total, 0.5);
+}
+
+writeln(&& reduce [h in hist] h.read() == m / n);
+writeln(&& reduce [b in bits] b.read() == (1:uint << (m / n):uint) - 1);
+writeln(total.read() == m / 2.0);
+
+coforall loc in Locales do on loc {
+  unorderedAtomicXor(bits[0], 1:uint);
+  unorderedAtomicAnd(bits[1], ~0:uint);
+  unorderedAtomicTaskFence();
+}
+
+writeln(bits[0].read() == (1:uint << (m / n):uint) - 1 - (numLocales % 2):uint);
+writeln(bits[1].read() == (1:uint << (m / n):uint) - 1);
+
+// an on statement finishes the unordered operations done in its body
+coforall loc in Locales do on loc do
+  for i in 0..#n do unorderedAtomicAdd(hist[i], 1);
+writeln(&& reduce [h in hist] h.read() == m / n + numLocales);
+
+on Locales[numLocales-1] do unorderedAtomicSub(hist[0], numLocales);
+writeln(hist[0].read() == m / n);
@@ -0,0 +1,50 @@
+use BlockDist, Aggregation;
+
+config const n = 10000;
+
+const D = {0..#n} dmapped Block({0..#n});
+
+// Scatter with a small buffer, so that buffers fill up and are sent
+// during the loop as well as when each task's aggregator is destroyed
+var A: [D] int;
+var dst = new DstAggregator(int);
+forall i in D with (in dst) do
+  dst.copy(A[(i * 7919) % n], i);
+writeln(&& reduce [i in D] A[(i * 7919) % n] == i);
+
+// Gather the values back into a local array
+var B: [0..#n] int;
+var src = new SrcAggregator(int);
+forall i in 0..#n with (in src) do
+  src.copy(B[i], A[(i * 7919) % n]);
+writeln(&& reduce [i in 0..#n] B[i] == i);
+
+// Tuples are aggregated too and strings are written right away
+var T: [D] (int, real);
+var S: [D] string;
+var tdst = new DstAggregator((int, real));
+var sdst = new DstAggregator(string);
+forall i in D with (in tdst, in sdst) {
+  tdst.copy(T[n-1-i], (i, i / 2.0));
+  sdst.copy(S[n-1-i], i:string);
+}
+writeln(&& reduce [i in D] (T[n-1-i] == (i, i / 2.0) && S[n-1-i] == i:string));
+
+// Histogram of atomic adds
+var hist: [D] atomic int;
+var adds = new AtomicAddAggregator(int);
+forall i in 0..#10*n with (in adds) do
+  adds.add(hist[(i * 7) % n], 1);
+writeln(&& reduce [h in hist] h.read() == 10);
+
+// An explicit flush makes the buffered writes visible
+coforall loc in Locales do on loc {
+  var agg = new DstAggregator(int);
+  for i in D do
+    if i % numLocales == here.id then agg.copy(A[i], -i);
+  agg.flush();
+  for i in D do
+    if i % numLocales == here.id && A[i] != -i then
+      writeln("missing write of ", i);
+}
+writeln(&& reduce [i in D] A[i] == -i);
@@ -0,0 +1,43 @@
+use BlockDist, Aggregation;
+
+config const n = 1000;
+
+const D = {0..#n} dmapped Block({0..#n});
+
+// Assigning an aggregator flushes it and does not share its buffers
+// with the one it is assigned from, so each buffered write is done
+// exactly once and each buffer is freed once.
+var A: [D] int;
+var dst1 = new DstAggregator(int),
+    dst2 = new DstAggregator(int);
+for i in D do dst1.copy(A[i], i);
+for i in D do dst2.copy(A[i], i + n);
+dst1 = dst2;
+// Only the writes to remote elements were buffered
+writeln(&& reduce [i in D] (if A[i].locale.id == 0 then A[i] == i + n
+                                             else A[i] == i));
+dst1.flush();
+dst2.flush();
+writeln(&& reduce [i in D] A[i] == i + n);
+
+var B: [0..#n] int;
+var src1 = new SrcAggregator(int),
+    src2 = new SrcAggregator(int);
+for i in 0..#n do src1.copy(B[i], A[i]);
+src2 = src1;
+src1.flush();
+writeln(&& reduce [i in 0..#n] B[i] == i + n);
+
+var hist: [D] atomic int;
+var adds1 = new AtomicAddAggregator(int),
+    adds2 = new AtomicAddAggregator(int);
+for i in D do adds1.add(hist[i], 1);
+for i in D do adds2.add(hist[i], 2);
+adds2 = adds1;
+adds1.flush();
+writeln(&& reduce [h in hist] h.read() == 3);
+
+// The target can still be used after the assignment
+for i in D do adds2.add(hist[i], 1);
+adds2.flush();
+writeln(&& reduce [h in hist] h.read() == 4);
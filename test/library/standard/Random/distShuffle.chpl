@@ -0,0 +1,34 @@
+use Random, BlockDist, CyclicDist, CommDiagnostics;
+
+config const n = 100000;
+config const seed = 29;
+
+// A shuffle of a distributed array should match the local one, and it
+// should do its work on the locales that own the data rather than
+// doing a remote operation per element.
+const D = {1..n};
+const BD = D dmapped Block(D);
+const CD = D dmapped Cyclic(startIdx=1);
+
+var A: [D] int = D;
+shuffle(A, seed=seed);
+
+var B: [BD] int = D;
+startCommDiagnostics();
+shuffle(B, seed=seed);
+stopCommDiagnostics();
+writeln(A.equals(B));
+
+var ops: uint;
+for c in getCommDiagnostics() do
+  ops += c.get + c.get_nb + c.put + c.put_nb
+         + c.execute_on + c.execute_on_fast + c.execute_on_nb;
+writeln("remote operations per element < 1/4: ", ops * 4 < n:uint);
+
+var C: [CD] int = D;
+shuffle(C, seed=seed);
+writeln(A.equals(C));
+
+var P: [CD] int;
+permutation(P, seed=seed);
+writeln(P.equals(A));
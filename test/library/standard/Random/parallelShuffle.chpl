@@ -0,0 +1,41 @@
+use Random, BlockDist;
+
+config const n = 100000;
+config const seed = 17;
+
+// The shuffle should not depend on how the array is distributed
+// or on the number of tasks that work on it.
+const D = {1..n};
+const BD = D dmapped Block(D);
+
+var A: [D] int = D;
+var B: [BD] int = D;
+
+shuffle(A, seed=seed);
+shuffle(B, seed=seed);
+
+var serialA: [D] int = D;
+serial {
+  shuffle(serialA, seed=seed);
+}
+
+writeln(A.equals(B));
+writeln(A.equals(serialA));
+const identity: [D] int = D;
+writeln(A.equals(identity));
+
+// Every value is still there exactly once
+var seen: [D] atomic int;
+forall a in A do
+  seen[a].add(1);
+writeln(&& reduce [s in seen] s.read() == 1);
+
+// permutation() fills with a shuffle of the indices
+var P: [BD] int;
+permutation(P, seed=seed);
+writeln(P.equals(A));
+
+// A strided domain gets the same order as a dense one
+var S: [1..2*n by 2] int = D;
+shuffle(S, seed=seed);
+writeln(&& reduce (S == A));
@@ -0,0 +1,13 @@
+use Memory;
+
+class Sampled { var x: int; }
+
+var keep: [1..10] Sampled;
+for i in 1..100 {
+  var c = new Sampled(i);
+  if i <= 10 then keep[i] = c; else delete c;
+}
+
+printMemSampleProfile();
+
+for c in keep do delete c;
@@ -0,0 +1,27 @@
+//
+// Allocate and free from many tasks at once.  The statistics are kept
+// per shard of the memory table, so check that they add up.
+//
+use Memory;
+
+extern proc chpl_mem_allocMany(number, size, description, lineno=-1, filename=0): c_void_ptr;
+extern proc chpl_mem_free(ptr, lineno=-1, filename=0);
+
+config const numTasks = 8,
+             numIters = 10000,
+             size = 64;
+
+const before = memoryUsed();
+
+coforall t in 1..numTasks {
+  var prev: c_void_ptr;
+  for i in 1..numIters {
+    const p = chpl_mem_allocMany(1, size, 0);
+    // Free every other allocation, so half of them are leaked.
+    if i % 2 == 0 then chpl_mem_free(prev);
+    prev = p;
+  }
+}
+
+writeln("memory used: ", memoryUsed() - before);
+writeln("expected:    ", numTasks * numIters / 2 * size);
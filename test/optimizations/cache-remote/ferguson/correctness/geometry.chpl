@@ -0,0 +1,31 @@
+// Run sequential, strided and write-behind access patterns with a cache
+// geometry other than the default (see geometry.execenv).
+config const n = 20000;
+
+proc doit(memory:locale, running:locale) {
+  on memory {
+    var A:[1..n] int;
+    for i in 1..n {
+      A[i] = i;
+    }
+    on running {
+      for i in 1..n {
+        assert(A[i] == i);
+      }
+      for i in 1..n by -1 {
+        assert(A[i] == i);
+      }
+      for i in 1..n by 33 {
+        assert(A[i] == i);
+      }
+      for i in 1..n {
+        A[i] = 2*i;
+      }
+    }
+    for i in 1..n {
+      assert(A[i] == 2*i);
+    }
+  }
+}
+
+doit(Locales[0], Locales[1]);
@@ -0,0 +1,39 @@
+// Tasks that yield may be resumed on a different thread (and so use a
+// different cache) with work-stealing tasking layers.  Check that puts
+// made before a yield are visible after it, and that values cached
+// before a yield are not stale after it.
+extern proc chpl_task_yield();
+config const verbose=false;
+config const ntasks=4*here.maxTaskPar;
+config const nyields=100;
+
+proc doit(a:locale, b:locale)
+{
+  extern proc printf(fmt: c_string, vals...?numvals): int;
+
+  on a {
+    if verbose then printf("on %d\n", here.id:c_int);
+    var A:[1..ntasks] int;
+    on b {
+      coforall i in 1..ntasks {
+        for j in 1..nyields {
+          A[i] = j;
+          chpl_task_yield();
+          assert( A[i] == j );
+          chpl_task_yield();
+        }
+      }
+      for i in 1..ntasks {
+        assert( A[i] == nyields );
+      }
+    }
+
+    for i in 1..ntasks {
+      assert( A[i] == nyields );
+    }
+  }
+}
+
+doit(Locales[1], Locales[0]);
+doit(Locales[0], Locales[1]);
+doit(Locales[2], Locales[1]);
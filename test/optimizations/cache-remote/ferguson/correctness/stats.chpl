@@ -0,0 +1,40 @@
+use CommDiagnostics;
+
+config const n = 100000;
+
+var A:[1..n] int;
+for i in 1..n do A[i] = i;
+
+on Locales[1] {
+  resetCacheDiagnostics();
+
+  // Sequential reads should mostly hit in the cache.
+  var sum = 0;
+  for i in 1..n do sum += A[i];
+  assert(sum == n*(n+1)/2);
+
+  // Writes should be coalesced into fewer PUTs.
+  for i in 1..n do A[i] = 2*i;
+}
+
+for i in 1..n do assert(A[i] == 2*i);
+
+const D = getCacheDiagnostics();
+const cd = D[1];
+assert(cd.get_hits > 0);
+assert(cd.get_misses + cd.get_partial_hits < n / 4);
+assert(cd.readahead_issued > 0);
+assert(cd.readahead_used > 0);
+assert(cd.puts == n);
+assert(cd.flush_puts > 0 && cd.flush_puts < n / 4);
+assert(cd.flush_put_bytes == n * numBytes(int));
+
+// Locale 0 did not use its cache.
+assert(D[0].get_hits == 0 && D[0].puts == 0);
+
+// A reset clears the statistics.
+on Locales[1] {
+  resetCacheDiagnosticsHere();
+  const cd = getCacheDiagnosticsHere();
+  assert(cd.get_hits == 0 && cd.puts == 0 && cd.flush_puts == 0);
+}
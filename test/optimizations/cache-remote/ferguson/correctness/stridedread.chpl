@@ -0,0 +1,37 @@
+config const n = 100000;
+config const stride = 97;
+extern proc chpl_cache_print();
+extern proc printf(fmt: c_string, vals...?numvals): int;
+config const verbose=false;
+
+proc doit(memory:locale, running:locale) {
+  on memory {
+    var A:[1..n] int;
+    for i in 1..n {
+      A[i] = i;
+    }
+    on running {
+      // forward and reverse strided streams larger than a cache page
+      for i in 1..n by stride {
+        var got = A[i];
+        if verbose then printf("on %d, reading a[%d] got %d\n",
+                               here.id:c_int, i:c_int, got:c_int);
+        assert(got == i);
+      }
+      for i in 1..n by -stride {
+        var got = A[i];
+        if verbose then printf("on %d, reading a[%d] got %d\n",
+                               here.id:c_int, i:c_int, got:c_int);
+        assert(got == i);
+      }
+      // and two interleaved streams
+      for i in 1..n/2 by stride {
+        assert(A[i] == i);
+        assert(A[n/2+i] == n/2+i);
+      }
+    }
+  }
+}
+
+doit(Locales[0], Locales[1]);
+doit(Locales[1], Locales[0]);
@@ -0,0 +1,24 @@
+// More cobegin/coforall tasks than fit in a deque, all run inline by
+// the task that created them, since there is only one thread.  The
+// deque entries for those tasks should be dropped as we go rather than
+// keeping the tasks' descriptors alive.
+
+use Memory;
+
+config const n = 5000;
+
+var total: atomic int;
+const before = memoryUsed();
+
+for i in 1..n {
+  coforall j in 1..3 do
+    total.add(j);
+  cobegin {
+    total.add(1);
+    total.add(2);
+  }
+}
+
+const growth = memoryUsed() - before;
+writeln("total = ", total.read());
+writeln("memory grew by less than a task per iteration: ", growth < n);
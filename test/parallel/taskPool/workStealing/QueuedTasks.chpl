@@ -0,0 +1,8 @@
+var b1, b2, b3: single bool;
+
+begin b2 = b1;
+
+begin b3 = b1;
+
+writeln(here.queuedTasks(), " tasks are queued up at the moment.");
+b1 = true;
@@ -0,0 +1,33 @@
+// Lots of fine-grained nested tasks, from begins inside sync blocks
+// and from cobegins, so that tasks are pushed and stolen from many
+// deques at once.
+
+config const n = 20;
+
+proc fib(n: int): int {
+  if n < 2 then return n;
+  var a, b: int;
+  if n < 10 {
+    a = fib(n-1);
+    b = fib(n-2);
+  } else if n % 2 == 0 {
+    sync {
+      begin with (ref a) a = fib(n-1);
+      b = fib(n-2);
+    }
+  } else {
+    cobegin with (ref a, ref b) {
+      a = fib(n-1);
+      b = fib(n-2);
+    }
+  }
+  return a + b;
+}
+
+writeln("fib(", n, ") = ", fib(n));
+
+var total: atomic int;
+coforall i in 1..100 do
+  coforall j in 1..10 do
+    total.add(i*j);
+writeln("total = ", total.read());
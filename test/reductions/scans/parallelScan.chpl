@@ -0,0 +1,71 @@
+// Scans of 1D DefaultRectangular and Block arrays run in parallel.
+// Check them against serial scans of the same values.
+use BlockDist;
+
+config const n = 100000;
+
+const D = {1..n};
+const BD = D dmapped Block(D);
+
+var A: [D] int = [i in D] (i * 7919) % 101 - 50;
+var BA: [BD] int = A;
+
+proc check(type t, X, Y) {
+  var ok = true;
+  for (x, y) in zip(X, Y) do
+    if x != y then ok = false;
+  writeln(t:string, ": ", ok);
+}
+
+proc serialScan(A, op) {
+  var R: [1..n] op.generate().type;
+  var i = 1;
+  for a in A {
+    op.accumulate(a);
+    R[i] = op.generate();
+    i += 1;
+  }
+  delete op;
+  return R;
+}
+
+check(int, + scan A, serialScan(A, new SumReduceScanOp(eltType=int)));
+check(int, + scan BA, serialScan(A, new SumReduceScanOp(eltType=int)));
+check(int, max scan BA, serialScan(A, new MaxReduceScanOp(eltType=int)));
+check(int, min scan A, serialScan(A, new MinReduceScanOp(eltType=int)));
+check(int, ^ scan BA, serialScan(A, new BitwiseXorReduceScanOp(eltType=int)));
+
+var L: [D] (int, int) = [i in D] (A[i], i);
+var BL: [BD] (int, int) = L;
+check((int, int), maxloc scan L,
+      serialScan(L, new maxloc(eltType=(int, int))));
+check((int, int), minloc scan BL,
+      serialScan(L, new minloc(eltType=(int, int))));
+
+// A user-defined op whose state differs from its elements: it counts
+// them.  Every op the scan makes must also be deleted.
+var liveCountOps: atomic int;
+
+class CountOp: ReduceScanOp {
+  type eltType;
+  var count: int;
+
+  proc CountOp(type eltType) { liveCountOps.add(1); }
+  proc deinit() { liveCountOps.sub(1); }
+
+  proc accumulate(x) { count += 1; }
+  proc accumulateOntoState(ref state, x) { state += 1; }
+  proc combine(x) { count += x.count; }
+  proc generate() return count;
+  proc clone() return new CountOp(eltType=eltType);
+}
+
+check(int, CountOp scan A, [i in D] i);
+check(int, CountOp scan BA, [i in D] i);
+writeln("count ops deleted: ", liveCountOps.read() == 0);
+
+// a domain that doesn't start at 1, and one that's empty
+var S: [-3..3] int = 1;
+writeln(+ scan S);
+var E: [1..0] int;
+writeln((+ scan E).size);
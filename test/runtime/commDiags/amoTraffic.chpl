@@ -0,0 +1,22 @@
+use BlockDist, CommDiagnostics, UnorderedAtomics;
+
+config const n = 100;
+
+const last = numLocales-1;
+
+const D = {0..#numLocales} dmapped Block({0..#numLocales});
+var X: [D] atomic int;
+ref x = X[last];
+
+resetCommDiagnostics();
+startCommDiagnostics();
+for i in 1..n do x.add(1);
+for i in 1..n do unorderedAtomicAdd(x, 1);
+unorderedAtomicTaskFence();
+stopCommDiagnostics();
+
+writeln("x: ", x.read());
+
+const A = getCommTraffic(commOp.amo);
+writeln("amos from 0 to last locale: ", A[0, last].ops == 2 * n,
+        " ", A[0, last].bytes == 2 * n * numBytes(int));
@@ -0,0 +1,29 @@
+use CommDiagnostics;
+
+var x: int = 42;
+
+resetCommDiagnostics();
+startCommDiagnostics();
+on Locales[numLocales-1] {
+  const y = x;
+  x = y + 1;
+}
+stopCommDiagnostics();
+
+const last = numLocales-1;
+const G = getCommTraffic(commOp.get),
+      P = getCommTraffic(commOp.put);
+writeln("get from last locale to 0: ", G[last, 0].ops > 0,
+        " ", G[last, 0].bytes >= numBytes(int));
+writeln("put from last locale to 0: ", P[last, 0].ops > 0,
+        " ", P[last, 0].bytes >= numBytes(int));
+writeln("gets recorded on locale 0: ", + reduce G[0, ..].ops);
+
+// The ofi comm layer does not record latencies.
+const L = getCommLatency(commOp.get);
+writeln("get latencies match ops: ",
+        if CHPL_COMM == "ofi" then + reduce L == 0
+                              else + reduce L == + reduce G.ops);
+
+resetCommDiagnostics();
+writeln("after reset: ", + reduce getCommTraffic(commOp.get).ops);
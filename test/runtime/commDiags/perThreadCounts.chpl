@@ -0,0 +1,41 @@
+//
+// Operations done by many tasks at once are counted in per-thread
+// counters that are summed when they are retrieved.  Check that none
+// are lost, and that resetting while other tasks count does not
+// disturb the counts taken after it.
+//
+use CommDiagnostics;
+
+config const numTasks = 8,
+             numIters = 1000;
+
+var x: int;
+var xs: [0..#numTasks] int;
+
+on Locales[numLocales-1] {
+  proc run() {
+    coforall t in 0..#numTasks {
+      for i in 1..numIters {
+        const v = x;
+        xs[t] = v + i;
+      }
+    }
+  }
+
+  startCommDiagnosticsHere();
+  run();
+  const d1 = getCommDiagnosticsHere();
+  writeln("gets: ", d1.get >= numTasks * numIters);
+  writeln("puts: ", d1.put == numTasks * numIters);
+
+  resetCommDiagnosticsHere();
+  run();
+  stopCommDiagnosticsHere();
+  const d2 = getCommDiagnosticsHere();
+  writeln("gets after reset: ", d2.get == d1.get);
+  writeln("puts after reset: ", d2.put == d1.put);
+
+  resetCommDiagnosticsHere();
+  const d3 = getCommDiagnosticsHere();
+  writeln("after reset: ", d3.get + d3.put);
+}
@@ -0,0 +1,24 @@
+// A private broadcast must finish even when every worker thread on the
+// other locales is busy spinning, so the interior nodes of the broadcast
+// tree cannot rely on a worker task to forward it.
+config const spinners = 4;
+
+var stop: atomic bool;
+var started: atomic int;
+
+cobegin {
+  {
+    while started.read() < numLocales-1 { }
+    // starting and stopping comm diagnostics both broadcast to all locales
+    startCommDiagnostics();
+    stopCommDiagnostics();
+    stop.write(true);
+  }
+  coforall loc in Locales[1..] do on loc {
+    coforall 1..spinners {
+      started.add(1);
+      while !stop.read() { }
+    }
+  }
+}
+writeln("done");
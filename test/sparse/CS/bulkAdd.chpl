@@ -0,0 +1,84 @@
+use LayoutCS;
+
+/*
+  Bulk additions to CSR and CSC domains, checked against a default sparse
+  domain built from the same indices.  The batches have duplicates, hit
+  indices that are already in the domain and include a sorted batch.
+ */
+
+config const n = 200,
+             m = 150,
+             numInds = 5000;
+
+const D = {1..n, 1..m};
+
+proc randomInds(seed: int, count: int) {
+  var inds: [1..count] 2*int;
+  var x = seed;
+  for ind in inds {
+    x = (x * 1103515245 + 12345) % 2147483648;
+    const r = 1 + x % n;
+    x = (x * 1103515245 + 12345) % 2147483648;
+    const c = 1 + x % m;
+    ind = (r, c);
+  }
+  return inds;
+}
+
+proc check(param compressRows: bool) {
+  var csDom: sparse subdomain(D) dmapped CS(compressRows=compressRows);
+  var refDom: sparse subdomain(D);
+  var csArr: [csDom] int;
+
+  var ok = true;
+  var batch = 0;
+
+  proc addBatch(inds, dataSorted=false, isUnique=false) {
+    const added = csDom.bulkAdd(inds, dataSorted, isUnique);
+    const before = refDom.size;
+    refDom.bulkAdd(inds, dataSorted=false, isUnique=false);
+    batch += 1;
+
+    if added != refDom.size - before || csDom.size != refDom.size then
+      ok = false;
+    for i in refDom do
+      if !csDom.member(i) then ok = false;
+
+    // the elements that were there keep their values, new ones are 0
+    for i in csDom {
+      if csArr[i] != 0 && csArr[i] > batch * 1000000 then ok = false;
+      if csArr[i] == 0 then csArr[i] = batch * 1000000 + i(1) * 1000 + i(2);
+      else if csArr[i] % 1000000 != i(1) * 1000 + i(2) then ok = false;
+    }
+  }
+
+  addBatch(randomInds(1, numInds));
+  addBatch(randomInds(2, numInds));
+  addBatch(randomInds(1, numInds / 2));
+
+  // a batch that is unique and sorted by row (column)
+  if compressRows {
+    var sortedInds: [1..n] 2*int = [i in 1..n] (i, 1 + (i * 7) % m);
+    addBatch(sortedInds, dataSorted=true, isUnique=true);
+  } else {
+    var sortedInds: [1..m] 2*int = [i in 1..m] (1 + (i * 7) % n, i);
+    addBatch(sortedInds, dataSorted=true, isUnique=true);
+  }
+
+  // nothing new
+  addBatch(randomInds(2, numInds));
+
+  // the indices are iterated in order within each row (column)
+  var prev = (0, 0);
+  for i in csDom {
+    const key = if compressRows then i else (i(2), i(1));
+    if key(1) < prev(1) || (key(1) == prev(1) && key(2) <= prev(2)) then
+      ok = false;
+    prev = key;
+  }
+
+  writeln(if compressRows then "CSR " else "CSC ", ok, " ", csDom.size);
+}
+
+check(true);
+check(false);
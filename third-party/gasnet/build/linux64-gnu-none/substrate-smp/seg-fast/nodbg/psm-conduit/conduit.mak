@@ -0,0 +1,35 @@
+# Copyright (c) 2014-2015 Intel Corporation. All rights reserved.
+#INSTRUCTIONS# Conduit-specific Makefile fragment settings
+#INSTRUCTIONS#
+#INSTRUCTIONS# The contents of this file are embedded into the
+#INSTRUCTIONS# *-(seq,par,parsync).mak Makefile fragments at conduit build time
+#INSTRUCTIONS# The settings in those fragments are used to build GASNet clients
+#INSTRUCTIONS# (including the GASNet tests).
+#INSTRUCTIONS# See the conduit-writer instructions in the generated fragments
+#INSTRUCTIONS# or $(top_srcdir)/other/fragment-head.mak.in for usage info.
+
+# When psm-conduit uses an MPI-based bootstrapper, we must
+# link using the system MPI compiler
+#GASNET_LD_OVERRIDE = 
+#GASNET_LDFLAGS_OVERRIDE =  
+#MPI_COMPAT_LIBS = 
+
+# Linker feature requirements embedded in GASNET_LD(FLAGS) which are not satisfied solely by GASNET_LIBS 
+# (eg possible dependence on implicit MPI or C++ libraries added by a linker wrapper in GASNET_LD):
+#GASNET_LD_REQUIRES_MPI = 1
+
+# Some platforms need extra -libs for the socket calls in ssh-spawner:
+SSH_LIBS = 
+CONDUIT_LDFLAGS =  
+CONDUIT_LIBS = -lpsm2 $(MPI_COMPAT_LIBS) $(SSH_LIBS) 
+CONDUIT_LIBS_SEQ = -lpthread
+CONDUIT_DEFINES_SEQ = -D_REENTRANT
+
+# Clients may want/need to know which spawners we support:
+GASNET_SPAWNER_DEFAULT = ssh
+#GASNET_SPAWNER_PMI = 1
+GASNET_SPAWNER_PMI = 0 
+#GASNET_SPAWNER_MPI = 1
+GASNET_SPAWNER_MPI = 0 
+GASNET_SPAWNER_SSH = 1
+#GASNET_SPAWNER_SSH = 0 
@@ -0,0 +1,14 @@
+#!/bin/sh
+#-*-sh-*-
+
+#
+# Copyright © 2012-2013 Inria.  All rights reserved.
+# See COPYING in top-level directory.
+#
+
+HWLOC_top_builddir="/root/repo/third-party/hwloc/build/linux64-gnu-none-flat"
+
+HWLOC_PLUGINS_PATH=${HWLOC_top_builddir}/src
+export HWLOC_PLUGINS_PATH
+
+"$@"
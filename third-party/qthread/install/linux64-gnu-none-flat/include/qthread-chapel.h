@@ -0,0 +1 @@
+#define CHPL_QTHREAD_SCHEDULER_ONE_WORKER_PER_SHEPHERD 0
@@ -0,0 +1,11 @@
+#ifndef QTHREAD_CACHELINE_H
+#define QTHREAD_CACHELINE_H
+
+#include <qthread/macros.h>
+
+Q_STARTCXX                             /* */
+int qthread_cacheline(void);
+Q_ENDCXX                             /* */
+
+#endif // ifndef QTHREAD_CACHELINE_H
+/* vim:set expandtab: */
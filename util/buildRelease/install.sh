@@ -268,6 +268,10 @@ myinstalldir  util/chplenv            "$DEST_CHPL_HOME"/util/chplenv/
 # (needed for LLVM builds)
 myinstallfile util/config/compileline "$DEST_CHPL_HOME"/util/config/
 
+# copy util/config/cached-compile
+# (used by the generated Makefile for --c-object-cache)
+myinstallfile util/config/cached-compile "$DEST_CHPL_HOME"/util/config/
+
 
 if [ ! -z "$DEST_DIR" ]
 then
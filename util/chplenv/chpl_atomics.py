@@ -15,11 +15,15 @@ from utils import error, memoize
 def get(flag='target'):
     if flag == 'network':
         atomics_val = overrides.get('CHPL_NETWORK_ATOMICS')
+        comm_val = chpl_comm.get()
         if not atomics_val:
-            if chpl_comm.get() == 'ugni' and get('target') != 'locks':
+            if comm_val == 'ugni' and get('target') != 'locks':
                 atomics_val = 'ugni'
             else:
                 atomics_val = 'none'
+        elif atomics_val != 'none' and atomics_val != comm_val:
+            error("CHPL_NETWORK_ATOMICS={0} requires "
+                  "CHPL_COMM={0}".format(atomics_val), ValueError)
     elif flag == 'target':
         atomics_val = overrides.get('CHPL_ATOMICS')
         if not atomics_val: